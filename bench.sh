@@ -0,0 +1,169 @@
+#!/bin/bash
+
+# /*
+#  * bench.sh
+#  *
+#  * USAGE: ./bench.sh [-n RUNS] [--update]
+#  *
+#  * 1) builds the compiler and ./gen_program
+#  * 2) generates one large program per configuration below into bench/out/
+#  * 3) compiles each RUNS times (default 5) with --stats, keeping each
+#  *    phase's fastest time
+#  * 4) compares every phase against bench/baseline.txt and exits 1 on a
+#  *    regression, or with --update writes the results as the new baseline
+#  *
+#  * Only counts that are the same on every run and every machine can fail
+#  * the check: a phase regresses when it allocates more arena bytes, or when
+#  * the emitted code has more instructions or .ys bytes. A phase more than
+#  * TIME_SLACK slower (and at least MIN_MS ms) or a peak RSS more than
+#  * RSS_SLACK higher is reported but doesn't fail, since times and RSS
+#  * depend on the host and its load. Other object counts (quads, temps, ...)
+#  * that change are reported as well.
+#  */
+
+RUNS=5
+UPDATE=0
+BASELINE=bench/baseline.txt
+OUT_DIR=bench/out
+TIME_SLACK=1.25
+MIN_MS=2
+RSS_SLACK=1.10
+
+# name and gen_program options of every benchmark
+CONFIGS=(
+	"functions	-f 200 -d 1 -s 3"
+	"nesting	-f 4 -d 8 -s 2"
+	"expressions	-f 10 -d 1 -e 200"
+	"arrays	-f 20 -a 4096"
+	"globals	-f 10 -g 5000"
+	"mixed	-f 60 -d 3 -s 3 -g 1000"
+)
+
+while [ $# -gt 0 ]
+do
+	case "$1" in
+		-n) RUNS=$2; shift ;;
+		--update) UPDATE=1 ;;
+		*) echo "usage: $0 [-n RUNS] [--update]"; exit 2 ;;
+	esac
+	shift
+done
+
+make gen_target_code gen_program > /dev/null
+
+if [ "$?" -ne 0 ]
+then
+	echo "Errors during make. Fix errors to continue."
+	exit 1
+fi
+
+mkdir -p $OUT_DIR
+RESULTS=$OUT_DIR/results.txt
+> $RESULTS
+
+for config in "${CONFIGS[@]}"
+do
+	NAME=${config%%	*}
+	OPTIONS=${config#*	}
+
+	./gen_program $OPTIONS > $OUT_DIR/$NAME.c
+
+	for ((run = 0; run < RUNS; run++))
+	do
+		./gen_target_code --stats $OUT_DIR/$NAME.c $OUT_DIR/$NAME 2> $OUT_DIR/$NAME.stats.$run > /dev/null
+		if [ "$?" -ne 0 ]
+		then
+			echo "Failed to compile $OUT_DIR/$NAME.c"
+			exit 1
+		fi
+	done
+
+	# one line per phase: config phase ms arena_allocs arena_bytes rss_kb objects
+	YS_BYTES=$(wc -c < $OUT_DIR/$NAME.ys)
+	cat $OUT_DIR/$NAME.stats.* | awk -v name=$NAME -v ys_bytes=$YS_BYTES '
+		$2 !~ /^[0-9.]+$/ { next }
+		{
+			phase = $1
+			if (!(phase in ms)) {
+				order[++count] = phase
+				ms[phase] = $2
+			} else if ($2 + 0 < ms[phase] + 0) {
+				ms[phase] = $2
+			}
+			allocs[phase] = $3; bytes[phase] = $4
+			if ($5 + 0 > rss[phase] + 0)
+				rss[phase] = $5
+
+			objects = ""
+			if (phase != "total")
+				for (i = 6; i < NF; i += 2) {
+					value = $(i + 1); sub(",", "", value)
+					objects = objects (objects == "" ? "" : ",") $i "=" value
+				}
+			if (phase == "emit")
+				objects = objects ",ys_bytes=" ys_bytes
+			obj[phase] = (objects == "" ? "-" : objects)
+		}
+		END {
+			for (i = 1; i <= count; i++)
+				printf "%s %s %s %s %s %s %s\n", name, order[i], ms[order[i]], allocs[order[i]], bytes[order[i]], rss[order[i]], obj[order[i]]
+		}' >> $RESULTS
+	rm -f $OUT_DIR/$NAME.stats.*
+done
+
+echo "config       phase          ms arena_allocs  arena_bytes   rss KB  objects"
+awk '{ printf "%-12s %-8s %10s %12s %12s %8s  %s\n", $1, $2, $3, $4, $5, $6, $7 }' $RESULTS
+
+if [ "$UPDATE" -eq 1 ] || [ ! -e $BASELINE ]
+then
+	cp $RESULTS $BASELINE
+	echo "Wrote $BASELINE"
+	exit 0
+fi
+
+echo " "
+echo "Comparing against $BASELINE..."
+
+awk -v time_slack=$TIME_SLACK -v min_ms=$MIN_MS -v rss_slack=$RSS_SLACK '
+	# value of count name in an objects field like "instructions=75664,ys_bytes=2327044"
+	function count_of(objects, name,    n, i, pair) {
+		n = split(objects, pair, /[,=]/)
+		for (i = 1; i < n; i += 2)
+			if (pair[i] == name)
+				return pair[i + 1]
+		return ""
+	}
+	NR == FNR { key = $1 " " $2; b_ms[key] = $3; b_bytes[key] = $5; b_rss[key] = $6; b_obj[key] = $7; next }
+	{
+		key = $1 " " $2
+		if (!(key in b_ms)) {
+			print "new:        " key
+			next
+		}
+		if ($5 + 0 > b_bytes[key] + 0) {
+			printf "REGRESSION: %s arena bytes %s -> %s\n", key, b_bytes[key], $5; failed = 1
+		}
+		for (i = 1; i <= 2; i++) {
+			name = (i == 1) ? "instructions" : "ys_bytes"
+			before = count_of(b_obj[key], name); after = count_of($7, name)
+			if (before != "" && after != "" && after + 0 > before + 0) {
+				printf "REGRESSION: %s %s %s -> %s\n", key, name, before, after; failed = 1
+			}
+		}
+		if ($3 > b_ms[key] * time_slack && $3 - b_ms[key] >= min_ms)
+			printf "slower:     %s time %s -> %s ms\n", key, b_ms[key], $3
+		if ($6 > b_rss[key] * rss_slack)
+			printf "bigger:     %s peak rss %s -> %s KB\n", key, b_rss[key], $6
+		if ($7 != b_obj[key])
+			printf "changed:    %s objects %s -> %s\n", key, b_obj[key], $7
+	}
+	END { exit failed }' $BASELINE $RESULTS
+
+if [ "$?" -ne 0 ]
+then
+	echo "Benchmark regressed."
+	exit 1
+fi
+
+echo "No regressions."
+exit 0
@@ -26,7 +26,7 @@ then
 	exit 1
 fi
 
-./gen_target_code $2 < $1
+./gen_target_code $1 $2
 
 if [ "$?" -ne 0 ]
 then
@@ -41,6 +41,22 @@ then
 fi
 
 OUT_FILE="$2.ys"
+
+# without the course tools, run the in-tree assembler / simulator instead
+if ! command -v yas > /dev/null
+then
+	make y86sim > /dev/null
+	if [ "$?" -ne 0 ]
+	then
+		echo "Errors building y86sim."
+		exit 1
+	fi
+
+	echo "Running $OUT_FILE with y86sim"
+	./y86sim $OUT_FILE
+	exit $?
+fi
+
 yas $OUT_FILE
 
 if [ "$?" -ne 0 ]
@@ -52,5 +68,3 @@ fi
 EXECUTABLE="$2.yo"
 echo "Running .yo executable $EXECUTABLE"
 ssim $3 $EXECUTABLE
-
-
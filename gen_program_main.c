@@ -0,0 +1,269 @@
+/*
+ * FILE: gen_program_main.c
+ * DESCRIPTION: writes a synthetic C-subset program to stdout, sized by its
+ * options, for timing the compiler on inputs far bigger than tests/
+ *
+ * USAGE: ./gen_program [-f functions] [-d depth] [-s stmts] [-e terms]
+ *                      [-a array_size] [-g globals] [-r seed]
+ *   -f  functions besides main (default 10)
+ *   -d  nesting depth of if / while / for / blocks in each function (default 3)
+ *   -s  statements per block (default 4)
+ *   -e  terms per expression (default 6)
+ *   -a  length of every local and global array (default 16)
+ *   -g  global ints (default 50), plus one global array per 100 of them
+ *   -r  seed -- the same options and seed always give the same program
+ *
+ * Every loop runs twice, so the programs halt, but a deep nest of loops
+ * runs 2^depth times. main calls each function once and prints a checksum.
+ *
+ * Students: Yondon Fu and Matt McFarland - Delights (CS 57 - 16W)
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static int functions = 10;
+static int depth = 3;
+static int stmts = 4;
+static int terms = 6;
+static int array_size = 16;
+static int globals = 50;
+static unsigned long seed = 57;
+
+static int global_arrays;       // globals / 100, at least 1
+
+static void usage(char * prog) {
+  fprintf(stderr, "usage: %s [-f functions] [-d depth] [-s stmts] [-e terms] [-a array_size] [-g globals] [-r seed]\n", prog);
+}
+
+/* deterministic across platforms, unlike rand() */
+static int pick(int n) {
+  seed = seed * 6364136223846793005UL + 1442695040888963407UL;
+  return (int)((seed >> 33) % (unsigned long)n);
+}
+
+static void indent(int level) {
+  for (int i = 0; i < level; i++)
+    putchar('\t');
+}
+
+/* a variable, array element or constant usable at nesting level */
+static void gen_term(int level) {
+  switch (pick(7)) {
+    case 0: printf("%d", pick(100)); break;
+    case 1: printf("x"); break;
+    case 2: printf("p%d", pick(2)); break;
+    case 3: printf("g%d", pick(globals)); break;
+    case 4: printf("loc[%d]", pick(array_size)); break;
+    case 5: printf("ga%d[%d]", pick(global_arrays), pick(array_size)); break;
+    default:
+      /* counters of enclosing loops, kept in bounds */
+      if (level > 0)
+        printf("arr[i%d %% %d]", pick(level), array_size);
+      else
+        printf("y");
+      break;
+  }
+}
+
+static void gen_expr(int level, int n) {
+  static const char * ops[] = { " + ", " - ", " * ", " + ", " - " };
+
+  for (int i = 0; i < n; i++) {
+    if (i > 0)
+      printf("%s", ops[pick(5)]);
+
+    if (n - i > 2 && pick(5) == 0) {
+      /* parenthesized subexpression, divided by a nonzero constant now and then */
+      int inner = 2 + pick(n - i - 1);
+      printf("(");
+      gen_expr(level, inner);
+      printf(")");
+      if (pick(3) == 0)
+        printf(" / %d", 1 + pick(9));
+      i += inner - 1;
+    } else {
+      gen_term(level);
+    }
+  }
+}
+
+static void gen_cond(int level) {
+  static const char * rels[] = { " < ", " <= ", " > ", " >= ", " == ", " != " };
+
+  gen_term(level);
+  printf("%s", rels[pick(6)]);
+  gen_term(level);
+  if (pick(3) == 0) {
+    printf(pick(2) ? " && " : " || ");
+    gen_term(level);
+    printf("%s", rels[pick(6)]);
+    gen_term(level);
+  }
+}
+
+static void gen_block(int level, int counter);
+
+static void gen_stmt(int level) {
+  int kind = (level < depth) ? pick(6) : pick(2);
+
+  switch (kind) {
+    case 0:
+    case 1: {
+      static const char * targets[] = { "x", "y", "loc[%d]", "g%d" };
+      int t = pick(4);
+      indent(level + 1);
+      if (t == 2)
+        printf(targets[t], pick(array_size));
+      else if (t == 3)
+        printf(targets[t], pick(globals));
+      else
+        printf("%s", targets[t]);
+      printf(" = ");
+      gen_expr(level, terms);
+      printf(";\n");
+      break;
+    }
+    case 2:
+      indent(level + 1);
+      printf("if (");
+      gen_cond(level);
+      printf(") ");
+      gen_block(level + 1, -1);
+      if (pick(2)) {
+        indent(level + 1);
+        printf("else ");
+        gen_block(level + 1, -1);
+      }
+      break;
+    case 3:
+      indent(level + 1);
+      printf("for (i%d = 0; i%d < 2; i%d++) ", level, level, level);
+      gen_block(level + 1, -1);
+      break;
+    case 4:
+      indent(level + 1);
+      printf("i%d = 0;\n", level);
+      indent(level + 1);
+      printf("while (i%d < 2) ", level);
+      gen_block(level + 1, level);
+      break;
+    default:
+      indent(level + 1);
+      gen_block(level + 1, -1);
+      break;
+  }
+}
+
+/*
+ * a compound statement with its own local, so every block is a scope.
+ * a while body bumps its loop's counter (counter >= 0) as its last statement
+ */
+static void gen_block(int level, int counter) {
+  printf("{\n");
+  indent(level + 1);
+  printf("int b%d;\n", level);
+  indent(level + 1);
+  printf("b%d = ", level);
+  gen_expr(level, terms);
+  printf(";\n");
+
+  for (int i = 0; i < stmts; i++)
+    gen_stmt(level);
+
+  indent(level + 1);
+  printf("x = x + b%d;\n", level);
+  if (counter >= 0) {
+    indent(level + 1);
+    printf("i%d = i%d + 1;\n", counter, counter);
+  }
+  indent(level);
+  printf("}\n");
+}
+
+static void gen_function(int f) {
+  printf("\nint f%d(int p0, int p1, int arr[]) {\n", f);
+  printf("\tint x, y;\n");
+  printf("\tint loc[%d];\n", array_size);
+  if (depth > 0) {
+    printf("\tint ");
+    for (int i = 0; i < depth; i++)
+      printf("%si%d", i ? ", " : "", i);
+    printf(";\n");
+    for (int i = 0; i < depth; i++)
+      printf("\ti%d = 0;\n", i);
+  }
+  printf("\tfor (x = 0; x < %d; x++)\n\t\tloc[x] = x;\n", array_size);
+  printf("\tx = p0;\n");
+  printf("\ty = p1;\n");
+
+  for (int i = 0; i < stmts; i++)
+    gen_stmt(0);
+
+  printf("\treturn ");
+  gen_expr(0, terms);
+  printf(";\n}\n");
+}
+
+int main(int argc, char * argv[]) {
+  for (int i = 1; i < argc; i++) {
+    int * option = NULL;
+    if (strcmp(argv[i], "-f") == 0)
+      option = &functions;
+    else if (strcmp(argv[i], "-d") == 0)
+      option = &depth;
+    else if (strcmp(argv[i], "-s") == 0)
+      option = &stmts;
+    else if (strcmp(argv[i], "-e") == 0)
+      option = &terms;
+    else if (strcmp(argv[i], "-a") == 0)
+      option = &array_size;
+    else if (strcmp(argv[i], "-g") == 0)
+      option = &globals;
+
+    if (option && i + 1 < argc) {
+      *option = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "-r") == 0 && i + 1 < argc) {
+      seed = strtoul(argv[++i], NULL, 10);
+    } else {
+      usage(argv[0]);
+      return 2;
+    }
+  }
+
+  /* loops run while their counter is below 2 */
+  if (functions < 0 || depth < 0 || stmts < 0 || terms < 1 || array_size < 2 || globals < 1) {
+    usage(argv[0]);
+    return 2;
+  }
+  global_arrays = globals / 100 > 0 ? globals / 100 : 1;
+
+  printf("/*\n * generated by gen_program -f %d -d %d -s %d -e %d -a %d -g %d\n */\n\n",
+    functions, depth, stmts, terms, array_size, globals);
+
+  for (int i = 0; i < globals; i++) {
+    if (pick(2))
+      printf("int g%d = %d;\n", i, pick(1000));
+    else
+      printf("int g%d;\n", i);
+  }
+  for (int i = 0; i < global_arrays; i++)
+    printf("int ga%d[%d];\n", i, array_size);
+
+  for (int f = 0; f < functions; f++)
+    gen_function(f);
+
+  printf("\nint main(void) {\n");
+  printf("\tint i, sum;\n");
+  printf("\tint arr[%d];\n", array_size);
+  printf("\tfor (i = 0; i < %d; i++)\n\t\tarr[i] = i;\n", array_size);
+  printf("\tsum = 0;\n");
+  for (int f = 0; f < functions; f++)
+    printf("\tsum = sum + f%d(%d, %d, arr);\n", f, pick(10), pick(10));
+  printf("\tprint sum;\n");
+  printf("\treturn 0;\n}\n");
+
+  return 0;
+}
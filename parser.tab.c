@@ -0,0 +1,2817 @@
+/* A Bison parser, made by GNU Bison 3.8.2.  */
+
+/* Bison implementation for Yacc-like parsers in C
+
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
+
+/* As a special exception, you may create a larger work that contains
+   part or all of the Bison parser skeleton and distribute that work
+   under terms of your choice, so long as that work isn't itself a
+   parser generator using the skeleton or a modified version thereof
+   as a parser skeleton.  Alternatively, if you modify or redistribute
+   the parser skeleton itself, you may (at your option) remove this
+   special exception, which will cause the skeleton and the resulting
+   Bison output files to be licensed under the GNU General Public
+   License without this special exception.
+
+   This special exception was added by the Free Software Foundation in
+   version 2.2 of Bison.  */
+
+/* C LALR(1) parser skeleton written by Richard Stallman, by
+   simplifying the original so-called "semantic" parser.  */
+
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
+/* All symbols defined below should begin with yy or YY, to avoid
+   infringing on user name space.  This should be done even for local
+   variables, as they might otherwise be expanded by user macros.
+   There are some unavoidable exceptions within include files to
+   define necessary library symbols; they are noted "INFRINGES ON
+   USER NAME SPACE" below.  */
+
+/* Identify Bison output, and Bison version.  */
+#define YYBISON 30802
+
+/* Bison version string.  */
+#define YYBISON_VERSION "3.8.2"
+
+/* Skeleton name.  */
+#define YYSKELETON_NAME "yacc.c"
+
+/* Pure parsers.  */
+#define YYPURE 0
+
+/* Push parsers.  */
+#define YYPUSH 0
+
+/* Pull parsers.  */
+#define YYPULL 1
+
+
+
+
+/* First part of user prologue.  */
+#line 13 "parser.y"
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include "src/ast.h" 			// defines ast node types and functions
+#include "src/arena.h" 			// strings live as long as the AST
+#include "src/intern.h" 		// one copy of each identifier
+#include <assert.h>
+
+#define YYSTYPE ast_node 	// override default node type
+#define YYDEBUG 1 			// turn on debugging
+
+#define MAX_ERRORS 6		// will stop parsing after this many syntax errors
+
+/* from .l file */
+extern int yylex();
+extern char *yytext;
+extern int yylineno;
+extern char savedIdText[];
+extern char savedLiteralText[];
+
+/* from .c main file */
+extern ast_node root;
+extern int parseError;
+
+/* in this .y file */
+int yyerror(char *s);
+int errors; 				// global error count
+
+
+#line 102 "parser.tab.c"
+
+# ifndef YY_CAST
+#  ifdef __cplusplus
+#   define YY_CAST(Type, Val) static_cast<Type> (Val)
+#   define YY_REINTERPRET_CAST(Type, Val) reinterpret_cast<Type> (Val)
+#  else
+#   define YY_CAST(Type, Val) ((Type) (Val))
+#   define YY_REINTERPRET_CAST(Type, Val) ((Type) (Val))
+#  endif
+# endif
+# ifndef YY_NULLPTR
+#  if defined __cplusplus
+#   if 201103L <= __cplusplus
+#    define YY_NULLPTR nullptr
+#   else
+#    define YY_NULLPTR 0
+#   endif
+#  else
+#   define YY_NULLPTR ((void*)0)
+#  endif
+# endif
+
+#include "parser.tab.h"
+/* Symbol kind.  */
+enum yysymbol_kind_t
+{
+  YYSYMBOL_YYEMPTY = -2,
+  YYSYMBOL_YYEOF = 0,                      /* "end of file"  */
+  YYSYMBOL_YYerror = 1,                    /* error  */
+  YYSYMBOL_YYUNDEF = 2,                    /* "invalid token"  */
+  YYSYMBOL_ID_T = 3,                       /* ID_T  */
+  YYSYMBOL_INT_T = 4,                      /* INT_T  */
+  YYSYMBOL_STRING_T = 5,                   /* STRING_T  */
+  YYSYMBOL_TYPEINT_T = 6,                  /* TYPEINT_T  */
+  YYSYMBOL_IF_T = 7,                       /* IF_T  */
+  YYSYMBOL_ELSE_T = 8,                     /* ELSE_T  */
+  YYSYMBOL_DO_T = 9,                       /* DO_T  */
+  YYSYMBOL_WHILE_T = 10,                   /* WHILE_T  */
+  YYSYMBOL_RETURN_T = 11,                  /* RETURN_T  */
+  YYSYMBOL_BREAK_T = 12,                   /* BREAK_T  */
+  YYSYMBOL_CONTINUE_T = 13,                /* CONTINUE_T  */
+  YYSYMBOL_FOR_T = 14,                     /* FOR_T  */
+  YYSYMBOL_VOID_T = 15,                    /* VOID_T  */
+  YYSYMBOL_READ_T = 16,                    /* READ_T  */
+  YYSYMBOL_PRINT_T = 17,                   /* PRINT_T  */
+  YYSYMBOL_SIZEOF_T = 18,                  /* SIZEOF_T  */
+  YYSYMBOL_19_ = 19,                       /* '+'  */
+  YYSYMBOL_20_ = 20,                       /* '-'  */
+  YYSYMBOL_21_ = 21,                       /* '*'  */
+  YYSYMBOL_22_ = 22,                       /* '/'  */
+  YYSYMBOL_23_ = 23,                       /* '='  */
+  YYSYMBOL_24_ = 24,                       /* '<'  */
+  YYSYMBOL_25_ = 25,                       /* '>'  */
+  YYSYMBOL_LTE_T = 26,                     /* LTE_T  */
+  YYSYMBOL_GTE_T = 27,                     /* GTE_T  */
+  YYSYMBOL_EQ_T = 28,                      /* EQ_T  */
+  YYSYMBOL_NE_T = 29,                      /* NE_T  */
+  YYSYMBOL_INCR_T = 30,                    /* INCR_T  */
+  YYSYMBOL_DECR_T = 31,                    /* DECR_T  */
+  YYSYMBOL_AND_T = 32,                     /* AND_T  */
+  YYSYMBOL_OR_T = 33,                      /* OR_T  */
+  YYSYMBOL_34_ = 34,                       /* '!'  */
+  YYSYMBOL_35_ = 35,                       /* ';'  */
+  YYSYMBOL_36_ = 36,                       /* ','  */
+  YYSYMBOL_37_ = 37,                       /* '('  */
+  YYSYMBOL_38_ = 38,                       /* ')'  */
+  YYSYMBOL_39_ = 39,                       /* '['  */
+  YYSYMBOL_40_ = 40,                       /* ']'  */
+  YYSYMBOL_41_ = 41,                       /* '{'  */
+  YYSYMBOL_42_ = 42,                       /* '}'  */
+  YYSYMBOL_43_ = 43,                       /* '%'  */
+  YYSYMBOL_COMMENT_T = 44,                 /* COMMENT_T  */
+  YYSYMBOL_OTHER_T = 45,                   /* OTHER_T  */
+  YYSYMBOL_LOWER_THAN_ELSE = 46,           /* LOWER_THAN_ELSE  */
+  YYSYMBOL_UMINUS_T = 47,                  /* UMINUS_T  */
+  YYSYMBOL_YYACCEPT = 48,                  /* $accept  */
+  YYSYMBOL_program = 49,                   /* program  */
+  YYSYMBOL_declaration_list = 50,          /* declaration_list  */
+  YYSYMBOL_declaration = 51,               /* declaration  */
+  YYSYMBOL_var_declaration = 52,           /* var_declaration  */
+  YYSYMBOL_type_specifier = 53,            /* type_specifier  */
+  YYSYMBOL_var_declaration_list = 54,      /* var_declaration_list  */
+  YYSYMBOL_var_decl = 55,                  /* var_decl  */
+  YYSYMBOL_func_declaration = 56,          /* func_declaration  */
+  YYSYMBOL_57_1 = 57,                      /* $@1  */
+  YYSYMBOL_formal_params = 58,             /* formal_params  */
+  YYSYMBOL_formal_list = 59,               /* formal_list  */
+  YYSYMBOL_formal_param = 60,              /* formal_param  */
+  YYSYMBOL_compound_stmt = 61,             /* compound_stmt  */
+  YYSYMBOL_local_declarations = 62,        /* local_declarations  */
+  YYSYMBOL_stmt_list = 63,                 /* stmt_list  */
+  YYSYMBOL_stmt = 64,                      /* stmt  */
+  YYSYMBOL_expression_stmt = 65,           /* expression_stmt  */
+  YYSYMBOL_if_stmt = 66,                   /* if_stmt  */
+  YYSYMBOL_while_stmt = 67,                /* while_stmt  */
+  YYSYMBOL_do_while_stmt = 68,             /* do_while_stmt  */
+  YYSYMBOL_for_stmt = 69,                  /* for_stmt  */
+  YYSYMBOL_for_header_expr = 70,           /* for_header_expr  */
+  YYSYMBOL_return_stmt = 71,               /* return_stmt  */
+  YYSYMBOL_read_stmt = 72,                 /* read_stmt  */
+  YYSYMBOL_print_stmt = 73,                /* print_stmt  */
+  YYSYMBOL_74_2 = 74,                      /* $@2  */
+  YYSYMBOL_break_stmt = 75,                /* break_stmt  */
+  YYSYMBOL_continue_stmt = 76,             /* continue_stmt  */
+  YYSYMBOL_expression = 77,                /* expression  */
+  YYSYMBOL_var = 78,                       /* var  */
+  YYSYMBOL_79_3 = 79,                      /* $@3  */
+  YYSYMBOL_r_value = 80,                   /* r_value  */
+  YYSYMBOL_call = 81,                      /* call  */
+  YYSYMBOL_82_4 = 82,                      /* $@4  */
+  YYSYMBOL_args = 83,                      /* args  */
+  YYSYMBOL_arg_list = 84                   /* arg_list  */
+};
+typedef enum yysymbol_kind_t yysymbol_kind_t;
+
+
+
+
+#ifdef short
+# undef short
+#endif
+
+/* On compilers that do not define __PTRDIFF_MAX__ etc., make sure
+   <limits.h> and (if available) <stdint.h> are included
+   so that the code can choose integer types of a good width.  */
+
+#ifndef __PTRDIFF_MAX__
+# include <limits.h> /* INFRINGES ON USER NAME SPACE */
+# if defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
+#  include <stdint.h> /* INFRINGES ON USER NAME SPACE */
+#  define YY_STDINT_H
+# endif
+#endif
+
+/* Narrow types that promote to a signed type and that can represent a
+   signed or unsigned integer of at least N bits.  In tables they can
+   save space and decrease cache pressure.  Promoting to a signed type
+   helps avoid bugs in integer arithmetic.  */
+
+#ifdef __INT_LEAST8_MAX__
+typedef __INT_LEAST8_TYPE__ yytype_int8;
+#elif defined YY_STDINT_H
+typedef int_least8_t yytype_int8;
+#else
+typedef signed char yytype_int8;
+#endif
+
+#ifdef __INT_LEAST16_MAX__
+typedef __INT_LEAST16_TYPE__ yytype_int16;
+#elif defined YY_STDINT_H
+typedef int_least16_t yytype_int16;
+#else
+typedef short yytype_int16;
+#endif
+
+/* Work around bug in HP-UX 11.23, which defines these macros
+   incorrectly for preprocessor constants.  This workaround can likely
+   be removed in 2023, as HPE has promised support for HP-UX 11.23
+   (aka HP-UX 11i v2) only through the end of 2022; see Table 2 of
+   <https://h20195.www2.hpe.com/V2/getpdf.aspx/4AA4-7673ENW.pdf>.  */
+#ifdef __hpux
+# undef UINT_LEAST8_MAX
+# undef UINT_LEAST16_MAX
+# define UINT_LEAST8_MAX 255
+# define UINT_LEAST16_MAX 65535
+#endif
+
+#if defined __UINT_LEAST8_MAX__ && __UINT_LEAST8_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST8_TYPE__ yytype_uint8;
+#elif (!defined __UINT_LEAST8_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST8_MAX <= INT_MAX)
+typedef uint_least8_t yytype_uint8;
+#elif !defined __UINT_LEAST8_MAX__ && UCHAR_MAX <= INT_MAX
+typedef unsigned char yytype_uint8;
+#else
+typedef short yytype_uint8;
+#endif
+
+#if defined __UINT_LEAST16_MAX__ && __UINT_LEAST16_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST16_TYPE__ yytype_uint16;
+#elif (!defined __UINT_LEAST16_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST16_MAX <= INT_MAX)
+typedef uint_least16_t yytype_uint16;
+#elif !defined __UINT_LEAST16_MAX__ && USHRT_MAX <= INT_MAX
+typedef unsigned short yytype_uint16;
+#else
+typedef int yytype_uint16;
+#endif
+
+#ifndef YYPTRDIFF_T
+# if defined __PTRDIFF_TYPE__ && defined __PTRDIFF_MAX__
+#  define YYPTRDIFF_T __PTRDIFF_TYPE__
+#  define YYPTRDIFF_MAXIMUM __PTRDIFF_MAX__
+# elif defined PTRDIFF_MAX
+#  ifndef ptrdiff_t
+#   include <stddef.h> /* INFRINGES ON USER NAME SPACE */
+#  endif
+#  define YYPTRDIFF_T ptrdiff_t
+#  define YYPTRDIFF_MAXIMUM PTRDIFF_MAX
+# else
+#  define YYPTRDIFF_T long
+#  define YYPTRDIFF_MAXIMUM LONG_MAX
+# endif
+#endif
+
+#ifndef YYSIZE_T
+# ifdef __SIZE_TYPE__
+#  define YYSIZE_T __SIZE_TYPE__
+# elif defined size_t
+#  define YYSIZE_T size_t
+# elif defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
+#  include <stddef.h> /* INFRINGES ON USER NAME SPACE */
+#  define YYSIZE_T size_t
+# else
+#  define YYSIZE_T unsigned
+# endif
+#endif
+
+#define YYSIZE_MAXIMUM                                  \
+  YY_CAST (YYPTRDIFF_T,                                 \
+           (YYPTRDIFF_MAXIMUM < YY_CAST (YYSIZE_T, -1)  \
+            ? YYPTRDIFF_MAXIMUM                         \
+            : YY_CAST (YYSIZE_T, -1)))
+
+#define YYSIZEOF(X) YY_CAST (YYPTRDIFF_T, sizeof (X))
+
+
+/* Stored state numbers (used for stacks). */
+typedef yytype_uint8 yy_state_t;
+
+/* State numbers in computations.  */
+typedef int yy_state_fast_t;
+
+#ifndef YY_
+# if defined YYENABLE_NLS && YYENABLE_NLS
+#  if ENABLE_NLS
+#   include <libintl.h> /* INFRINGES ON USER NAME SPACE */
+#   define YY_(Msgid) dgettext ("bison-runtime", Msgid)
+#  endif
+# endif
+# ifndef YY_
+#  define YY_(Msgid) Msgid
+# endif
+#endif
+
+
+#ifndef YY_ATTRIBUTE_PURE
+# if defined __GNUC__ && 2 < __GNUC__ + (96 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_PURE __attribute__ ((__pure__))
+# else
+#  define YY_ATTRIBUTE_PURE
+# endif
+#endif
+
+#ifndef YY_ATTRIBUTE_UNUSED
+# if defined __GNUC__ && 2 < __GNUC__ + (7 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_UNUSED __attribute__ ((__unused__))
+# else
+#  define YY_ATTRIBUTE_UNUSED
+# endif
+#endif
+
+/* Suppress unused-variable warnings by "using" E.  */
+#if ! defined lint || defined __GNUC__
+# define YY_USE(E) ((void) (E))
+#else
+# define YY_USE(E) /* empty */
+#endif
+
+/* Suppress an incorrect diagnostic about yylval being uninitialized.  */
+#if defined __GNUC__ && ! defined __ICC && 406 <= __GNUC__ * 100 + __GNUC_MINOR__
+# if __GNUC__ * 100 + __GNUC_MINOR__ < 407
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")
+# else
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")              \
+    _Pragma ("GCC diagnostic ignored \"-Wmaybe-uninitialized\"")
+# endif
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END      \
+    _Pragma ("GCC diagnostic pop")
+#else
+# define YY_INITIAL_VALUE(Value) Value
+#endif
+#ifndef YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+# define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END
+#endif
+#ifndef YY_INITIAL_VALUE
+# define YY_INITIAL_VALUE(Value) /* Nothing. */
+#endif
+
+#if defined __cplusplus && defined __GNUC__ && ! defined __ICC && 6 <= __GNUC__
+# define YY_IGNORE_USELESS_CAST_BEGIN                          \
+    _Pragma ("GCC diagnostic push")                            \
+    _Pragma ("GCC diagnostic ignored \"-Wuseless-cast\"")
+# define YY_IGNORE_USELESS_CAST_END            \
+    _Pragma ("GCC diagnostic pop")
+#endif
+#ifndef YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_END
+#endif
+
+
+#define YY_ASSERT(E) ((void) (0 && (E)))
+
+#if 1
+
+/* The parser invokes alloca or malloc; define the necessary symbols.  */
+
+# ifdef YYSTACK_USE_ALLOCA
+#  if YYSTACK_USE_ALLOCA
+#   ifdef __GNUC__
+#    define YYSTACK_ALLOC __builtin_alloca
+#   elif defined __BUILTIN_VA_ARG_INCR
+#    include <alloca.h> /* INFRINGES ON USER NAME SPACE */
+#   elif defined _AIX
+#    define YYSTACK_ALLOC __alloca
+#   elif defined _MSC_VER
+#    include <malloc.h> /* INFRINGES ON USER NAME SPACE */
+#    define alloca _alloca
+#   else
+#    define YYSTACK_ALLOC alloca
+#    if ! defined _ALLOCA_H && ! defined EXIT_SUCCESS
+#     include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
+      /* Use EXIT_SUCCESS as a witness for stdlib.h.  */
+#     ifndef EXIT_SUCCESS
+#      define EXIT_SUCCESS 0
+#     endif
+#    endif
+#   endif
+#  endif
+# endif
+
+# ifdef YYSTACK_ALLOC
+   /* Pacify GCC's 'empty if-body' warning.  */
+#  define YYSTACK_FREE(Ptr) do { /* empty */; } while (0)
+#  ifndef YYSTACK_ALLOC_MAXIMUM
+    /* The OS might guarantee only one guard page at the bottom of the stack,
+       and a page size can be as small as 4096 bytes.  So we cannot safely
+       invoke alloca (N) if N exceeds 4096.  Use a slightly smaller number
+       to allow for a few compiler-allocated temporary stack slots.  */
+#   define YYSTACK_ALLOC_MAXIMUM 4032 /* reasonable circa 2006 */
+#  endif
+# else
+#  define YYSTACK_ALLOC YYMALLOC
+#  define YYSTACK_FREE YYFREE
+#  ifndef YYSTACK_ALLOC_MAXIMUM
+#   define YYSTACK_ALLOC_MAXIMUM YYSIZE_MAXIMUM
+#  endif
+#  if (defined __cplusplus && ! defined EXIT_SUCCESS \
+       && ! ((defined YYMALLOC || defined malloc) \
+             && (defined YYFREE || defined free)))
+#   include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
+#   ifndef EXIT_SUCCESS
+#    define EXIT_SUCCESS 0
+#   endif
+#  endif
+#  ifndef YYMALLOC
+#   define YYMALLOC malloc
+#   if ! defined malloc && ! defined EXIT_SUCCESS
+void *malloc (YYSIZE_T); /* INFRINGES ON USER NAME SPACE */
+#   endif
+#  endif
+#  ifndef YYFREE
+#   define YYFREE free
+#   if ! defined free && ! defined EXIT_SUCCESS
+void free (void *); /* INFRINGES ON USER NAME SPACE */
+#   endif
+#  endif
+# endif
+#endif /* 1 */
+
+#if (! defined yyoverflow \
+     && (! defined __cplusplus \
+         || (defined YYSTYPE_IS_TRIVIAL && YYSTYPE_IS_TRIVIAL)))
+
+/* A type that is properly aligned for any stack member.  */
+union yyalloc
+{
+  yy_state_t yyss_alloc;
+  YYSTYPE yyvs_alloc;
+};
+
+/* The size of the maximum gap between one aligned stack and the next.  */
+# define YYSTACK_GAP_MAXIMUM (YYSIZEOF (union yyalloc) - 1)
+
+/* The size of an array large to enough to hold all stacks, each with
+   N elements.  */
+# define YYSTACK_BYTES(N) \
+     ((N) * (YYSIZEOF (yy_state_t) + YYSIZEOF (YYSTYPE)) \
+      + YYSTACK_GAP_MAXIMUM)
+
+# define YYCOPY_NEEDED 1
+
+/* Relocate STACK from its old location to the new one.  The
+   local variables YYSIZE and YYSTACKSIZE give the old and new number of
+   elements in the stack, and YYPTR gives the new location of the
+   stack.  Advance YYPTR to a properly aligned location for the next
+   stack.  */
+# define YYSTACK_RELOCATE(Stack_alloc, Stack)                           \
+    do                                                                  \
+      {                                                                 \
+        YYPTRDIFF_T yynewbytes;                                         \
+        YYCOPY (&yyptr->Stack_alloc, Stack, yysize);                    \
+        Stack = &yyptr->Stack_alloc;                                    \
+        yynewbytes = yystacksize * YYSIZEOF (*Stack) + YYSTACK_GAP_MAXIMUM; \
+        yyptr += yynewbytes / YYSIZEOF (*yyptr);                        \
+      }                                                                 \
+    while (0)
+
+#endif
+
+#if defined YYCOPY_NEEDED && YYCOPY_NEEDED
+/* Copy COUNT objects from SRC to DST.  The source and destination do
+   not overlap.  */
+# ifndef YYCOPY
+#  if defined __GNUC__ && 1 < __GNUC__
+#   define YYCOPY(Dst, Src, Count) \
+      __builtin_memcpy (Dst, Src, YY_CAST (YYSIZE_T, (Count)) * sizeof (*(Src)))
+#  else
+#   define YYCOPY(Dst, Src, Count)              \
+      do                                        \
+        {                                       \
+          YYPTRDIFF_T yyi;                      \
+          for (yyi = 0; yyi < (Count); yyi++)   \
+            (Dst)[yyi] = (Src)[yyi];            \
+        }                                       \
+      while (0)
+#  endif
+# endif
+#endif /* !YYCOPY_NEEDED */
+
+/* YYFINAL -- State number of the termination state.  */
+#define YYFINAL  3
+/* YYLAST -- Last index in YYTABLE.  */
+#define YYLAST   551
+
+/* YYNTOKENS -- Number of terminals.  */
+#define YYNTOKENS  48
+/* YYNNTS -- Number of nonterminals.  */
+#define YYNNTS  37
+/* YYNRULES -- Number of rules.  */
+#define YYNRULES  103
+/* YYNSTATES -- Number of states.  */
+#define YYNSTATES  193
+
+/* YYMAXUTOK -- Last valid token kind.  */
+#define YYMAXUTOK   285
+
+
+/* YYTRANSLATE(TOKEN-NUM) -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex, with out-of-bounds checking.  */
+#define YYTRANSLATE(YYX)                                \
+  (0 <= (YYX) && (YYX) <= YYMAXUTOK                     \
+   ? YY_CAST (yysymbol_kind_t, yytranslate[YYX])        \
+   : YYSYMBOL_YYUNDEF)
+
+/* YYTRANSLATE[TOKEN-NUM] -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex.  */
+static const yytype_int8 yytranslate[] =
+{
+       0,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,    34,     2,     2,     2,    43,     2,     2,
+      37,    38,    21,    19,    36,    20,     2,    22,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,    35,
+      24,    23,    25,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,    39,     2,    40,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,    41,     2,    42,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     1,     2,     3,     4,
+       5,     6,     7,     8,     9,    10,    11,    12,    13,    14,
+      15,    16,    17,    18,    26,    27,    28,    29,    30,    31,
+      32,    33,    44,    45,    46,    47
+};
+
+#if YYDEBUG
+/* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
+static const yytype_int16 yyrline[] =
+{
+       0,    71,    71,    82,    93,   101,   102,   110,   122,   127,
+     139,   150,   160,   166,   173,   190,   190,   213,   217,   222,
+     235,   246,   255,   262,   279,   310,   322,   332,   343,   352,
+     353,   354,   355,   356,   357,   358,   359,   360,   361,   362,
+     370,   374,   377,   386,   391,   397,   399,   406,   411,   417,
+     423,   429,   436,   444,   448,   458,   463,   467,   473,   477,
+     486,   490,   490,   499,   502,   507,   515,   520,   533,   539,
+     539,   556,   561,   566,   571,   576,   581,   586,   591,   596,
+     601,   606,   611,   616,   621,   625,   629,   630,   634,   638,
+     642,   646,   647,   648,   652,   656,   657,   666,   666,   684,
+     685,   693,   704,   708
+};
+#endif
+
+/** Accessing symbol of state STATE.  */
+#define YY_ACCESSING_SYMBOL(State) YY_CAST (yysymbol_kind_t, yystos[State])
+
+#if 1
+/* The user-facing name of the symbol whose (internal) number is
+   YYSYMBOL.  No bounds checking.  */
+static const char *yysymbol_name (yysymbol_kind_t yysymbol) YY_ATTRIBUTE_UNUSED;
+
+/* YYTNAME[SYMBOL-NUM] -- String name of the symbol SYMBOL-NUM.
+   First, the terminals, then, starting at YYNTOKENS, nonterminals.  */
+static const char *const yytname[] =
+{
+  "\"end of file\"", "error", "\"invalid token\"", "ID_T", "INT_T",
+  "STRING_T", "TYPEINT_T", "IF_T", "ELSE_T", "DO_T", "WHILE_T", "RETURN_T",
+  "BREAK_T", "CONTINUE_T", "FOR_T", "VOID_T", "READ_T", "PRINT_T",
+  "SIZEOF_T", "'+'", "'-'", "'*'", "'/'", "'='", "'<'", "'>'", "LTE_T",
+  "GTE_T", "EQ_T", "NE_T", "INCR_T", "DECR_T", "AND_T", "OR_T", "'!'",
+  "';'", "','", "'('", "')'", "'['", "']'", "'{'", "'}'", "'%'",
+  "COMMENT_T", "OTHER_T", "LOWER_THAN_ELSE", "UMINUS_T", "$accept",
+  "program", "declaration_list", "declaration", "var_declaration",
+  "type_specifier", "var_declaration_list", "var_decl", "func_declaration",
+  "$@1", "formal_params", "formal_list", "formal_param", "compound_stmt",
+  "local_declarations", "stmt_list", "stmt", "expression_stmt", "if_stmt",
+  "while_stmt", "do_while_stmt", "for_stmt", "for_header_expr",
+  "return_stmt", "read_stmt", "print_stmt", "$@2", "break_stmt",
+  "continue_stmt", "expression", "var", "$@3", "r_value", "call", "$@4",
+  "args", "arg_list", YY_NULLPTR
+};
+
+static const char *
+yysymbol_name (yysymbol_kind_t yysymbol)
+{
+  return yytname[yysymbol];
+}
+#endif
+
+#define YYPACT_NINF (-167)
+
+#define yypact_value_is_default(Yyn) \
+  ((Yyn) == YYPACT_NINF)
+
+#define YYTABLE_NINF (-101)
+
+#define yytable_value_is_error(Yyn) \
+  0
+
+/* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
+   STATE-NUM.  */
+static const yytype_int16 yypact[] =
+{
+    -167,     7,     0,  -167,  -167,  -167,  -167,  -167,    14,  -167,
+      44,   -22,  -167,   132,     6,    -7,  -167,    43,   -19,  -167,
+      10,   132,    47,    47,   132,   241,   468,    57,  -167,  -167,
+      20,    42,   -14,  -167,    25,    36,    62,  -167,    37,  -167,
+    -167,  -167,    53,   303,   132,   132,   132,   132,   132,   132,
+     132,   132,   132,   132,   132,   132,   132,   132,  -167,  -167,
+    -167,    56,    92,    58,    63,  -167,   132,    48,    60,    64,
+    -167,  -167,    34,    34,  -167,  -167,    50,    50,    50,    50,
+       2,     2,   508,   488,  -167,   468,    69,    68,     0,   323,
+    -167,   468,    73,    65,  -167,  -167,    78,  -167,  -167,  -167,
+    -167,  -167,   132,  -167,     0,   468,  -167,    43,   103,    90,
+      91,   164,    94,   182,    97,   104,   105,    89,   203,  -167,
+    -167,  -167,  -167,  -167,  -167,  -167,  -167,  -167,  -167,  -167,
+    -167,  -167,  -167,   348,  -167,   246,   116,   264,   106,  -167,
+     368,  -167,  -167,   221,   108,   111,   112,  -167,   388,  -167,
+     110,   408,   114,   115,   428,  -167,  -167,   117,   121,   468,
+    -167,  -167,  -167,   122,  -167,   164,   164,   284,   164,   164,
+     126,   132,  -167,   141,   151,   123,   448,  -167,  -167,  -167,
+     125,   164,   164,   129,   135,   132,  -167,  -167,  -167,  -167,
+     149,   164,  -167
+};
+
+/* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
+   Performed when YYTABLE does not specify something else to do.  Zero
+   means the default is an error.  */
+static const yytype_int8 yydefact[] =
+{
+       4,     0,     2,     1,     8,     9,     3,     5,     0,     6,
+      12,     0,    11,     0,     0,     0,     7,     0,    68,    93,
+       0,     0,     0,     0,     0,     0,    13,    86,    67,    91,
+       0,    19,    12,    10,     0,     0,     0,    85,    68,    87,
+      89,    84,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,    88,    90,
+      14,     9,     0,     0,    17,    21,     0,     0,     0,     0,
+      96,    92,    71,    72,    73,    74,    76,    78,    77,    79,
+      80,    81,    82,    83,    75,    66,    22,     0,     0,     0,
+     103,   102,     0,    99,    95,    94,     0,    26,    16,    20,
+      70,    98,     0,    23,    28,   101,    25,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,    41,
+      24,    30,    27,    29,    31,    32,    33,    34,    35,    36,
+      37,    38,    39,     0,    42,     0,     0,     0,     0,    55,
+       0,    64,    65,     0,     0,     0,     0,    61,     0,    40,
+       0,     0,     0,     0,     0,    57,    56,     0,     0,    53,
+      59,    58,    63,     0,    60,     0,     0,     0,     0,     0,
+       0,    54,    62,    45,    43,     0,     0,    48,    47,    52,
+       0,     0,     0,     0,     0,    54,    46,    44,    50,    49,
+       0,     0,    51
+};
+
+/* YYPGOTO[NTERM-NUM].  */
+static const yytype_int16 yypgoto[] =
+{
+    -167,  -167,  -167,  -167,    75,    -1,  -167,   171,  -167,  -167,
+    -167,  -167,    41,   102,  -167,  -167,  -107,  -167,  -167,  -167,
+    -167,  -167,  -166,  -167,  -167,  -167,  -167,  -167,  -167,   -13,
+     -20,  -167,  -167,  -167,  -167,  -167,  -167
+};
+
+/* YYDEFGOTO[NTERM-NUM].  */
+static const yytype_uint8 yydefgoto[] =
+{
+       0,     1,     2,     6,     7,    62,    11,    12,     9,    15,
+      63,    64,    65,   121,   104,   108,   122,   123,   124,   125,
+     126,   127,   158,   128,   129,   130,   163,   131,   132,   133,
+      27,    34,    28,    29,    35,    92,    93
+};
+
+/* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
+   positive, shift that token.  If negative, reduce the rule whose
+   number is the opposite.  If YYTABLE_NINF, syntax error.  */
+static const yytype_int16 yytable[] =
+{
+      26,     8,    39,    40,   136,   180,     4,     3,    37,    13,
+      30,    41,    43,    16,    17,     5,    69,    10,   -97,   190,
+     -69,    44,    45,    46,    47,    14,    48,    49,    50,    51,
+      31,    72,    73,    74,    75,    76,    77,    78,    79,    80,
+      81,    82,    83,    84,    85,    56,    32,    36,     4,    90,
+      38,    18,    19,    89,    91,    46,    47,    61,   173,   174,
+      60,   177,   178,    68,    66,    38,    20,    13,    21,    44,
+      45,    46,    47,    67,   186,   187,   -69,    56,    22,    23,
+      57,   -15,    24,    14,   192,    25,  -100,    58,    59,   105,
+     144,    70,    38,    56,   -18,    86,    87,   145,    94,    88,
+     140,   102,    95,   107,   109,   148,    18,    19,    96,    97,
+     110,   101,   111,   112,   113,   114,   115,   116,   103,   117,
+     118,    20,   151,    21,   154,   134,   152,   179,   135,    99,
+     159,   137,   141,    22,    23,    18,    19,    24,   119,   142,
+      25,   155,   143,   160,    97,   120,   161,   162,   165,   181,
+      20,   167,    21,   168,   176,   170,   171,   172,   159,   182,
+     185,   183,    22,    23,   188,   109,    24,    18,    19,    25,
+     189,   110,   159,   111,   112,   113,   114,   115,   116,   106,
+     117,   118,    20,   138,    21,    18,    19,   191,    33,    98,
+       0,     0,     0,     0,    22,    23,     0,     0,    24,   119,
+      20,    25,    21,     0,   146,    97,    18,    19,   147,     0,
+       0,     0,    22,    23,     0,     0,    24,   139,     0,    25,
+       0,    20,   157,    21,    18,    19,     0,     0,     0,     0,
+       0,     0,     0,    22,    23,     0,     0,    24,     0,    20,
+      25,    21,    42,     0,    18,    19,     0,   150,     0,    18,
+      19,    22,    23,     0,     0,    24,   -54,     0,    25,    20,
+       0,    21,     0,     0,    20,   153,    21,    18,    19,     0,
+       0,    22,    23,     0,     0,    24,    22,    23,    25,     0,
+      24,     0,    20,    25,    21,   175,     0,    18,    19,     0,
+       0,     0,     0,     0,    22,    23,     0,     0,    24,     0,
+       0,    25,    20,     0,    21,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,    22,    23,     0,     0,    24,     0,
+       0,    25,    44,    45,    46,    47,     0,    48,    49,    50,
+      51,    52,    53,     0,     0,    54,    55,     0,     0,     0,
+       0,    71,    44,    45,    46,    47,    56,    48,    49,    50,
+      51,    52,    53,     0,     0,    54,    55,     0,     0,     0,
+       0,     0,     0,   100,     0,     0,    56,    44,    45,    46,
+      47,     0,    48,    49,    50,    51,    52,    53,     0,     0,
+      54,    55,     0,   149,     0,     0,     0,    44,    45,    46,
+      47,    56,    48,    49,    50,    51,    52,    53,     0,     0,
+      54,    55,     0,   156,     0,     0,     0,    44,    45,    46,
+      47,    56,    48,    49,    50,    51,    52,    53,     0,     0,
+      54,    55,     0,   164,     0,     0,     0,    44,    45,    46,
+      47,    56,    48,    49,    50,    51,    52,    53,     0,     0,
+      54,    55,     0,     0,     0,     0,   166,    44,    45,    46,
+      47,    56,    48,    49,    50,    51,    52,    53,     0,     0,
+      54,    55,     0,     0,     0,     0,   169,    44,    45,    46,
+      47,    56,    48,    49,    50,    51,    52,    53,     0,     0,
+      54,    55,     0,     0,     0,     0,   184,    44,    45,    46,
+      47,    56,    48,    49,    50,    51,    52,    53,     0,     0,
+      54,    55,     0,     0,     0,     0,     0,    44,    45,    46,
+      47,    56,    48,    49,    50,    51,    52,    53,     0,     0,
+      54,     0,     0,     0,     0,     0,     0,    44,    45,    46,
+      47,    56,    48,    49,    50,    51,    52,    53,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,    56
+};
+
+static const yytype_int16 yycheck[] =
+{
+      13,     2,    22,    23,   111,   171,     6,     0,    21,    23,
+       4,    24,    25,    35,    36,    15,    36,     3,    37,   185,
+      39,    19,    20,    21,    22,    39,    24,    25,    26,    27,
+      37,    44,    45,    46,    47,    48,    49,    50,    51,    52,
+      53,    54,    55,    56,    57,    43,     3,    37,     6,     1,
+       3,     3,     4,    66,    67,    21,    22,    15,   165,   166,
+      40,   168,   169,     1,    39,     3,    18,    23,    20,    19,
+      20,    21,    22,    37,   181,   182,    39,    43,    30,    31,
+      23,    37,    34,    39,   191,    37,    38,    30,    31,   102,
+       1,    38,     3,    43,    38,     3,    38,   117,    38,    36,
+     113,    36,    38,   104,     1,   118,     3,     4,    39,    41,
+       7,    38,     9,    10,    11,    12,    13,    14,    40,    16,
+      17,    18,   135,    20,   137,    35,    10,     1,    37,    88,
+     143,    37,    35,    30,    31,     3,     4,    34,    35,    35,
+      37,    35,    37,    35,    41,    42,    35,    35,    38,     8,
+      18,    37,    20,    38,   167,    38,    35,    35,   171,     8,
+      35,    38,    30,    31,    35,     1,    34,     3,     4,    37,
+      35,     7,   185,     9,    10,    11,    12,    13,    14,   104,
+      16,    17,    18,     1,    20,     3,     4,    38,    17,    87,
+      -1,    -1,    -1,    -1,    30,    31,    -1,    -1,    34,    35,
+      18,    37,    20,    -1,     1,    41,     3,     4,     5,    -1,
+      -1,    -1,    30,    31,    -1,    -1,    34,    35,    -1,    37,
+      -1,    18,     1,    20,     3,     4,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    30,    31,    -1,    -1,    34,    -1,    18,
+      37,    20,     1,    -1,     3,     4,    -1,     1,    -1,     3,
+       4,    30,    31,    -1,    -1,    34,    35,    -1,    37,    18,
+      -1,    20,    -1,    -1,    18,     1,    20,     3,     4,    -1,
+      -1,    30,    31,    -1,    -1,    34,    30,    31,    37,    -1,
+      34,    -1,    18,    37,    20,     1,    -1,     3,     4,    -1,
+      -1,    -1,    -1,    -1,    30,    31,    -1,    -1,    34,    -1,
+      -1,    37,    18,    -1,    20,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,    30,    31,    -1,    -1,    34,    -1,
+      -1,    37,    19,    20,    21,    22,    -1,    24,    25,    26,
+      27,    28,    29,    -1,    -1,    32,    33,    -1,    -1,    -1,
+      -1,    38,    19,    20,    21,    22,    43,    24,    25,    26,
+      27,    28,    29,    -1,    -1,    32,    33,    -1,    -1,    -1,
+      -1,    -1,    -1,    40,    -1,    -1,    43,    19,    20,    21,
+      22,    -1,    24,    25,    26,    27,    28,    29,    -1,    -1,
+      32,    33,    -1,    35,    -1,    -1,    -1,    19,    20,    21,
+      22,    43,    24,    25,    26,    27,    28,    29,    -1,    -1,
+      32,    33,    -1,    35,    -1,    -1,    -1,    19,    20,    21,
+      22,    43,    24,    25,    26,    27,    28,    29,    -1,    -1,
+      32,    33,    -1,    35,    -1,    -1,    -1,    19,    20,    21,
+      22,    43,    24,    25,    26,    27,    28,    29,    -1,    -1,
+      32,    33,    -1,    -1,    -1,    -1,    38,    19,    20,    21,
+      22,    43,    24,    25,    26,    27,    28,    29,    -1,    -1,
+      32,    33,    -1,    -1,    -1,    -1,    38,    19,    20,    21,
+      22,    43,    24,    25,    26,    27,    28,    29,    -1,    -1,
+      32,    33,    -1,    -1,    -1,    -1,    38,    19,    20,    21,
+      22,    43,    24,    25,    26,    27,    28,    29,    -1,    -1,
+      32,    33,    -1,    -1,    -1,    -1,    -1,    19,    20,    21,
+      22,    43,    24,    25,    26,    27,    28,    29,    -1,    -1,
+      32,    -1,    -1,    -1,    -1,    -1,    -1,    19,    20,    21,
+      22,    43,    24,    25,    26,    27,    28,    29,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    43
+};
+
+/* YYSTOS[STATE-NUM] -- The symbol kind of the accessing symbol of
+   state STATE-NUM.  */
+static const yytype_int8 yystos[] =
+{
+       0,    49,    50,     0,     6,    15,    51,    52,    53,    56,
+       3,    54,    55,    23,    39,    57,    35,    36,     3,     4,
+      18,    20,    30,    31,    34,    37,    77,    78,    80,    81,
+       4,    37,     3,    55,    79,    82,    37,    77,     3,    78,
+      78,    77,     1,    77,    19,    20,    21,    22,    24,    25,
+      26,    27,    28,    29,    32,    33,    43,    23,    30,    31,
+      40,    15,    53,    58,    59,    60,    39,    37,     1,    78,
+      38,    38,    77,    77,    77,    77,    77,    77,    77,    77,
+      77,    77,    77,    77,    77,    77,     3,    38,    36,    77,
+       1,    77,    83,    84,    38,    38,    39,    41,    61,    60,
+      40,    38,    36,    40,    62,    77,    52,    53,    63,     1,
+       7,     9,    10,    11,    12,    13,    14,    16,    17,    35,
+      42,    61,    64,    65,    66,    67,    68,    69,    71,    72,
+      73,    75,    76,    77,    35,    37,    64,    37,     1,    35,
+      77,    35,    35,    37,     1,    78,     1,     5,    77,    35,
+       1,    77,    10,     1,    77,    35,    35,     1,    70,    77,
+      35,    35,    35,    74,    35,    38,    38,    37,    38,    38,
+      38,    35,    35,    64,    64,     1,    77,    64,    64,     1,
+      70,     8,     8,    38,    38,    35,    64,    64,    35,    35,
+      70,    38,    64
+};
+
+/* YYR1[RULE-NUM] -- Symbol kind of the left-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr1[] =
+{
+       0,    48,    49,    50,    50,    51,    51,    52,    53,    53,
+      54,    54,    55,    55,    55,    57,    56,    58,    58,    58,
+      59,    59,    60,    60,    61,    62,    62,    63,    63,    64,
+      64,    64,    64,    64,    64,    64,    64,    64,    64,    64,
+      65,    65,    65,    66,    66,    66,    66,    67,    67,    68,
+      68,    69,    69,    70,    70,    71,    71,    71,    72,    72,
+      73,    74,    73,    73,    75,    76,    77,    77,    78,    79,
+      78,    80,    80,    80,    80,    80,    80,    80,    80,    80,
+      80,    80,    80,    80,    80,    80,    80,    80,    80,    80,
+      80,    80,    80,    80,    80,    80,    80,    82,    81,    83,
+      83,    84,    84,    84
+};
+
+/* YYR2[RULE-NUM] -- Number of symbols on the right-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr2[] =
+{
+       0,     2,     1,     2,     0,     1,     1,     3,     1,     1,
+       3,     1,     1,     3,     4,     0,     7,     1,     1,     0,
+       3,     1,     2,     4,     4,     2,     0,     2,     0,     1,
+       1,     1,     1,     1,     1,     1,     1,     1,     1,     1,
+       2,     1,     2,     5,     7,     5,     7,     5,     5,     7,
+       7,     9,     5,     1,     0,     2,     3,     3,     3,     3,
+       3,     0,     4,     3,     2,     2,     3,     1,     1,     0,
+       5,     3,     3,     3,     3,     3,     3,     3,     3,     3,
+       3,     3,     3,     3,     2,     2,     1,     2,     2,     2,
+       2,     1,     3,     1,     4,     4,     3,     0,     5,     1,
+       0,     3,     1,     1
+};
+
+
+enum { YYENOMEM = -2 };
+
+#define yyerrok         (yyerrstatus = 0)
+#define yyclearin       (yychar = YYEMPTY)
+
+#define YYACCEPT        goto yyacceptlab
+#define YYABORT         goto yyabortlab
+#define YYERROR         goto yyerrorlab
+#define YYNOMEM         goto yyexhaustedlab
+
+
+#define YYRECOVERING()  (!!yyerrstatus)
+
+#define YYBACKUP(Token, Value)                                    \
+  do                                                              \
+    if (yychar == YYEMPTY)                                        \
+      {                                                           \
+        yychar = (Token);                                         \
+        yylval = (Value);                                         \
+        YYPOPSTACK (yylen);                                       \
+        yystate = *yyssp;                                         \
+        goto yybackup;                                            \
+      }                                                           \
+    else                                                          \
+      {                                                           \
+        yyerror (YY_("syntax error: cannot back up")); \
+        YYERROR;                                                  \
+      }                                                           \
+  while (0)
+
+/* Backward compatibility with an undocumented macro.
+   Use YYerror or YYUNDEF. */
+#define YYERRCODE YYUNDEF
+
+
+/* Enable debugging if requested.  */
+#if YYDEBUG
+
+# ifndef YYFPRINTF
+#  include <stdio.h> /* INFRINGES ON USER NAME SPACE */
+#  define YYFPRINTF fprintf
+# endif
+
+# define YYDPRINTF(Args)                        \
+do {                                            \
+  if (yydebug)                                  \
+    YYFPRINTF Args;                             \
+} while (0)
+
+
+
+
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)                    \
+do {                                                                      \
+  if (yydebug)                                                            \
+    {                                                                     \
+      YYFPRINTF (stderr, "%s ", Title);                                   \
+      yy_symbol_print (stderr,                                            \
+                  Kind, Value); \
+      YYFPRINTF (stderr, "\n");                                           \
+    }                                                                     \
+} while (0)
+
+
+/*-----------------------------------.
+| Print this symbol's value on YYO.  |
+`-----------------------------------*/
+
+static void
+yy_symbol_value_print (FILE *yyo,
+                       yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep)
+{
+  FILE *yyoutput = yyo;
+  YY_USE (yyoutput);
+  if (!yyvaluep)
+    return;
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+}
+
+
+/*---------------------------.
+| Print this symbol on YYO.  |
+`---------------------------*/
+
+static void
+yy_symbol_print (FILE *yyo,
+                 yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep)
+{
+  YYFPRINTF (yyo, "%s %s (",
+             yykind < YYNTOKENS ? "token" : "nterm", yysymbol_name (yykind));
+
+  yy_symbol_value_print (yyo, yykind, yyvaluep);
+  YYFPRINTF (yyo, ")");
+}
+
+/*------------------------------------------------------------------.
+| yy_stack_print -- Print the state stack from its BOTTOM up to its |
+| TOP (included).                                                   |
+`------------------------------------------------------------------*/
+
+static void
+yy_stack_print (yy_state_t *yybottom, yy_state_t *yytop)
+{
+  YYFPRINTF (stderr, "Stack now");
+  for (; yybottom <= yytop; yybottom++)
+    {
+      int yybot = *yybottom;
+      YYFPRINTF (stderr, " %d", yybot);
+    }
+  YYFPRINTF (stderr, "\n");
+}
+
+# define YY_STACK_PRINT(Bottom, Top)                            \
+do {                                                            \
+  if (yydebug)                                                  \
+    yy_stack_print ((Bottom), (Top));                           \
+} while (0)
+
+
+/*------------------------------------------------.
+| Report that the YYRULE is going to be reduced.  |
+`------------------------------------------------*/
+
+static void
+yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp,
+                 int yyrule)
+{
+  int yylno = yyrline[yyrule];
+  int yynrhs = yyr2[yyrule];
+  int yyi;
+  YYFPRINTF (stderr, "Reducing stack by rule %d (line %d):\n",
+             yyrule - 1, yylno);
+  /* The symbols being reduced.  */
+  for (yyi = 0; yyi < yynrhs; yyi++)
+    {
+      YYFPRINTF (stderr, "   $%d = ", yyi + 1);
+      yy_symbol_print (stderr,
+                       YY_ACCESSING_SYMBOL (+yyssp[yyi + 1 - yynrhs]),
+                       &yyvsp[(yyi + 1) - (yynrhs)]);
+      YYFPRINTF (stderr, "\n");
+    }
+}
+
+# define YY_REDUCE_PRINT(Rule)          \
+do {                                    \
+  if (yydebug)                          \
+    yy_reduce_print (yyssp, yyvsp, Rule); \
+} while (0)
+
+/* Nonzero means print parse trace.  It is left uninitialized so that
+   multiple parsers can coexist.  */
+int yydebug;
+#else /* !YYDEBUG */
+# define YYDPRINTF(Args) ((void) 0)
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)
+# define YY_STACK_PRINT(Bottom, Top)
+# define YY_REDUCE_PRINT(Rule)
+#endif /* !YYDEBUG */
+
+
+/* YYINITDEPTH -- initial size of the parser's stacks.  */
+#ifndef YYINITDEPTH
+# define YYINITDEPTH 200
+#endif
+
+/* YYMAXDEPTH -- maximum size the stacks can grow to (effective only
+   if the built-in stack extension method is used).
+
+   Do not make this value too large; the results are undefined if
+   YYSTACK_ALLOC_MAXIMUM < YYSTACK_BYTES (YYMAXDEPTH)
+   evaluated with infinite-precision integer arithmetic.  */
+
+#ifndef YYMAXDEPTH
+# define YYMAXDEPTH 10000
+#endif
+
+
+/* Context of a parse error.  */
+typedef struct
+{
+  yy_state_t *yyssp;
+  yysymbol_kind_t yytoken;
+} yypcontext_t;
+
+/* Put in YYARG at most YYARGN of the expected tokens given the
+   current YYCTX, and return the number of tokens stored in YYARG.  If
+   YYARG is null, return the number of expected tokens (guaranteed to
+   be less than YYNTOKENS).  Return YYENOMEM on memory exhaustion.
+   Return 0 if there are more than YYARGN expected tokens, yet fill
+   YYARG up to YYARGN. */
+static int
+yypcontext_expected_tokens (const yypcontext_t *yyctx,
+                            yysymbol_kind_t yyarg[], int yyargn)
+{
+  /* Actual size of YYARG. */
+  int yycount = 0;
+  int yyn = yypact[+*yyctx->yyssp];
+  if (!yypact_value_is_default (yyn))
+    {
+      /* Start YYX at -YYN if negative to avoid negative indexes in
+         YYCHECK.  In other words, skip the first -YYN actions for
+         this state because they are default actions.  */
+      int yyxbegin = yyn < 0 ? -yyn : 0;
+      /* Stay within bounds of both yycheck and yytname.  */
+      int yychecklim = YYLAST - yyn + 1;
+      int yyxend = yychecklim < YYNTOKENS ? yychecklim : YYNTOKENS;
+      int yyx;
+      for (yyx = yyxbegin; yyx < yyxend; ++yyx)
+        if (yycheck[yyx + yyn] == yyx && yyx != YYSYMBOL_YYerror
+            && !yytable_value_is_error (yytable[yyx + yyn]))
+          {
+            if (!yyarg)
+              ++yycount;
+            else if (yycount == yyargn)
+              return 0;
+            else
+              yyarg[yycount++] = YY_CAST (yysymbol_kind_t, yyx);
+          }
+    }
+  if (yyarg && yycount == 0 && 0 < yyargn)
+    yyarg[0] = YYSYMBOL_YYEMPTY;
+  return yycount;
+}
+
+
+
+
+#ifndef yystrlen
+# if defined __GLIBC__ && defined _STRING_H
+#  define yystrlen(S) (YY_CAST (YYPTRDIFF_T, strlen (S)))
+# else
+/* Return the length of YYSTR.  */
+static YYPTRDIFF_T
+yystrlen (const char *yystr)
+{
+  YYPTRDIFF_T yylen;
+  for (yylen = 0; yystr[yylen]; yylen++)
+    continue;
+  return yylen;
+}
+# endif
+#endif
+
+#ifndef yystpcpy
+# if defined __GLIBC__ && defined _STRING_H && defined _GNU_SOURCE
+#  define yystpcpy stpcpy
+# else
+/* Copy YYSRC to YYDEST, returning the address of the terminating '\0' in
+   YYDEST.  */
+static char *
+yystpcpy (char *yydest, const char *yysrc)
+{
+  char *yyd = yydest;
+  const char *yys = yysrc;
+
+  while ((*yyd++ = *yys++) != '\0')
+    continue;
+
+  return yyd - 1;
+}
+# endif
+#endif
+
+#ifndef yytnamerr
+/* Copy to YYRES the contents of YYSTR after stripping away unnecessary
+   quotes and backslashes, so that it's suitable for yyerror.  The
+   heuristic is that double-quoting is unnecessary unless the string
+   contains an apostrophe, a comma, or backslash (other than
+   backslash-backslash).  YYSTR is taken from yytname.  If YYRES is
+   null, do not copy; instead, return the length of what the result
+   would have been.  */
+static YYPTRDIFF_T
+yytnamerr (char *yyres, const char *yystr)
+{
+  if (*yystr == '"')
+    {
+      YYPTRDIFF_T yyn = 0;
+      char const *yyp = yystr;
+      for (;;)
+        switch (*++yyp)
+          {
+          case '\'':
+          case ',':
+            goto do_not_strip_quotes;
+
+          case '\\':
+            if (*++yyp != '\\')
+              goto do_not_strip_quotes;
+            else
+              goto append;
+
+          append:
+          default:
+            if (yyres)
+              yyres[yyn] = *yyp;
+            yyn++;
+            break;
+
+          case '"':
+            if (yyres)
+              yyres[yyn] = '\0';
+            return yyn;
+          }
+    do_not_strip_quotes: ;
+    }
+
+  if (yyres)
+    return yystpcpy (yyres, yystr) - yyres;
+  else
+    return yystrlen (yystr);
+}
+#endif
+
+
+static int
+yy_syntax_error_arguments (const yypcontext_t *yyctx,
+                           yysymbol_kind_t yyarg[], int yyargn)
+{
+  /* Actual size of YYARG. */
+  int yycount = 0;
+  /* There are many possibilities here to consider:
+     - If this state is a consistent state with a default action, then
+       the only way this function was invoked is if the default action
+       is an error action.  In that case, don't check for expected
+       tokens because there are none.
+     - The only way there can be no lookahead present (in yychar) is if
+       this state is a consistent state with a default action.  Thus,
+       detecting the absence of a lookahead is sufficient to determine
+       that there is no unexpected or expected token to report.  In that
+       case, just report a simple "syntax error".
+     - Don't assume there isn't a lookahead just because this state is a
+       consistent state with a default action.  There might have been a
+       previous inconsistent state, consistent state with a non-default
+       action, or user semantic action that manipulated yychar.
+     - Of course, the expected token list depends on states to have
+       correct lookahead information, and it depends on the parser not
+       to perform extra reductions after fetching a lookahead from the
+       scanner and before detecting a syntax error.  Thus, state merging
+       (from LALR or IELR) and default reductions corrupt the expected
+       token list.  However, the list is correct for canonical LR with
+       one exception: it will still contain any token that will not be
+       accepted due to an error action in a later state.
+  */
+  if (yyctx->yytoken != YYSYMBOL_YYEMPTY)
+    {
+      int yyn;
+      if (yyarg)
+        yyarg[yycount] = yyctx->yytoken;
+      ++yycount;
+      yyn = yypcontext_expected_tokens (yyctx,
+                                        yyarg ? yyarg + 1 : yyarg, yyargn - 1);
+      if (yyn == YYENOMEM)
+        return YYENOMEM;
+      else
+        yycount += yyn;
+    }
+  return yycount;
+}
+
+/* Copy into *YYMSG, which is of size *YYMSG_ALLOC, an error message
+   about the unexpected token YYTOKEN for the state stack whose top is
+   YYSSP.
+
+   Return 0 if *YYMSG was successfully written.  Return -1 if *YYMSG is
+   not large enough to hold the message.  In that case, also set
+   *YYMSG_ALLOC to the required number of bytes.  Return YYENOMEM if the
+   required number of bytes is too large to store.  */
+static int
+yysyntax_error (YYPTRDIFF_T *yymsg_alloc, char **yymsg,
+                const yypcontext_t *yyctx)
+{
+  enum { YYARGS_MAX = 5 };
+  /* Internationalized format string. */
+  const char *yyformat = YY_NULLPTR;
+  /* Arguments of yyformat: reported tokens (one for the "unexpected",
+     one per "expected"). */
+  yysymbol_kind_t yyarg[YYARGS_MAX];
+  /* Cumulated lengths of YYARG.  */
+  YYPTRDIFF_T yysize = 0;
+
+  /* Actual size of YYARG. */
+  int yycount = yy_syntax_error_arguments (yyctx, yyarg, YYARGS_MAX);
+  if (yycount == YYENOMEM)
+    return YYENOMEM;
+
+  switch (yycount)
+    {
+#define YYCASE_(N, S)                       \
+      case N:                               \
+        yyformat = S;                       \
+        break
+    default: /* Avoid compiler warnings. */
+      YYCASE_(0, YY_("syntax error"));
+      YYCASE_(1, YY_("syntax error, unexpected %s"));
+      YYCASE_(2, YY_("syntax error, unexpected %s, expecting %s"));
+      YYCASE_(3, YY_("syntax error, unexpected %s, expecting %s or %s"));
+      YYCASE_(4, YY_("syntax error, unexpected %s, expecting %s or %s or %s"));
+      YYCASE_(5, YY_("syntax error, unexpected %s, expecting %s or %s or %s or %s"));
+#undef YYCASE_
+    }
+
+  /* Compute error message size.  Don't count the "%s"s, but reserve
+     room for the terminator.  */
+  yysize = yystrlen (yyformat) - 2 * yycount + 1;
+  {
+    int yyi;
+    for (yyi = 0; yyi < yycount; ++yyi)
+      {
+        YYPTRDIFF_T yysize1
+          = yysize + yytnamerr (YY_NULLPTR, yytname[yyarg[yyi]]);
+        if (yysize <= yysize1 && yysize1 <= YYSTACK_ALLOC_MAXIMUM)
+          yysize = yysize1;
+        else
+          return YYENOMEM;
+      }
+  }
+
+  if (*yymsg_alloc < yysize)
+    {
+      *yymsg_alloc = 2 * yysize;
+      if (! (yysize <= *yymsg_alloc
+             && *yymsg_alloc <= YYSTACK_ALLOC_MAXIMUM))
+        *yymsg_alloc = YYSTACK_ALLOC_MAXIMUM;
+      return -1;
+    }
+
+  /* Avoid sprintf, as that infringes on the user's name space.
+     Don't have undefined behavior even if the translation
+     produced a string with the wrong number of "%s"s.  */
+  {
+    char *yyp = *yymsg;
+    int yyi = 0;
+    while ((*yyp = *yyformat) != '\0')
+      if (*yyp == '%' && yyformat[1] == 's' && yyi < yycount)
+        {
+          yyp += yytnamerr (yyp, yytname[yyarg[yyi++]]);
+          yyformat += 2;
+        }
+      else
+        {
+          ++yyp;
+          ++yyformat;
+        }
+  }
+  return 0;
+}
+
+
+/*-----------------------------------------------.
+| Release the memory associated to this symbol.  |
+`-----------------------------------------------*/
+
+static void
+yydestruct (const char *yymsg,
+            yysymbol_kind_t yykind, YYSTYPE *yyvaluep)
+{
+  YY_USE (yyvaluep);
+  if (!yymsg)
+    yymsg = "Deleting";
+  YY_SYMBOL_PRINT (yymsg, yykind, yyvaluep, yylocationp);
+
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+}
+
+
+/* Lookahead token kind.  */
+int yychar;
+
+/* The semantic value of the lookahead symbol.  */
+YYSTYPE yylval;
+/* Number of syntax errors so far.  */
+int yynerrs;
+
+
+
+
+/*----------.
+| yyparse.  |
+`----------*/
+
+int
+yyparse (void)
+{
+    yy_state_fast_t yystate = 0;
+    /* Number of tokens to shift before error messages enabled.  */
+    int yyerrstatus = 0;
+
+    /* Refer to the stacks through separate pointers, to allow yyoverflow
+       to reallocate them elsewhere.  */
+
+    /* Their size.  */
+    YYPTRDIFF_T yystacksize = YYINITDEPTH;
+
+    /* The state stack: array, bottom, top.  */
+    yy_state_t yyssa[YYINITDEPTH];
+    yy_state_t *yyss = yyssa;
+    yy_state_t *yyssp = yyss;
+
+    /* The semantic value stack: array, bottom, top.  */
+    YYSTYPE yyvsa[YYINITDEPTH];
+    YYSTYPE *yyvs = yyvsa;
+    YYSTYPE *yyvsp = yyvs;
+
+  int yyn;
+  /* The return value of yyparse.  */
+  int yyresult;
+  /* Lookahead symbol kind.  */
+  yysymbol_kind_t yytoken = YYSYMBOL_YYEMPTY;
+  /* The variables used to return semantic value and location from the
+     action routines.  */
+  YYSTYPE yyval;
+
+  /* Buffer for error messages, and its allocated size.  */
+  char yymsgbuf[128];
+  char *yymsg = yymsgbuf;
+  YYPTRDIFF_T yymsg_alloc = sizeof yymsgbuf;
+
+#define YYPOPSTACK(N)   (yyvsp -= (N), yyssp -= (N))
+
+  /* The number of symbols on the RHS of the reduced rule.
+     Keep to zero when no symbol should be popped.  */
+  int yylen = 0;
+
+  YYDPRINTF ((stderr, "Starting parse\n"));
+
+  yychar = YYEMPTY; /* Cause a token to be read.  */
+
+  goto yysetstate;
+
+
+/*------------------------------------------------------------.
+| yynewstate -- push a new state, which is found in yystate.  |
+`------------------------------------------------------------*/
+yynewstate:
+  /* In all cases, when you get here, the value and location stacks
+     have just been pushed.  So pushing a state here evens the stacks.  */
+  yyssp++;
+
+
+/*--------------------------------------------------------------------.
+| yysetstate -- set current state (the top of the stack) to yystate.  |
+`--------------------------------------------------------------------*/
+yysetstate:
+  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
+  YY_ASSERT (0 <= yystate && yystate < YYNSTATES);
+  YY_IGNORE_USELESS_CAST_BEGIN
+  *yyssp = YY_CAST (yy_state_t, yystate);
+  YY_IGNORE_USELESS_CAST_END
+  YY_STACK_PRINT (yyss, yyssp);
+
+  if (yyss + yystacksize - 1 <= yyssp)
+#if !defined yyoverflow && !defined YYSTACK_RELOCATE
+    YYNOMEM;
+#else
+    {
+      /* Get the current used size of the three stacks, in elements.  */
+      YYPTRDIFF_T yysize = yyssp - yyss + 1;
+
+# if defined yyoverflow
+      {
+        /* Give user a chance to reallocate the stack.  Use copies of
+           these so that the &'s don't force the real ones into
+           memory.  */
+        yy_state_t *yyss1 = yyss;
+        YYSTYPE *yyvs1 = yyvs;
+
+        /* Each stack pointer address is followed by the size of the
+           data in use in that stack, in bytes.  This used to be a
+           conditional around just the two extra args, but that might
+           be undefined if yyoverflow is a macro.  */
+        yyoverflow (YY_("memory exhausted"),
+                    &yyss1, yysize * YYSIZEOF (*yyssp),
+                    &yyvs1, yysize * YYSIZEOF (*yyvsp),
+                    &yystacksize);
+        yyss = yyss1;
+        yyvs = yyvs1;
+      }
+# else /* defined YYSTACK_RELOCATE */
+      /* Extend the stack our own way.  */
+      if (YYMAXDEPTH <= yystacksize)
+        YYNOMEM;
+      yystacksize *= 2;
+      if (YYMAXDEPTH < yystacksize)
+        yystacksize = YYMAXDEPTH;
+
+      {
+        yy_state_t *yyss1 = yyss;
+        union yyalloc *yyptr =
+          YY_CAST (union yyalloc *,
+                   YYSTACK_ALLOC (YY_CAST (YYSIZE_T, YYSTACK_BYTES (yystacksize))));
+        if (! yyptr)
+          YYNOMEM;
+        YYSTACK_RELOCATE (yyss_alloc, yyss);
+        YYSTACK_RELOCATE (yyvs_alloc, yyvs);
+#  undef YYSTACK_RELOCATE
+        if (yyss1 != yyssa)
+          YYSTACK_FREE (yyss1);
+      }
+# endif
+
+      yyssp = yyss + yysize - 1;
+      yyvsp = yyvs + yysize - 1;
+
+      YY_IGNORE_USELESS_CAST_BEGIN
+      YYDPRINTF ((stderr, "Stack size increased to %ld\n",
+                  YY_CAST (long, yystacksize)));
+      YY_IGNORE_USELESS_CAST_END
+
+      if (yyss + yystacksize - 1 <= yyssp)
+        YYABORT;
+    }
+#endif /* !defined yyoverflow && !defined YYSTACK_RELOCATE */
+
+
+  if (yystate == YYFINAL)
+    YYACCEPT;
+
+  goto yybackup;
+
+
+/*-----------.
+| yybackup.  |
+`-----------*/
+yybackup:
+  /* Do appropriate processing given the current state.  Read a
+     lookahead token if we need one and don't already have one.  */
+
+  /* First try to decide what to do without reference to lookahead token.  */
+  yyn = yypact[yystate];
+  if (yypact_value_is_default (yyn))
+    goto yydefault;
+
+  /* Not known => get a lookahead token if don't already have one.  */
+
+  /* YYCHAR is either empty, or end-of-input, or a valid lookahead.  */
+  if (yychar == YYEMPTY)
+    {
+      YYDPRINTF ((stderr, "Reading a token\n"));
+      yychar = yylex ();
+    }
+
+  if (yychar <= YYEOF)
+    {
+      yychar = YYEOF;
+      yytoken = YYSYMBOL_YYEOF;
+      YYDPRINTF ((stderr, "Now at end of input.\n"));
+    }
+  else if (yychar == YYerror)
+    {
+      /* The scanner already issued an error message, process directly
+         to error recovery.  But do not keep the error token as
+         lookahead, it is too special and may lead us to an endless
+         loop in error recovery. */
+      yychar = YYUNDEF;
+      yytoken = YYSYMBOL_YYerror;
+      goto yyerrlab1;
+    }
+  else
+    {
+      yytoken = YYTRANSLATE (yychar);
+      YY_SYMBOL_PRINT ("Next token is", yytoken, &yylval, &yylloc);
+    }
+
+  /* If the proper action on seeing token YYTOKEN is to reduce or to
+     detect an error, take that action.  */
+  yyn += yytoken;
+  if (yyn < 0 || YYLAST < yyn || yycheck[yyn] != yytoken)
+    goto yydefault;
+  yyn = yytable[yyn];
+  if (yyn <= 0)
+    {
+      if (yytable_value_is_error (yyn))
+        goto yyerrlab;
+      yyn = -yyn;
+      goto yyreduce;
+    }
+
+  /* Count tokens shifted since error; after three, turn off error
+     status.  */
+  if (yyerrstatus)
+    yyerrstatus--;
+
+  /* Shift the lookahead token.  */
+  YY_SYMBOL_PRINT ("Shifting", yytoken, &yylval, &yylloc);
+  yystate = yyn;
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  *++yyvsp = yylval;
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+
+  /* Discard the shifted token.  */
+  yychar = YYEMPTY;
+  goto yynewstate;
+
+
+/*-----------------------------------------------------------.
+| yydefault -- do the default action for the current state.  |
+`-----------------------------------------------------------*/
+yydefault:
+  yyn = yydefact[yystate];
+  if (yyn == 0)
+    goto yyerrlab;
+  goto yyreduce;
+
+
+/*-----------------------------.
+| yyreduce -- do a reduction.  |
+`-----------------------------*/
+yyreduce:
+  /* yyn is the number of a rule to reduce with.  */
+  yylen = yyr2[yyn];
+
+  /* If YYLEN is nonzero, implement the default value of the action:
+     '$$ = $1'.
+
+     Otherwise, the following line sets YYVAL to garbage.
+     This behavior is undocumented and Bison
+     users should not rely upon it.  Assigning to YYVAL
+     unconditionally makes the parser a bit smaller, and it avoids a
+     GCC warning that YYVAL may be used uninitialized.  */
+  yyval = yyvsp[1-yylen];
+
+
+  YY_REDUCE_PRINT (yyn);
+  switch (yyn)
+    {
+  case 2: /* program: declaration_list  */
+#line 71 "parser.y"
+                           {
+	ast_node t = create_ast_node(ROOT_N);
+	t->left_child = yyvsp[0];
+	root = yyval = t; }
+#line 1651 "parser.tab.c"
+    break;
+
+  case 3: /* declaration_list: declaration_list declaration  */
+#line 82 "parser.y"
+                                                {
+	ast_node t = yyvsp[-1];
+	if (t != NULL) {
+		while (t->right_sibling != NULL)
+			t = t->right_sibling;
+		t->right_sibling = yyvsp[0];
+		yyval = yyvsp[-1];
+	} 
+	else
+		yyval = yyvsp[0];
+	}
+#line 1667 "parser.tab.c"
+    break;
+
+  case 4: /* declaration_list: %empty  */
+#line 93 "parser.y"
+              { yyval = NULL; }
+#line 1673 "parser.tab.c"
+    break;
+
+  case 5: /* declaration: var_declaration  */
+#line 101 "parser.y"
+                                { yyval = yyvsp[0]; }
+#line 1679 "parser.tab.c"
+    break;
+
+  case 6: /* declaration: func_declaration  */
+#line 102 "parser.y"
+                                                { yyval = yyvsp[0]; }
+#line 1685 "parser.tab.c"
+    break;
+
+  case 7: /* var_declaration: type_specifier var_declaration_list ';'  */
+#line 110 "parser.y"
+                                                          {
+	ast_node t = create_ast_node(VAR_DECLARATION_N);
+	t->left_child = yyvsp[-2];
+	t->left_child->right_sibling = yyvsp[-1]; 
+	yyval = t; }
+#line 1695 "parser.tab.c"
+    break;
+
+  case 8: /* type_specifier: TYPEINT_T  */
+#line 122 "parser.y"
+                           {
+	ast_node t = create_ast_node(TYPE_SPEC_N);
+	ast_node int_n = create_ast_node(TYPEINT_N);
+	t->left_child = int_n;
+	yyval = t; }
+#line 1705 "parser.tab.c"
+    break;
+
+  case 9: /* type_specifier: VOID_T  */
+#line 127 "parser.y"
+         {	
+	ast_node t = create_ast_node(TYPE_SPEC_N);
+	ast_node void_n = create_ast_node(VOID_N);
+	t->left_child = void_n;
+	yyval = t; }
+#line 1715 "parser.tab.c"
+    break;
+
+  case 10: /* var_declaration_list: var_declaration_list ',' var_decl  */
+#line 139 "parser.y"
+                                                         {
+	ast_node t = yyvsp[-2];
+	if (t != NULL) {
+		while (t->right_sibling != NULL)
+			t = t->right_sibling;
+		t->right_sibling = yyvsp[0];
+		yyval = yyvsp[-2];
+	}
+	else 
+		yyval = yyvsp[0];
+	}
+#line 1731 "parser.tab.c"
+    break;
+
+  case 11: /* var_declaration_list: var_decl  */
+#line 150 "parser.y"
+           { yyval = yyvsp[0]; }
+#line 1737 "parser.tab.c"
+    break;
+
+  case 12: /* var_decl: ID_T  */
+#line 160 "parser.y"
+                {
+	ast_node t = create_ast_node(VAR_DECL_N);
+	ast_node id_n = create_ast_node(ID_N);
+	id_n->value_string = intern(compile_strings, savedIdText);
+	t->left_child = id_n;
+	yyval = t; }
+#line 1748 "parser.tab.c"
+    break;
+
+  case 13: /* var_decl: ID_T '=' expression  */
+#line 166 "parser.y"
+                      {
+	ast_node t = create_ast_node(VAR_DECL_N);
+	ast_node id_n = create_ast_node(ID_N);
+	id_n->value_string = intern(compile_strings, savedIdText);
+	t->left_child = id_n;
+	t->left_child->right_sibling = yyvsp[0];
+	yyval = t; }
+#line 1760 "parser.tab.c"
+    break;
+
+  case 14: /* var_decl: ID_T '[' INT_T ']'  */
+#line 173 "parser.y"
+                     {
+	ast_node t = create_ast_node(VAR_DECL_N);
+	ast_node id_n = create_ast_node(ID_N);
+	ast_node int_n = create_ast_node(INT_LITERAL_N);
+	id_n->value_string = intern(compile_strings, savedIdText);
+	int_n->value_int = atoi(savedLiteralText);
+ 	t->left_child = id_n;
+	t->left_child->right_sibling = int_n;
+	yyval = t; }
+#line 1774 "parser.tab.c"
+    break;
+
+  case 15: /* $@1: %empty  */
+#line 190 "parser.y"
+                                       {
+	/* embedded action to save function identifer */
+	ast_node id_n = create_ast_node(ID_N);
+	id_n->value_string = intern(compile_strings, savedIdText); 
+	yyvsp[0] = id_n;
+}
+#line 1785 "parser.tab.c"
+    break;
+
+  case 16: /* func_declaration: type_specifier ID_T $@1 '(' formal_params ')' compound_stmt  */
+#line 195 "parser.y"
+                                      {
+	ast_node t = create_ast_node(FUNC_DECLARATION_N);
+	ast_node child;
+
+	t->left_child = yyvsp[-6];
+	t->left_child->right_sibling = yyvsp[-5];
+	t->left_child->right_sibling->right_sibling = yyvsp[-2];
+	t->left_child->right_sibling->right_sibling->right_sibling = yyvsp[0];
+	yyval = t; }
+#line 1799 "parser.tab.c"
+    break;
+
+  case 17: /* formal_params: formal_list  */
+#line 213 "parser.y"
+                            {
+	ast_node t = create_ast_node(FORMAL_PARAMS_N);
+	t->left_child = yyvsp[0]; 
+	yyval = t; }
+#line 1808 "parser.tab.c"
+    break;
+
+  case 18: /* formal_params: VOID_T  */
+#line 217 "parser.y"
+         {
+	ast_node t = create_ast_node(FORMAL_PARAMS_N);
+	ast_node void_node = create_ast_node(VOID_N);
+	t->left_child = void_node; 
+	yyval = t; }
+#line 1818 "parser.tab.c"
+    break;
+
+  case 19: /* formal_params: %empty  */
+#line 222 "parser.y"
+              {   											// can't just return null because above productions depend on this right sibling
+	ast_node t = create_ast_node(FORMAL_PARAMS_N);
+	ast_node void_node = create_ast_node(VOID_N);
+	t->left_child = void_node; 
+	yyval = t;  
+	}
+#line 1829 "parser.tab.c"
+    break;
+
+  case 20: /* formal_list: formal_list ',' formal_param  */
+#line 235 "parser.y"
+                                           {
+	ast_node t = yyvsp[-2];
+	if (t != NULL) {
+		while (t->right_sibling)
+			t = t->right_sibling;
+		t->right_sibling = yyvsp[0];
+		yyval = yyvsp[-2];
+	}
+	else 
+		yyval = yyvsp[0];
+	}
+#line 1845 "parser.tab.c"
+    break;
+
+  case 21: /* formal_list: formal_param  */
+#line 246 "parser.y"
+               { yyval = yyvsp[0]; }
+#line 1851 "parser.tab.c"
+    break;
+
+  case 22: /* formal_param: type_specifier ID_T  */
+#line 255 "parser.y"
+                                   {
+	ast_node t = create_ast_node(FORMAL_PARAM_N);			// save ID string in ID_N at right_sibling
+	ast_node id_n = create_ast_node(ID_N);
+	id_n->value_string = intern(compile_strings, savedIdText);
+	t->left_child = yyvsp[-1];
+	t->left_child->right_sibling = id_n;
+	yyval = t; }
+#line 1863 "parser.tab.c"
+    break;
+
+  case 23: /* formal_param: type_specifier ID_T '[' ']'  */
+#line 262 "parser.y"
+                              {
+	ast_node t = create_ast_node(FORMAL_PARAM_ARR_N);		// save ID string in ID_N at right_sibling
+	ast_node id_n = create_ast_node(ID_N);
+	id_n->value_string = intern(compile_strings, savedIdText);
+	t->left_child = yyvsp[-3];
+	t->left_child->right_sibling = id_n;
+	yyval = t; }
+#line 1875 "parser.tab.c"
+    break;
+
+  case 24: /* compound_stmt: '{' local_declarations stmt_list '}'  */
+#line 279 "parser.y"
+                                                     {
+	ast_node t = create_ast_node(COMPOUND_STMT_N);
+	ast_node d = yyvsp[-2];
+	ast_node l;
+
+	if (d != NULL) {
+		t->left_child = d;
+
+		/* get to end of declaration list */
+		l = d;
+		while (l->right_sibling != NULL) {
+			l = l->right_sibling;
+		}
+
+		l->right_sibling = yyvsp[-1];
+
+	} else {
+		t->left_child = yyvsp[-1];
+	}
+
+	yyval = t;
+
+	}
+#line 1903 "parser.tab.c"
+    break;
+
+  case 25: /* local_declarations: local_declarations var_declaration  */
+#line 310 "parser.y"
+                                                        {
+	ast_node t = yyvsp[-1];
+	if (t != NULL) {
+		while (t->right_sibling != NULL)
+			t = t->right_sibling;
+		t->right_sibling = yyvsp[0];
+		yyval = yyvsp[-1];
+	} 
+	else
+		yyval = yyvsp[0];
+
+	}
+#line 1920 "parser.tab.c"
+    break;
+
+  case 26: /* local_declarations: %empty  */
+#line 322 "parser.y"
+              { yyval = NULL; }
+#line 1926 "parser.tab.c"
+    break;
+
+  case 27: /* stmt_list: stmt_list stmt  */
+#line 332 "parser.y"
+                           {
+	ast_node t = yyvsp[-1];
+	if (t != NULL) {
+		while (t->right_sibling != NULL)
+			t = t->right_sibling;
+		t->right_sibling = yyvsp[0];
+		yyval = yyvsp[-1];
+	} else
+		yyval = yyvsp[0];
+
+	}
+#line 1942 "parser.tab.c"
+    break;
+
+  case 28: /* stmt_list: %empty  */
+#line 343 "parser.y"
+              { yyval = NULL; }
+#line 1948 "parser.tab.c"
+    break;
+
+  case 29: /* stmt: expression_stmt  */
+#line 352 "parser.y"
+                { yyval = yyvsp[0]; }
+#line 1954 "parser.tab.c"
+    break;
+
+  case 30: /* stmt: compound_stmt  */
+#line 353 "parser.y"
+                { yyval = yyvsp[0]; }
+#line 1960 "parser.tab.c"
+    break;
+
+  case 31: /* stmt: if_stmt  */
+#line 354 "parser.y"
+                        { yyval = yyvsp[0]; }
+#line 1966 "parser.tab.c"
+    break;
+
+  case 32: /* stmt: while_stmt  */
+#line 355 "parser.y"
+                { yyval = yyvsp[0]; }
+#line 1972 "parser.tab.c"
+    break;
+
+  case 33: /* stmt: do_while_stmt  */
+#line 356 "parser.y"
+                { yyval = yyvsp[0]; }
+#line 1978 "parser.tab.c"
+    break;
+
+  case 34: /* stmt: for_stmt  */
+#line 357 "parser.y"
+                        { yyval = yyvsp[0]; }
+#line 1984 "parser.tab.c"
+    break;
+
+  case 35: /* stmt: return_stmt  */
+#line 358 "parser.y"
+                { yyval = yyvsp[0]; }
+#line 1990 "parser.tab.c"
+    break;
+
+  case 36: /* stmt: read_stmt  */
+#line 359 "parser.y"
+                { yyval = yyvsp[0]; }
+#line 1996 "parser.tab.c"
+    break;
+
+  case 37: /* stmt: print_stmt  */
+#line 360 "parser.y"
+                { yyval = yyvsp[0]; }
+#line 2002 "parser.tab.c"
+    break;
+
+  case 38: /* stmt: break_stmt  */
+#line 361 "parser.y"
+             { yyval = yyvsp[0]; }
+#line 2008 "parser.tab.c"
+    break;
+
+  case 39: /* stmt: continue_stmt  */
+#line 362 "parser.y"
+                { yyval = yyvsp[0]; }
+#line 2014 "parser.tab.c"
+    break;
+
+  case 40: /* expression_stmt: expression ';'  */
+#line 370 "parser.y"
+                                 {
+	ast_node t = create_ast_node(EXPRESSION_STMT_N);
+	t->left_child = yyvsp[-1];
+	yyval = t; }
+#line 2023 "parser.tab.c"
+    break;
+
+  case 41: /* expression_stmt: ';'  */
+#line 374 "parser.y"
+                  {
+	ast_node t = create_ast_node(EXPRESSION_STMT_N);
+	yyval = t; }
+#line 2031 "parser.tab.c"
+    break;
+
+  case 42: /* expression_stmt: error ';'  */
+#line 377 "parser.y"
+            { yyval = NULL; }
+#line 2037 "parser.tab.c"
+    break;
+
+  case 43: /* if_stmt: IF_T '(' expression ')' stmt  */
+#line 386 "parser.y"
+                                                               {
+  ast_node t = create_ast_node(IF_STMT_N);
+  t->left_child = yyvsp[-2];
+  t->left_child->right_sibling = yyvsp[0];
+  yyval = t; }
+#line 2047 "parser.tab.c"
+    break;
+
+  case 44: /* if_stmt: IF_T '(' expression ')' stmt ELSE_T stmt  */
+#line 391 "parser.y"
+                                           {
+  ast_node t = create_ast_node(IF_ELSE_STMT_N);
+  t->left_child = yyvsp[-4];
+  t->left_child->right_sibling = yyvsp[-2];
+  t->left_child->right_sibling->right_sibling = yyvsp[0];
+  yyval = t; }
+#line 2058 "parser.tab.c"
+    break;
+
+  case 45: /* if_stmt: IF_T '(' error ')' stmt  */
+#line 398 "parser.y"
+        { yyval = NULL; }
+#line 2064 "parser.tab.c"
+    break;
+
+  case 46: /* if_stmt: IF_T '(' error ')' stmt ELSE_T stmt  */
+#line 400 "parser.y"
+        { yyval = NULL; }
+#line 2070 "parser.tab.c"
+    break;
+
+  case 47: /* while_stmt: WHILE_T '(' expression ')' stmt  */
+#line 406 "parser.y"
+                                             {
+	ast_node t = create_ast_node(WHILE_N);
+	t->left_child = yyvsp[-2];
+	t->left_child->right_sibling = yyvsp[0];
+	yyval = t; }
+#line 2080 "parser.tab.c"
+    break;
+
+  case 48: /* while_stmt: WHILE_T '(' error ')' stmt  */
+#line 411 "parser.y"
+                             { yyval = NULL; }
+#line 2086 "parser.tab.c"
+    break;
+
+  case 49: /* do_while_stmt: DO_T stmt WHILE_T '(' expression ')' ';'  */
+#line 417 "parser.y"
+                                                         {
+	ast_node t = create_ast_node(DO_WHILE_N);
+	assert(yyvsp[-5]);
+	t->left_child = yyvsp[-5];
+	t->left_child->right_sibling = yyvsp[-2];
+	yyval = t; }
+#line 2097 "parser.tab.c"
+    break;
+
+  case 50: /* do_while_stmt: DO_T stmt WHILE_T '(' error ')' ';'  */
+#line 423 "parser.y"
+                                      { yyval = NULL; }
+#line 2103 "parser.tab.c"
+    break;
+
+  case 51: /* for_stmt: FOR_T '(' for_header_expr ';' for_header_expr ';' for_header_expr ')' stmt  */
+#line 429 "parser.y"
+                                                                                      {
+	ast_node t = create_ast_node(FOR_STMT_N);
+	t->left_child = yyvsp[-6];
+	t->left_child->right_sibling = yyvsp[-4]; 
+	t->left_child->right_sibling->right_sibling = yyvsp[-2];
+	t->left_child->right_sibling->right_sibling->right_sibling = yyvsp[0];
+	yyval = t; }
+#line 2115 "parser.tab.c"
+    break;
+
+  case 52: /* for_stmt: FOR_T '(' error ')' error  */
+#line 436 "parser.y"
+                            { yyval = NULL;}
+#line 2121 "parser.tab.c"
+    break;
+
+  case 53: /* for_header_expr: expression  */
+#line 444 "parser.y"
+                             {
+	ast_node t = create_ast_node(FOR_HEADER_N);
+	t->left_child = yyvsp[0];
+	yyval = t; }
+#line 2130 "parser.tab.c"
+    break;
+
+  case 54: /* for_header_expr: %empty  */
+#line 448 "parser.y"
+              {
+	ast_node t = create_ast_node(FOR_HEADER_N);
+	yyval = t; }
+#line 2138 "parser.tab.c"
+    break;
+
+  case 55: /* return_stmt: RETURN_T ';'  */
+#line 458 "parser.y"
+                           {
+	ast_node t = create_ast_node(RETURN_N);
+	ast_node void_n = create_ast_node(VOID_N);
+	t->left_child = void_n;
+	yyval = t; }
+#line 2148 "parser.tab.c"
+    break;
+
+  case 56: /* return_stmt: RETURN_T expression ';'  */
+#line 463 "parser.y"
+                          {
+	ast_node t = create_ast_node(RETURN_N);
+	t->left_child = yyvsp[-1];
+	yyval = t; }
+#line 2157 "parser.tab.c"
+    break;
+
+  case 57: /* return_stmt: RETURN_T error ';'  */
+#line 467 "parser.y"
+                     { yyval = NULL; }
+#line 2163 "parser.tab.c"
+    break;
+
+  case 58: /* read_stmt: READ_T var ';'  */
+#line 473 "parser.y"
+                           {
+	ast_node t = create_ast_node(READ_N);
+	t->left_child = yyvsp[-1];
+	yyval = t; }
+#line 2172 "parser.tab.c"
+    break;
+
+  case 59: /* read_stmt: READ_T error ';'  */
+#line 477 "parser.y"
+                   { yyval = NULL; }
+#line 2178 "parser.tab.c"
+    break;
+
+  case 60: /* print_stmt: PRINT_T expression ';'  */
+#line 486 "parser.y"
+                                    {
+	ast_node t = create_ast_node(PRINT_N);
+	t->left_child = yyvsp[-1];
+	yyval = t; }
+#line 2187 "parser.tab.c"
+    break;
+
+  case 61: /* $@2: %empty  */
+#line 490 "parser.y"
+                   {
+	/* embedded action to grab string text */
+	ast_node str_n = create_ast_node(STRING_N);
+	str_n->value_string = arena_strdup(compile_arena, yytext);
+	yyvsp[0] = str_n;
+}
+#line 2198 "parser.tab.c"
+    break;
+
+  case 62: /* print_stmt: PRINT_T STRING_T $@2 ';'  */
+#line 495 "parser.y"
+      {
+	ast_node t = create_ast_node(PRINT_N);
+	t->left_child = yyvsp[-2]; 						
+	yyval = t; }
+#line 2207 "parser.tab.c"
+    break;
+
+  case 63: /* print_stmt: PRINT_T error ';'  */
+#line 499 "parser.y"
+                    { yyval = NULL; }
+#line 2213 "parser.tab.c"
+    break;
+
+  case 64: /* break_stmt: BREAK_T ';'  */
+#line 502 "parser.y"
+                         {
+	ast_node t = create_ast_node(BREAK_N);
+	yyval = t; }
+#line 2221 "parser.tab.c"
+    break;
+
+  case 65: /* continue_stmt: CONTINUE_T ';'  */
+#line 507 "parser.y"
+                               {
+	ast_node t = create_ast_node(CONTINUE_N);
+	yyval = t; }
+#line 2229 "parser.tab.c"
+    break;
+
+  case 66: /* expression: var '=' expression  */
+#line 515 "parser.y"
+                                {
+	ast_node t = create_ast_node(OP_ASSIGN_N);
+	t->left_child = yyvsp[-2];
+	t->left_child->right_sibling = yyvsp[0];
+	yyval = t; }
+#line 2239 "parser.tab.c"
+    break;
+
+  case 67: /* expression: r_value  */
+#line 520 "parser.y"
+          {
+	ast_node t = create_ast_node(EXPRESSION_N);
+	t->left_child = yyvsp[0];
+	yyval = t; }
+#line 2248 "parser.tab.c"
+    break;
+
+  case 68: /* var: ID_T  */
+#line 533 "parser.y"
+           {
+	ast_node t = create_ast_node(VAR_N);
+	ast_node id_n = create_ast_node(ID_N);
+	id_n->value_string = intern(compile_strings, savedIdText);
+	t->left_child = id_n;
+	yyval = t; }
+#line 2259 "parser.tab.c"
+    break;
+
+  case 69: /* $@3: %empty  */
+#line 539 "parser.y"
+       {
+	/* embedded action to catch ID_T string */
+	ast_node id_n = create_ast_node(ID_N);
+	id_n->value_string = intern(compile_strings, savedIdText);
+	yyvsp[0] = id_n;
+}
+#line 2270 "parser.tab.c"
+    break;
+
+  case 70: /* var: ID_T $@3 '[' expression ']'  */
+#line 544 "parser.y"
+                     {
+	ast_node t = create_ast_node(VAR_N);
+	t->left_child = yyvsp[-4];
+	t->left_child->right_sibling = yyvsp[-1];
+	yyval = t; }
+#line 2280 "parser.tab.c"
+    break;
+
+  case 71: /* r_value: expression '+' expression  */
+#line 556 "parser.y"
+                          {
+  ast_node t = create_ast_node(OP_PLUS_N);
+  t->left_child = yyvsp[-2];
+  t->left_child->right_sibling = yyvsp[0];
+  yyval = t; }
+#line 2290 "parser.tab.c"
+    break;
+
+  case 72: /* r_value: expression '-' expression  */
+#line 561 "parser.y"
+                            {
+  ast_node t = create_ast_node(OP_MINUS_N);
+  t->left_child = yyvsp[-2];
+  t->left_child->right_sibling = yyvsp[0];
+  yyval = t; }
+#line 2300 "parser.tab.c"
+    break;
+
+  case 73: /* r_value: expression '*' expression  */
+#line 566 "parser.y"
+                            {
+  ast_node t = create_ast_node(OP_TIMES_N);
+  t->left_child = yyvsp[-2];
+  t->left_child->right_sibling = yyvsp[0];
+  yyval = t; }
+#line 2310 "parser.tab.c"
+    break;
+
+  case 74: /* r_value: expression '/' expression  */
+#line 571 "parser.y"
+                            {
+  ast_node t = create_ast_node(OP_DIVIDE_N);
+  t->left_child = yyvsp[-2];
+  t->left_child->right_sibling = yyvsp[0];
+  yyval = t; }
+#line 2320 "parser.tab.c"
+    break;
+
+  case 75: /* r_value: expression '%' expression  */
+#line 576 "parser.y"
+                            {
+  ast_node t = create_ast_node(OP_MOD_N);
+  t->left_child = yyvsp[-2];
+  t->left_child->right_sibling = yyvsp[0];
+  yyval = t; }
+#line 2330 "parser.tab.c"
+    break;
+
+  case 76: /* r_value: expression '<' expression  */
+#line 581 "parser.y"
+                            {
+  ast_node t = create_ast_node(OP_LT_N);
+  t->left_child = yyvsp[-2];
+  t->left_child->right_sibling = yyvsp[0];
+  yyval = t; }
+#line 2340 "parser.tab.c"
+    break;
+
+  case 77: /* r_value: expression LTE_T expression  */
+#line 586 "parser.y"
+                              {
+  ast_node t = create_ast_node(OP_LTE_N);
+  t->left_child = yyvsp[-2];
+  t->left_child->right_sibling = yyvsp[0];
+  yyval = t; }
+#line 2350 "parser.tab.c"
+    break;
+
+  case 78: /* r_value: expression '>' expression  */
+#line 591 "parser.y"
+                            {
+  ast_node t = create_ast_node(OP_GT_N);
+  t->left_child = yyvsp[-2];
+  t->left_child->right_sibling = yyvsp[0];
+  yyval = t; }
+#line 2360 "parser.tab.c"
+    break;
+
+  case 79: /* r_value: expression GTE_T expression  */
+#line 596 "parser.y"
+                              {
+  ast_node t = create_ast_node(OP_GTE_N);
+  t->left_child = yyvsp[-2];
+  t->left_child->right_sibling = yyvsp[0];
+  yyval = t; }
+#line 2370 "parser.tab.c"
+    break;
+
+  case 80: /* r_value: expression EQ_T expression  */
+#line 601 "parser.y"
+                             {
+  ast_node t = create_ast_node(OP_EQ_N);
+  t->left_child = yyvsp[-2];
+  t->left_child->right_sibling = yyvsp[0];
+  yyval = t; }
+#line 2380 "parser.tab.c"
+    break;
+
+  case 81: /* r_value: expression NE_T expression  */
+#line 606 "parser.y"
+                             {
+  ast_node t = create_ast_node(OP_NE_N);
+  t->left_child = yyvsp[-2];
+  t->left_child->right_sibling = yyvsp[0];
+  yyval = t; }
+#line 2390 "parser.tab.c"
+    break;
+
+  case 82: /* r_value: expression AND_T expression  */
+#line 611 "parser.y"
+                              {
+  ast_node t = create_ast_node(OP_AND_N);
+  t->left_child = yyvsp[-2];
+  t->left_child->right_sibling = yyvsp[0];
+  yyval = t; }
+#line 2400 "parser.tab.c"
+    break;
+
+  case 83: /* r_value: expression OR_T expression  */
+#line 616 "parser.y"
+                             {
+  ast_node t = create_ast_node(OP_OR_N);
+  t->left_child = yyvsp[-2];
+  t->left_child->right_sibling = yyvsp[0];
+  yyval = t; }
+#line 2410 "parser.tab.c"
+    break;
+
+  case 84: /* r_value: '!' expression  */
+#line 621 "parser.y"
+                 {
+  ast_node t = create_ast_node(OP_NOT_N);
+  t->left_child = yyvsp[0];
+  yyval = t; }
+#line 2419 "parser.tab.c"
+    break;
+
+  case 85: /* r_value: '-' expression  */
+#line 625 "parser.y"
+                                {
+  ast_node t = create_ast_node(OP_NEG_N);
+  t->left_child = yyvsp[0];
+  yyval = t; }
+#line 2428 "parser.tab.c"
+    break;
+
+  case 86: /* r_value: var  */
+#line 629 "parser.y"
+      { yyval = yyvsp[0]; }
+#line 2434 "parser.tab.c"
+    break;
+
+  case 87: /* r_value: INCR_T var  */
+#line 630 "parser.y"
+             {
+  ast_node t = create_ast_node(OP_PRE_INC_N);
+  t->left_child = yyvsp[0];
+  yyval = t; }
+#line 2443 "parser.tab.c"
+    break;
+
+  case 88: /* r_value: var INCR_T  */
+#line 634 "parser.y"
+             {
+	ast_node t = create_ast_node(OP_POST_INC_N);
+	t->left_child = yyvsp[-1];
+	yyval = t; }
+#line 2452 "parser.tab.c"
+    break;
+
+  case 89: /* r_value: DECR_T var  */
+#line 638 "parser.y"
+             {
+  ast_node t = create_ast_node(OP_PRE_DEC_N);
+  t->left_child = yyvsp[0];
+  yyval = t; }
+#line 2461 "parser.tab.c"
+    break;
+
+  case 90: /* r_value: var DECR_T  */
+#line 642 "parser.y"
+             {
+	ast_node t = create_ast_node(OP_POST_DEC_N);
+	t->left_child = yyvsp[-1];
+	yyval = t; }
+#line 2470 "parser.tab.c"
+    break;
+
+  case 91: /* r_value: call  */
+#line 646 "parser.y"
+       { yyval = yyvsp[0]; }
+#line 2476 "parser.tab.c"
+    break;
+
+  case 92: /* r_value: '(' expression ')'  */
+#line 647 "parser.y"
+                     { yyval = yyvsp[-1]; }
+#line 2482 "parser.tab.c"
+    break;
+
+  case 93: /* r_value: INT_T  */
+#line 648 "parser.y"
+        {
+  ast_node t = create_ast_node(INT_LITERAL_N);	
+  t->value_int = atoi(savedLiteralText); 			
+  yyval = t; }
+#line 2491 "parser.tab.c"
+    break;
+
+  case 94: /* r_value: SIZEOF_T '(' var ')'  */
+#line 652 "parser.y"
+                       {
+	ast_node t = create_ast_node(SIZEOF_N);
+	t->left_child = yyvsp[-1];
+	yyval = t; }
+#line 2500 "parser.tab.c"
+    break;
+
+  case 95: /* r_value: SIZEOF_T '(' error ')'  */
+#line 656 "parser.y"
+                         { yyval = NULL; }
+#line 2506 "parser.tab.c"
+    break;
+
+  case 96: /* r_value: '(' error ')'  */
+#line 657 "parser.y"
+                { yyval = NULL; }
+#line 2512 "parser.tab.c"
+    break;
+
+  case 97: /* $@4: %empty  */
+#line 666 "parser.y"
+            {
+	/* embedded action to save function call ID string */
+	ast_node id_n = create_ast_node(ID_N);
+	id_n->value_string = intern(compile_strings, savedIdText);
+	yyvsp[0] = id_n;
+}
+#line 2523 "parser.tab.c"
+    break;
+
+  case 98: /* call: ID_T $@4 '(' args ')'  */
+#line 671 "parser.y"
+               {
+	ast_node t = create_ast_node(CALL_N);
+	t->left_child = yyvsp[-4];
+	t->left_child->right_sibling = yyvsp[-1];
+	yyval = t; }
+#line 2533 "parser.tab.c"
+    break;
+
+  case 99: /* args: arg_list  */
+#line 684 "parser.y"
+                { yyval = yyvsp[0]; }
+#line 2539 "parser.tab.c"
+    break;
+
+  case 100: /* args: %empty  */
+#line 685 "parser.y"
+                { yyval = NULL; }
+#line 2545 "parser.tab.c"
+    break;
+
+  case 101: /* arg_list: arg_list ',' expression  */
+#line 693 "parser.y"
+                                   { 
+	ast_node t = yyvsp[-2];
+	if (t->left_child) {
+		t = t->left_child;
+		while (t->right_sibling)
+			t = t->right_sibling;
+		t->right_sibling = yyvsp[0];
+		yyval = yyvsp[-2];
+	}
+
+	}
+#line 2561 "parser.tab.c"
+    break;
+
+  case 102: /* arg_list: expression  */
+#line 704 "parser.y"
+             { 
+	ast_node t = create_ast_node(ARG_LIST_N); 
+	t->left_child = yyvsp[0];
+	yyval = t;  }
+#line 2570 "parser.tab.c"
+    break;
+
+  case 103: /* arg_list: error  */
+#line 708 "parser.y"
+        { yyval = NULL; }
+#line 2576 "parser.tab.c"
+    break;
+
+
+#line 2580 "parser.tab.c"
+
+      default: break;
+    }
+  /* User semantic actions sometimes alter yychar, and that requires
+     that yytoken be updated with the new translation.  We take the
+     approach of translating immediately before every use of yytoken.
+     One alternative is translating here after every semantic action,
+     but that translation would be missed if the semantic action invokes
+     YYABORT, YYACCEPT, or YYERROR immediately after altering yychar or
+     if it invokes YYBACKUP.  In the case of YYABORT or YYACCEPT, an
+     incorrect destructor might then be invoked immediately.  In the
+     case of YYERROR or YYBACKUP, subsequent parser actions might lead
+     to an incorrect destructor call or verbose syntax error message
+     before the lookahead is translated.  */
+  YY_SYMBOL_PRINT ("-> $$ =", YY_CAST (yysymbol_kind_t, yyr1[yyn]), &yyval, &yyloc);
+
+  YYPOPSTACK (yylen);
+  yylen = 0;
+
+  *++yyvsp = yyval;
+
+  /* Now 'shift' the result of the reduction.  Determine what state
+     that goes to, based on the state we popped back to and the rule
+     number reduced by.  */
+  {
+    const int yylhs = yyr1[yyn] - YYNTOKENS;
+    const int yyi = yypgoto[yylhs] + *yyssp;
+    yystate = (0 <= yyi && yyi <= YYLAST && yycheck[yyi] == *yyssp
+               ? yytable[yyi]
+               : yydefgoto[yylhs]);
+  }
+
+  goto yynewstate;
+
+
+/*--------------------------------------.
+| yyerrlab -- here on detecting error.  |
+`--------------------------------------*/
+yyerrlab:
+  /* Make sure we have latest lookahead translation.  See comments at
+     user semantic actions for why this is necessary.  */
+  yytoken = yychar == YYEMPTY ? YYSYMBOL_YYEMPTY : YYTRANSLATE (yychar);
+  /* If not already recovering from an error, report this error.  */
+  if (!yyerrstatus)
+    {
+      ++yynerrs;
+      {
+        yypcontext_t yyctx
+          = {yyssp, yytoken};
+        char const *yymsgp = YY_("syntax error");
+        int yysyntax_error_status;
+        yysyntax_error_status = yysyntax_error (&yymsg_alloc, &yymsg, &yyctx);
+        if (yysyntax_error_status == 0)
+          yymsgp = yymsg;
+        else if (yysyntax_error_status == -1)
+          {
+            if (yymsg != yymsgbuf)
+              YYSTACK_FREE (yymsg);
+            yymsg = YY_CAST (char *,
+                             YYSTACK_ALLOC (YY_CAST (YYSIZE_T, yymsg_alloc)));
+            if (yymsg)
+              {
+                yysyntax_error_status
+                  = yysyntax_error (&yymsg_alloc, &yymsg, &yyctx);
+                yymsgp = yymsg;
+              }
+            else
+              {
+                yymsg = yymsgbuf;
+                yymsg_alloc = sizeof yymsgbuf;
+                yysyntax_error_status = YYENOMEM;
+              }
+          }
+        yyerror (yymsgp);
+        if (yysyntax_error_status == YYENOMEM)
+          YYNOMEM;
+      }
+    }
+
+  if (yyerrstatus == 3)
+    {
+      /* If just tried and failed to reuse lookahead token after an
+         error, discard it.  */
+
+      if (yychar <= YYEOF)
+        {
+          /* Return failure if at end of input.  */
+          if (yychar == YYEOF)
+            YYABORT;
+        }
+      else
+        {
+          yydestruct ("Error: discarding",
+                      yytoken, &yylval);
+          yychar = YYEMPTY;
+        }
+    }
+
+  /* Else will try to reuse lookahead token after shifting the error
+     token.  */
+  goto yyerrlab1;
+
+
+/*---------------------------------------------------.
+| yyerrorlab -- error raised explicitly by YYERROR.  |
+`---------------------------------------------------*/
+yyerrorlab:
+  /* Pacify compilers when the user code never invokes YYERROR and the
+     label yyerrorlab therefore never appears in user code.  */
+  if (0)
+    YYERROR;
+  ++yynerrs;
+
+  /* Do not reclaim the symbols of the rule whose action triggered
+     this YYERROR.  */
+  YYPOPSTACK (yylen);
+  yylen = 0;
+  YY_STACK_PRINT (yyss, yyssp);
+  yystate = *yyssp;
+  goto yyerrlab1;
+
+
+/*-------------------------------------------------------------.
+| yyerrlab1 -- common code for both syntax error and YYERROR.  |
+`-------------------------------------------------------------*/
+yyerrlab1:
+  yyerrstatus = 3;      /* Each real token shifted decrements this.  */
+
+  /* Pop stack until we find a state that shifts the error token.  */
+  for (;;)
+    {
+      yyn = yypact[yystate];
+      if (!yypact_value_is_default (yyn))
+        {
+          yyn += YYSYMBOL_YYerror;
+          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYSYMBOL_YYerror)
+            {
+              yyn = yytable[yyn];
+              if (0 < yyn)
+                break;
+            }
+        }
+
+      /* Pop the current state because it cannot handle the error token.  */
+      if (yyssp == yyss)
+        YYABORT;
+
+
+      yydestruct ("Error: popping",
+                  YY_ACCESSING_SYMBOL (yystate), yyvsp);
+      YYPOPSTACK (1);
+      yystate = *yyssp;
+      YY_STACK_PRINT (yyss, yyssp);
+    }
+
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  *++yyvsp = yylval;
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+
+
+  /* Shift the error token.  */
+  YY_SYMBOL_PRINT ("Shifting", YY_ACCESSING_SYMBOL (yyn), yyvsp, yylsp);
+
+  yystate = yyn;
+  goto yynewstate;
+
+
+/*-------------------------------------.
+| yyacceptlab -- YYACCEPT comes here.  |
+`-------------------------------------*/
+yyacceptlab:
+  yyresult = 0;
+  goto yyreturnlab;
+
+
+/*-----------------------------------.
+| yyabortlab -- YYABORT comes here.  |
+`-----------------------------------*/
+yyabortlab:
+  yyresult = 1;
+  goto yyreturnlab;
+
+
+/*-----------------------------------------------------------.
+| yyexhaustedlab -- YYNOMEM (memory exhaustion) comes here.  |
+`-----------------------------------------------------------*/
+yyexhaustedlab:
+  yyerror (YY_("memory exhausted"));
+  yyresult = 2;
+  goto yyreturnlab;
+
+
+/*----------------------------------------------------------.
+| yyreturnlab -- parsing is finished, clean up and return.  |
+`----------------------------------------------------------*/
+yyreturnlab:
+  if (yychar != YYEMPTY)
+    {
+      /* Make sure we have latest lookahead translation.  See comments at
+         user semantic actions for why this is necessary.  */
+      yytoken = YYTRANSLATE (yychar);
+      yydestruct ("Cleanup: discarding lookahead",
+                  yytoken, &yylval);
+    }
+  /* Do not reclaim the symbols of the rule whose action triggered
+     this YYABORT or YYACCEPT.  */
+  YYPOPSTACK (yylen);
+  YY_STACK_PRINT (yyss, yyssp);
+  while (yyssp != yyss)
+    {
+      yydestruct ("Cleanup: popping",
+                  YY_ACCESSING_SYMBOL (+*yyssp), yyvsp);
+      YYPOPSTACK (1);
+    }
+#ifndef yyoverflow
+  if (yyss != yyssa)
+    YYSTACK_FREE (yyss);
+#endif
+  if (yymsg != yymsgbuf)
+    YYSTACK_FREE (yymsg);
+  return yyresult;
+}
+
+#line 711 "parser.y"
+
+
+int yyerror(char *s) {
+	parseError = 1;
+	fprintf(stderr, "%s at line %d\n", s, yylineno);
+
+	if (++errors == MAX_ERRORS) {
+		fprintf(stderr,"Too many syntax errors have occurred. Aborting parse attempt.\n");
+		exit(1);
+	}	
+
+	return 0;
+}
+
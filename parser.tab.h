@@ -0,0 +1,103 @@
+/* A Bison parser, made by GNU Bison 3.8.2.  */
+
+/* Bison interface for Yacc-like parsers in C
+
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
+
+/* As a special exception, you may create a larger work that contains
+   part or all of the Bison parser skeleton and distribute that work
+   under terms of your choice, so long as that work isn't itself a
+   parser generator using the skeleton or a modified version thereof
+   as a parser skeleton.  Alternatively, if you modify or redistribute
+   the parser skeleton itself, you may (at your option) remove this
+   special exception, which will cause the skeleton and the resulting
+   Bison output files to be licensed under the GNU General Public
+   License without this special exception.
+
+   This special exception was added by the Free Software Foundation in
+   version 2.2 of Bison.  */
+
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
+#ifndef YY_YY_PARSER_TAB_H_INCLUDED
+# define YY_YY_PARSER_TAB_H_INCLUDED
+/* Debug traces.  */
+#ifndef YYDEBUG
+# define YYDEBUG 0
+#endif
+#if YYDEBUG
+extern int yydebug;
+#endif
+
+/* Token kinds.  */
+#ifndef YYTOKENTYPE
+# define YYTOKENTYPE
+  enum yytokentype
+  {
+    YYEMPTY = -2,
+    YYEOF = 0,                     /* "end of file"  */
+    YYerror = 256,                 /* error  */
+    YYUNDEF = 257,                 /* "invalid token"  */
+    ID_T = 258,                    /* ID_T  */
+    INT_T = 259,                   /* INT_T  */
+    STRING_T = 260,                /* STRING_T  */
+    TYPEINT_T = 261,               /* TYPEINT_T  */
+    IF_T = 262,                    /* IF_T  */
+    ELSE_T = 263,                  /* ELSE_T  */
+    DO_T = 264,                    /* DO_T  */
+    WHILE_T = 265,                 /* WHILE_T  */
+    RETURN_T = 266,                /* RETURN_T  */
+    BREAK_T = 267,                 /* BREAK_T  */
+    CONTINUE_T = 268,              /* CONTINUE_T  */
+    FOR_T = 269,                   /* FOR_T  */
+    VOID_T = 270,                  /* VOID_T  */
+    READ_T = 271,                  /* READ_T  */
+    PRINT_T = 272,                 /* PRINT_T  */
+    SIZEOF_T = 273,                /* SIZEOF_T  */
+    LTE_T = 274,                   /* LTE_T  */
+    GTE_T = 275,                   /* GTE_T  */
+    EQ_T = 276,                    /* EQ_T  */
+    NE_T = 277,                    /* NE_T  */
+    INCR_T = 278,                  /* INCR_T  */
+    DECR_T = 279,                  /* DECR_T  */
+    AND_T = 280,                   /* AND_T  */
+    OR_T = 281,                    /* OR_T  */
+    COMMENT_T = 282,               /* COMMENT_T  */
+    OTHER_T = 283,                 /* OTHER_T  */
+    LOWER_THAN_ELSE = 284,         /* LOWER_THAN_ELSE  */
+    UMINUS_T = 285                 /* UMINUS_T  */
+  };
+  typedef enum yytokentype yytoken_kind_t;
+#endif
+
+/* Value type.  */
+#if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
+typedef int YYSTYPE;
+# define YYSTYPE_IS_TRIVIAL 1
+# define YYSTYPE_IS_DECLARED 1
+#endif
+
+
+extern YYSTYPE yylval;
+
+
+int yyparse (void);
+
+
+#endif /* !YY_YY_PARSER_TAB_H_INCLUDED  */
@@ -15,6 +15,8 @@
 #include <string.h>
 #include <stdio.h>
 #include "src/ast.h" 			// defines ast node types and functions
+#include "src/arena.h" 			// strings live as long as the AST
+#include "src/intern.h" 		// one copy of each identifier
 #include <assert.h>
 
 #define YYSTYPE ast_node 	// override default node type
@@ -158,13 +160,13 @@ var_declaration_list : var_declaration_list ',' var_decl {
 var_decl : ID_T {
 	ast_node t = create_ast_node(VAR_DECL_N);
 	ast_node id_n = create_ast_node(ID_N);
-	id_n->value_string = strdup(savedIdText);
+	id_n->value_string = intern(compile_strings, savedIdText);
 	t->left_child = id_n;
 	$$ = t; }
 | ID_T '=' expression {
 	ast_node t = create_ast_node(VAR_DECL_N);
 	ast_node id_n = create_ast_node(ID_N);
-	id_n->value_string = strdup(savedIdText);
+	id_n->value_string = intern(compile_strings, savedIdText);
 	t->left_child = id_n;
 	t->left_child->right_sibling = $3;
 	$$ = t; }
@@ -172,7 +174,7 @@ var_decl : ID_T {
 	ast_node t = create_ast_node(VAR_DECL_N);
 	ast_node id_n = create_ast_node(ID_N);
 	ast_node int_n = create_ast_node(INT_LITERAL_N);
-	id_n->value_string = strdup(savedIdText);
+	id_n->value_string = intern(compile_strings, savedIdText);
 	int_n->value_int = atoi(savedLiteralText);
  	t->left_child = id_n;
 	t->left_child->right_sibling = int_n;
@@ -188,7 +190,7 @@ var_decl : ID_T {
 func_declaration : type_specifier ID_T {
 	/* embedded action to save function identifer */
 	ast_node id_n = create_ast_node(ID_N);
-	id_n->value_string = strdup(savedIdText); 
+	id_n->value_string = intern(compile_strings, savedIdText); 
 	$2 = id_n;
 } '(' formal_params ')' compound_stmt {
 	ast_node t = create_ast_node(FUNC_DECLARATION_N);
@@ -253,14 +255,14 @@ formal_list : formal_list ',' formal_param {
 formal_param : type_specifier ID_T {
 	ast_node t = create_ast_node(FORMAL_PARAM_N);			// save ID string in ID_N at right_sibling
 	ast_node id_n = create_ast_node(ID_N);
-	id_n->value_string = strdup(savedIdText);
+	id_n->value_string = intern(compile_strings, savedIdText);
 	t->left_child = $1;
 	t->left_child->right_sibling = id_n;
 	$$ = t; }
 | type_specifier ID_T '[' ']' {
 	ast_node t = create_ast_node(FORMAL_PARAM_ARR_N);		// save ID string in ID_N at right_sibling
 	ast_node id_n = create_ast_node(ID_N);
-	id_n->value_string = strdup(savedIdText);
+	id_n->value_string = intern(compile_strings, savedIdText);
 	t->left_child = $1;
 	t->left_child->right_sibling = id_n;
 	$$ = t; }
@@ -488,7 +490,7 @@ print_stmt : PRINT_T expression ';' {
 | PRINT_T STRING_T {
 	/* embedded action to grab string text */
 	ast_node str_n = create_ast_node(STRING_N);
-	str_n->value_string = strdup(yytext);
+	str_n->value_string = arena_strdup(compile_arena, yytext);
 	$2 = str_n;
 } ';' {
 	ast_node t = create_ast_node(PRINT_N);
@@ -531,13 +533,13 @@ expression : var '=' expression {
 var : ID_T {
 	ast_node t = create_ast_node(VAR_N);
 	ast_node id_n = create_ast_node(ID_N);
-	id_n->value_string = strdup(savedIdText);
+	id_n->value_string = intern(compile_strings, savedIdText);
 	t->left_child = id_n;
 	$$ = t; }
 | ID_T {
 	/* embedded action to catch ID_T string */
 	ast_node id_n = create_ast_node(ID_N);
-	id_n->value_string = strdup(savedIdText);
+	id_n->value_string = intern(compile_strings, savedIdText);
 	$1 = id_n;
 } '[' expression ']' {
 	ast_node t = create_ast_node(VAR_N);
@@ -664,7 +666,7 @@ expression '+' expression {
 call : ID_T {
 	/* embedded action to save function call ID string */
 	ast_node id_n = create_ast_node(ID_N);
-	id_n->value_string = strdup(savedIdText);
+	id_n->value_string = intern(compile_strings, savedIdText);
 	$1 = id_n;
 } '(' args ')' {
 	ast_node t = create_ast_node(CALL_N);
@@ -0,0 +1,104 @@
+#!/bin/bash
+
+# /*
+#  * runtests.sh
+#  *
+#  * USAGE: ./runtests.sh
+#  *
+#  * 1) builds the compiler and ./y86sim
+#  * 2) compiles every program under tests/ that has an answer file
+#  *    (NAME_ans.txt next to NAME.c) at -O0, -O1 and -O2 into results/tests/
+#  * 3) runs each one with y86sim, reading KHXR input from NAME_in.txt if
+#  *    there is one, and diffs its output against the answer file
+#  *
+#  * 4) compiles every program under tests/ at each level with -v -v, which
+#  *    traces every quad and operand, and checks the compiler didn't crash
+#  *
+#  * Exits 1 if any program fails to compile, doesn't halt normally or
+#  * prints something other than its answer file, or if a verbose
+#  * compilation crashes.
+#  */
+
+OUT_DIR=results/tests
+LEVELS="-O0 -O1 -O2"
+
+make gen_target_code y86sim > /dev/null
+
+if [ "$?" -ne 0 ]
+then
+	echo "Errors during make. Fix errors to continue."
+	exit 1
+fi
+
+mkdir -p $OUT_DIR
+FAILED=0
+COUNT=0
+
+for ANS_FILE in $(find tests -name "*_ans.txt" | sort)
+do
+	SRC_FILE=${ANS_FILE%_ans.txt}.c
+	IN_FILE=${ANS_FILE%_ans.txt}_in.txt
+	NAME=$(basename ${SRC_FILE%.c})
+	if [ ! -e "$IN_FILE" ]
+	then
+		IN_FILE=/dev/null
+	fi
+
+	for LEVEL in $LEVELS
+	do
+		OUT=$OUT_DIR/$NAME$LEVEL
+		COUNT=$((COUNT + 1))
+
+		./gen_target_code $LEVEL $SRC_FILE $OUT 2> $OUT.log
+		if [ "$?" -ne 0 ]
+		then
+			echo "FAILED: $SRC_FILE $LEVEL does not compile (see $OUT.log)"
+			FAILED=$((FAILED + 1))
+			continue
+		fi
+
+		./y86sim -q -i $IN_FILE $OUT.ys > $OUT.out 2>> $OUT.log
+		if [ "$?" -ne 0 ]
+		then
+			echo "FAILED: $SRC_FILE $LEVEL did not halt normally (see $OUT.log)"
+			FAILED=$((FAILED + 1))
+			continue
+		fi
+
+		diff $ANS_FILE $OUT.out > $OUT.diff
+		if [ "$?" -ne 0 ]
+		then
+			echo "FAILED: $SRC_FILE $LEVEL output differs from $ANS_FILE (see $OUT.diff)"
+			FAILED=$((FAILED + 1))
+		fi
+	done
+done
+
+# verbose traces -- programs with errors may fail, but not crash
+for SRC_FILE in $(find tests -name "*.c" | sort)
+do
+	NAME=$(basename ${SRC_FILE%.c})
+
+	for LEVEL in $LEVELS
+	do
+		OUT=$OUT_DIR/$NAME$LEVEL.verbose
+		COUNT=$((COUNT + 1))
+
+		./gen_target_code -v -v $LEVEL $SRC_FILE $OUT > /dev/null 2> $OUT.log
+		if [ "$?" -ge 128 ]
+		then
+			echo "FAILED: $SRC_FILE $LEVEL -v -v crashed (see $OUT.log)"
+			FAILED=$((FAILED + 1))
+		fi
+	done
+done
+
+echo " "
+if [ "$FAILED" -ne 0 ]
+then
+	echo "$FAILED of $COUNT test runs failed."
+	exit 1
+fi
+
+echo "All $COUNT test runs succeeded."
+exit 0
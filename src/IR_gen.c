@@ -8,6 +8,8 @@
 #include "types.h"
 #include "toktypes.h"
 #include "IR_gen.h"
+#include "arena.h"
+#include "intern.h"
 
 
 #define INIT_QUAD_LIST_SIZE 10
@@ -103,21 +105,16 @@ quad_arg * CG(ast_node root) {
         break;
 
       case IF_STMT_N:
-        // new temp t1 = new_temp()
         // new label L_FI = new_label()
-        // t1 = CG(root->left_child)
-        // GenQuad(IFFALSE_Q, t1, L_FI, -)
+        // CG_cond(root->left_child, -, L_FI)
         // CG(root->left_child->right_sibling)
-        // new label L_FI = new_label()
         // GenQuad(LABEL_Q, L_FI, -, -)
         {
-          quad_arg * arg1 = CG(root->left_child);
-
           char * label_fi = new_label(root, "FI");
           quad_arg * arg2 = create_quad_arg(LABEL_Q_ARG);
           arg2->label = label_fi;
 
-          gen_quad(IFFALSE_Q, arg1, arg2, NULL);
+          CG_cond(root->left_child, NULL, arg2);
 
           CG(root->left_child->right_sibling);
 
@@ -127,10 +124,8 @@ quad_arg * CG(ast_node root) {
         }
 
       case IF_ELSE_STMT_N:
-        // new temp t1 = new_temp()
         // new label L_ELSE = new_label()
-        // t1 = CG(root->left_child)
-        // GenQuad(IFFALSE_Q, t1, L_ELSE, -)
+        // CG_cond(root->left_child, -, L_ELSE)
         // CG(root->left_child->right_sibling)
         // new label L_FI = new_label()
         // GenQuad(GOTO_Q, L_FI, -, -)
@@ -138,8 +133,6 @@ quad_arg * CG(ast_node root) {
         // CG(root->left_child->right_sibling->right_sibling)
         // GenQuad(LABEL_Q, L_FI, -, -)
         {
-          quad_arg * arg1 = CG(root->left_child);
-          
           char * label_else = new_label(root, "ELSE");
           quad_arg * else_arg = create_quad_arg(LABEL_Q_ARG);
           else_arg->label = label_else;
@@ -148,7 +141,7 @@ quad_arg * CG(ast_node root) {
           quad_arg * fi_arg = create_quad_arg(LABEL_Q_ARG);
           fi_arg->label = label_fi;
 
-          gen_quad(IFFALSE_Q, arg1, else_arg, NULL);
+          CG_cond(root->left_child, NULL, else_arg);
 
           CG(root->left_child->right_sibling);
 
@@ -181,8 +174,7 @@ quad_arg * CG(ast_node root) {
 
           gen_quad(LABEL_Q, test_arg, NULL, NULL);
 
-          quad_arg * arg1 = CG(root->left_child->right_sibling);
-          gen_quad(IFFALSE_Q, arg1, exit_arg, NULL);
+          CG_cond(root->left_child->right_sibling, NULL, exit_arg);
           CG(root->left_child->right_sibling->right_sibling->right_sibling);
 
           gen_quad(LABEL_Q, update_arg, NULL, NULL);
@@ -207,9 +199,7 @@ quad_arg * CG(ast_node root) {
 
           gen_quad(LABEL_Q, test_arg, NULL, NULL);
 
-          quad_arg * arg1 = CG(root->left_child);
-
-          gen_quad(IFFALSE_Q, arg1, exit_arg, NULL);
+          CG_cond(root->left_child, NULL, exit_arg);
 
           CG(root->left_child->right_sibling);
 
@@ -240,11 +230,9 @@ quad_arg * CG(ast_node root) {
 
           gen_quad(LABEL_Q, test_arg, NULL, NULL);
 
-          quad_arg * arg1 = CG(root->left_child->right_sibling);
-
-          gen_quad(IFFALSE_Q, arg1, exit_arg, NULL);
+          // loop back while true, fall out to the exit otherwise
+          CG_cond(root->left_child->right_sibling, do_arg, NULL);
 
-          gen_quad(GOTO_Q, do_arg, NULL, NULL);
           gen_quad(LABEL_Q, exit_arg, NULL, NULL);
 
           break;
@@ -525,11 +513,11 @@ quad_arg * CG(ast_node root) {
           if (root->left_child->right_sibling == NULL && root->mod == SINGLE_DT) {
             to_return = create_quad_arg(SYMBOL_VAR_Q_ARG);
             to_return->label = root->left_child->value_string;
-            to_return->symnode = look_up_scopes_to_find_symbol(root->scope_table, to_return->label);
+            to_return->symnode = resolve_identifier(root->left_child);
           } else {
             to_return = create_quad_arg(SYMBOL_ARR_Q_ARG);
             to_return->label = root->left_child->value_string;
-            to_return->symnode = look_up_scopes_to_find_symbol(root->scope_table, to_return->label);
+            to_return->symnode = resolve_identifier(root->left_child);
 
             if (root->left_child->right_sibling != NULL) {
 
@@ -624,6 +612,74 @@ quad_arg * CG_assign_op(ast_node root) {
   return arg2;
 }
 
+/*
+ * branch context code generation for conditions:
+ * jumps to true_arg when cond holds and to false_arg when it doesn't. Exactly
+ * one of the two is NULL, meaning that case falls through to the next quad.
+ * && / || / ! are lowered straight to jumps so no 0/1 temp is ever built.
+ */
+void CG_cond(ast_node cond, quad_arg * true_arg, quad_arg * false_arg) {
+  assert((true_arg == NULL) != (false_arg == NULL));
+
+  switch (cond->node_type) {
+    case OP_AND_N:
+      if (true_arg == NULL) {
+        // either side false skips to false_arg
+        CG_cond(cond->left_child, NULL, false_arg);
+        CG_cond(cond->left_child->right_sibling, NULL, false_arg);
+      } else {
+        // left false falls out past the right operand
+        quad_arg * skip_arg = create_quad_arg(LABEL_Q_ARG);
+        skip_arg->label = new_label(cond, "AND_FALSE");
+
+        CG_cond(cond->left_child, NULL, skip_arg);
+        CG_cond(cond->left_child->right_sibling, true_arg, NULL);
+        gen_quad(LABEL_Q, skip_arg, NULL, NULL);
+      }
+      break;
+
+    case OP_OR_N:
+      if (false_arg == NULL) {
+        // either side true jumps to true_arg
+        CG_cond(cond->left_child, true_arg, NULL);
+        CG_cond(cond->left_child->right_sibling, true_arg, NULL);
+      } else {
+        // left true jumps past the right operand
+        quad_arg * skip_arg = create_quad_arg(LABEL_Q_ARG);
+        skip_arg->label = new_label(cond, "OR_TRUE");
+
+        CG_cond(cond->left_child, skip_arg, NULL);
+        CG_cond(cond->left_child->right_sibling, NULL, false_arg);
+        gen_quad(LABEL_Q, skip_arg, NULL, NULL);
+      }
+      break;
+
+    case OP_NOT_N:
+      CG_cond(cond->left_child, false_arg, true_arg);
+      break;
+
+    case FOR_HEADER_N:
+      if (cond->left_child != NULL) {
+        CG_cond(cond->left_child, true_arg, false_arg);
+      } else if (true_arg != NULL) {
+        // empty test is always true
+        gen_quad(GOTO_Q, true_arg, NULL, NULL);
+      }
+      break;
+
+    default:
+      {
+        quad_arg * value = CG(cond);
+
+        if (true_arg == NULL)
+          gen_quad(IFFALSE_Q, value, false_arg, NULL);
+        else
+          gen_quad(IFTRUE_Q, value, true_arg, NULL);
+        break;
+      }
+  }
+}
+
 quad_arg * CG_math_op(ast_node root, quad_op op) {
   quad_arg * arg1 = CG(root->left_child);
 
@@ -660,20 +716,25 @@ quad_arg * CG_math_op(ast_node root, quad_op op) {
 
 /*
  * returns label of form "L_N[#]_[NODE TYPE]"
- * should be free'd after done using
+ * interned -- don't free it, and compare labels with ==
  */
 char * new_label(ast_node root, char * name) {
   if (!root)
     return NULL;
 
-  char * label = (char *)calloc(MAX_LABEL_LENGTH,sizeof(char));
-  assert(label);
+  char label[MAX_LABEL_LENGTH];
+  snprintf(label, MAX_LABEL_LENGTH, "L_N%d_%s",root->id, name);
 
-  sprintf(label,"L_N%d_%s",root->id, name);
-  //printf("label: %s\n",label);
+  return intern(compile_strings, label);
+}
 
-  assert(label);
-  return label;
+char * new_pass_label(char * name) {
+  static int pass_labels = 0;
+
+  char label[MAX_LABEL_LENGTH];
+  snprintf(label, MAX_LABEL_LENGTH, "L_P%d_%s", pass_labels++, name);
+
+  return intern(compile_strings, label);
 }
 
 
@@ -683,7 +744,6 @@ void print_label(ast_node root) {
 
   char * label = new_label(root, NODE_NAME(root->node_type));
   printf("%s\n",label);
-  free(label);
 
   for (ast_node child = root->left_child; child != NULL; child = child->right_sibling)
     new_label(child, NODE_NAME(child->node_type));
@@ -699,7 +759,7 @@ quad_arr * init_quad_list() {
   if(!quad_list) {
     quad_list = (quad_arr *)calloc(1,sizeof(quad_arr));
     assert(quad_list);
-    quad_list->arr = (quad **)calloc(INIT_QUAD_LIST_SIZE, sizeof(quad *));
+    quad_list->arr = (quad *)calloc(INIT_QUAD_LIST_SIZE, sizeof(quad));
     assert(quad_list->arr);
 
     quad_list->size = INIT_QUAD_LIST_SIZE;
@@ -711,8 +771,7 @@ quad_arr * init_quad_list() {
 
 // create a quad arg struct of type
 quad_arg * create_quad_arg(quad_arg_discriminant type) {
-  quad_arg * new_arg = (quad_arg *)calloc(1,sizeof(quad_arg));
-  assert(new_arg);
+  quad_arg * new_arg = (quad_arg *)arena_calloc(compile_arena, 1, sizeof(quad_arg));
   new_arg->type = type;
   return new_arg;
 }
@@ -727,12 +786,12 @@ char * get_quad_arg_label(quad_arg * arg) {
       {
         char constant_str[MAX_LABEL_LENGTH] = "";
         sprintf(constant_str,"CONSTANT: %d",arg->int_literal);
-        label = strdup(constant_str);
+        label = arena_strdup(compile_arena, constant_str);
       }
       break;
 
     case TEMP_VAR_Q_ARG:
-      label = ((symnode_t *)arg->temp->temp_symnode)->name;
+      label = make_temp_name(arg->temp->id);
       break;
 
     case LABEL_Q_ARG:
@@ -743,7 +802,7 @@ char * get_quad_arg_label(quad_arg * arg) {
       break;
 
     case RETURN_Q_ARG:
-      label = strdup("return value");
+      label = "return value";
       break;
 
     default:
@@ -758,7 +817,8 @@ char * get_quad_arg_label(quad_arg * arg) {
  *
  * Looks for global quad_arr * called "quad_list" in main.c file
  *
- * Unused arguments are uninitialized quads
+ * Unused arguments are NULL. The args are copied into the quad, so the
+ * same quad_arg can be handed to several quads (or reused) afterwards.
  *
  * returns 1 on failure
  */
@@ -767,36 +827,53 @@ int gen_quad(quad_op operation, quad_arg * a1, quad_arg * a2, quad_arg * a3) {
   if (!quad_list) 
     return 1;
 
-  quad_list->arr[quad_list->count] = (quad *)calloc(1,sizeof(quad));
-  quad_list->arr[quad_list->count]->number = quad_list->count;
-  quad_list->arr[quad_list->count]->op = operation;
-  quad_list->arr[quad_list->count]->args[0] = a1;
-  quad_list->arr[quad_list->count]->args[1] = a2;
-  quad_list->arr[quad_list->count]->args[2] = a3;
+  quad * q = &quad_list->arr[quad_list->count];
+  q->number = quad_list->count;
+  q->op = operation;
+  q->args[0] = a1 ? *a1 : NULL_QUAD_ARG;
+  q->args[1] = a2 ? *a2 : NULL_QUAD_ARG;
+  q->args[2] = a3 ? *a3 : NULL_QUAD_ARG;
 
   (quad_list->count)++;
-  /* double array size if full */
+  /* double array size if full -- moves the quads, so don't hold quad pointers across gen_quad */
   if (quad_list->count == quad_list->size) {
     quad_list->size *= 2;
-    quad_list->arr = realloc(quad_list->arr,sizeof(quad *) * quad_list->size);
+    quad_list->arr = realloc(quad_list->arr,sizeof(quad) * quad_list->size);
     assert(quad_list->arr);
   }
 
   return 0;
 }
 
+/*
+ * drops every quad i with removed[i] set from the global quad list and
+ * renumbers the survivors so quad->number is its index again
+ */
+int remove_quads(char * removed) {
+  if (!quad_list || !removed)
+    return 0;
+
+  int kept = 0;
+  for (int i = 0; i < quad_list->count; i++) {
+    if (removed[i])
+      continue;
+
+    quad_list->arr[kept] = quad_list->arr[i];
+    quad_list->arr[kept].number = kept;
+    kept++;
+  }
+
+  int removed_count = quad_list->count - kept;
+  quad_list->count = kept;
+  return removed_count;
+}
+
 // prints global quad list
 void print_quad_list() {
   if (quad_list != NULL) {
 
-    for (int i = 0; i < quad_list->count; i++) {
-
-      if (quad_list->arr[i] != NULL)
-        print_quad(quad_list->arr[i]);
-      else
-        fprintf(stderr,"null quad\n");
-
-    }
+    for (int i = 0; i < quad_list->count; i++)
+      print_quad(&quad_list->arr[i]);
   } else {
     fprintf(stderr,"cannot print quad list because list is null\n");
   }
@@ -809,51 +886,48 @@ void print_quad(quad * q) {
   printf("%d -- (%s, ",q->number,QUAD_NAME(q->op));
 
   /* print three arguments */
-  quad_arg arg;
   for (int i = 0; i < QUAD_ARG_NUM; i++) {
-    if (q->args[i] == NULL) {
-      printf(" - ");
-    } else {
-      switch(q->args[i]->type) {
+    switch(q->args[i].type) {
 
-      case INT_LITERAL_Q_ARG:
-        printf("Constant: %d",q->args[i]->int_literal);
-        break;
+    case INT_LITERAL_Q_ARG:
+      printf("Constant: %d",q->args[i].int_literal);
+      break;
 
-      case TEMP_VAR_Q_ARG:
-        printf("Temp %d",
-         q->args[i]->temp->id);
-        break;
+    case TEMP_VAR_Q_ARG:
+      printf("Temp %d",
+       q->args[i].temp->id);
+      break;
 
-      case SYMBOL_VAR_Q_ARG:
-        printf("Symbol: %s",q->args[i]->label);
-        break;
+    case SYMBOL_VAR_Q_ARG:
+      printf("Symbol: %s",q->args[i].label);
+      break;
 
-      case SYMBOL_ARR_Q_ARG:
-        if (q->args[i]->temp != NULL)
-          printf("Symbol: %s [index: %s]",q->args[i]->label, ((symnode_t *)q->args[i]->temp->temp_symnode)->name);
-        else
-          printf("Symbol: %s, [pointer: %d]",q->args[i]->label, q->args[i]->int_literal);
+    case SYMBOL_ARR_Q_ARG:
+      if (q->args[i].temp != NULL && q->args[i].int_literal == ELEMENT_POINTER)
+        printf("Symbol: %s [address: %d_temp]",q->args[i].label, q->args[i].temp->id);
+      else if (q->args[i].temp != NULL)
+        printf("Symbol: %s [index: %d_temp]",q->args[i].label, q->args[i].temp->id);
+      else
+        printf("Symbol: %s, [pointer: %d]",q->args[i].label, q->args[i].int_literal);
 
-        break;
+      break;
 
-      case SYMBOL_FUNC_Q_ARG:
-        printf("Function Symbol: %s",q->args[i]->symnode->name);
-        break;
+    case SYMBOL_FUNC_Q_ARG:
+      printf("Function Symbol: %s",q->args[i].symnode->name);
+      break;
 
-      case LABEL_Q_ARG:
-        printf("Label: %s",q->args[i]->label);
-        break;
+    case LABEL_Q_ARG:
+      printf("Label: %s",q->args[i].label);
+      break;
 
-      case RETURN_Q_ARG:
-        printf("Returned Value");
-        break;
+    case RETURN_Q_ARG:
+      printf("Returned Value");
+      break;
 
-      default:  // null arg case
-        printf(" - ");
-        break;
-      }
-    } 
+    default:  // null arg case
+      printf(" - ");
+      break;
+    }
 
     if (i < QUAD_ARG_NUM - 1)
       printf(", ");
@@ -864,7 +938,10 @@ void print_quad(quad * q) {
 
 // destroys global quad list
 void destroy_quad_list() {
-  if (quad_list != NULL)
+  if (quad_list != NULL) {
+    free(quad_list->arr);
     free(quad_list);
+    quad_list = NULL;
+  }
 }
 
@@ -17,6 +17,7 @@
 #include "quad.h"
 
 #define PASS_ARR_POINTER -1     // HACKY but it works -- needed by y86_code_gen
+#define ELEMENT_POINTER -2      // SYMBOL_ARR_Q_ARG whose temp holds the element's address, not its index
 
 /*
  * returns label of form "L_N[#]_[NODE TYPE]"
@@ -24,6 +25,12 @@
  */
 char * new_label(ast_node root, char * name);
 
+/*
+ * returns label of form "L_P[#]_[name]" for code an optimization pass adds,
+ * numbered by a counter since there's no ast node to name it after
+ */
+char * new_pass_label(char * name);
+
 /*
  * calls make_label() on root and all of root's children
  */
@@ -36,6 +43,12 @@ void print_label(ast_node root);
 quad_arg * CG(ast_node root);
 
 quad_arg * CG_assign_op(ast_node root);
+
+/*
+ * generates a condition as jumps: to true_arg if it holds, to false_arg if not.
+ * one of the labels must be NULL -- that outcome falls through.
+ */
+void CG_cond(ast_node cond, quad_arg * true_arg, quad_arg * false_arg);
 quad_arg * CG_math_op(ast_node root, quad_op op);
 
 /*
@@ -68,12 +81,20 @@ char * get_quad_arg_label(quad_arg * arg);
  *
  * Looks for global quad_arr * called "quad_list" in main.c file
  *
- * Unused arguments are uninitialized quads
+ * Unused arguments are NULL. The args are copied into the quad.
  *
  * returns 1 on failure
  */
 int gen_quad(quad_op, quad_arg * a1, quad_arg * a2, quad_arg * a3);
 
+/*
+ * removes quads flagged in removed[] (indexed like quad_list->arr) from the
+ * global quad list and renumbers the rest
+ *
+ * returns number of quads removed
+ */
+int remove_quads(char * removed);
+
 /*
  * looks for and prints "quad_list" in main.c
  */
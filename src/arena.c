@@ -0,0 +1,97 @@
+/*
+ * arena.c
+ *
+ * objects are carved out of large chunks by bumping a pointer, so an
+ * allocation is an add and a compare instead of a trip through malloc,
+ * objects created together sit together in memory, and the whole
+ * compilation is released with one pass over the chunk list.
+ * nothing is freed individually.
+ *
+ * Yondon Fu and Matt McFarland - Delights (CS57 - 16W)
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "arena.h"
+
+#define ARENA_ALIGN 16
+#define ALIGN_UP(X) ( ((X) + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1) )
+
+static arena_chunk * new_chunk(arena * a, size_t size) {
+	arena_chunk * chunk = (arena_chunk *)malloc(sizeof(arena_chunk) + size);
+	if (!chunk) {
+		fprintf(stderr, "arena: ran out of memory allocating %lu bytes\n", (unsigned long)size);
+		exit(1);
+	}
+
+	chunk->size = size;
+	chunk->used = 0;
+	a->bytes_reserved += size;
+	a->chunk_count++;
+	return chunk;
+}
+
+arena * create_arena(size_t chunk_size) {
+	arena * a = (arena *)calloc(1, sizeof(arena));
+	if (!a) {
+		fprintf(stderr, "arena: ran out of memory\n");
+		exit(1);
+	}
+
+	a->chunk_size = chunk_size ? chunk_size : ARENA_CHUNK_SIZE;
+	a->head = new_chunk(a, a->chunk_size);
+	a->head->next = NULL;
+	return a;
+}
+
+void * arena_calloc(arena * a, size_t count, size_t size) {
+	size_t bytes = ALIGN_UP(count * size);
+	if (bytes == 0)
+		bytes = ARENA_ALIGN;
+
+	arena_chunk * chunk = a->head;
+	if (chunk->used + bytes > chunk->size) {
+		if (bytes > a->chunk_size / 4) {
+			/* big request: own chunk behind the head so the head keeps filling */
+			arena_chunk * big = new_chunk(a, bytes);
+			big->next = chunk->next;
+			chunk->next = big;
+			chunk = big;
+		} else {
+			chunk = new_chunk(a, a->chunk_size);
+			chunk->next = a->head;
+			a->head = chunk;
+		}
+	}
+
+	/* chunks come from malloc, which is at least ARENA_ALIGN aligned on our targets */
+	void * block = chunk->data + chunk->used;
+	chunk->used += bytes;
+	memset(block, 0, bytes);
+
+	a->allocations++;
+	a->bytes_used += bytes;
+	return block;
+}
+
+char * arena_strdup(arena * a, const char * s) {
+	size_t len = strlen(s) + 1;
+	char * copy = (char *)arena_calloc(a, len, sizeof(char));
+	memcpy(copy, s, len);
+	return copy;
+}
+
+void destroy_arena(arena * a) {
+	if (!a)
+		return;
+
+	arena_chunk * chunk = a->head;
+	while (chunk) {
+		arena_chunk * next = chunk->next;
+		free(chunk);
+		chunk = next;
+	}
+	free(a);
+}
@@ -0,0 +1,55 @@
+/*
+ * arena.h
+ *
+ * bump allocator for objects that live as long as the compilation
+ * (AST nodes, quads, quad args, temps, labels and names)
+ * Yondon Fu and Matt McFarland - Delights (CS57 - 16W)
+ */
+
+#ifndef _ARENA_H
+#define _ARENA_H
+
+#include <stddef.h>
+
+#define ARENA_CHUNK_SIZE (64 * 1024)
+
+typedef struct arena_chunk {
+	struct arena_chunk * next;
+	size_t size; 				// bytes in data
+	size_t used;
+	_Alignas(16) char data[]; 	// ARENA_ALIGN
+} arena_chunk;
+
+typedef struct arena {
+	arena_chunk * head; 		// chunk being allocated from, older chunks follow
+	size_t chunk_size; 			// size of new chunks (bigger requests get their own)
+
+	/* usage counters */
+	long allocations;
+	size_t bytes_used;
+	size_t bytes_reserved;
+	int chunk_count;
+} arena;
+
+/*
+ * arena every object of the current compilation is allocated from --
+ * created and released by main
+ */
+extern arena * compile_arena;
+
+arena * create_arena(size_t chunk_size);
+
+/*
+ * zeroed, suitably aligned block of count * size bytes. never returns NULL
+ * (exits when out of memory, like create_ast_node)
+ */
+void * arena_calloc(arena * a, size_t count, size_t size);
+
+char * arena_strdup(arena * a, const char * s);
+
+/*
+ * frees every chunk -- everything allocated from a is gone
+ */
+void destroy_arena(arena * a);
+
+#endif 	// _ARENA_H
@@ -20,6 +20,7 @@
 #include "symtab.h"
 #include "types.h"
 #include "IR_gen.h"     // for label function
+#include "arena.h"
 
 extern int yylineno;
 extern int node_count;
@@ -27,11 +28,7 @@ extern int node_count;
 /* Create a node with a given token type and return a pointer to the
    node. */
 ast_node create_ast_node(ast_node_type node_type) {
-  ast_node new_node = calloc(1,sizeof(struct ast_node_struct));  // for zeros
-  if (!new_node) {
-    fprintf(stderr,"error creating node of type %s -- ran out of memory.\n", NODE_NAME(node_type));
-    exit(1);
-  }
+  ast_node new_node = arena_calloc(compile_arena, 1, sizeof(struct ast_node_struct));  // zeroed, exits when out of memory
   new_node->node_type = node_type;
   new_node->line_number = yylineno;
   new_node->id = node_count++;
@@ -98,7 +95,6 @@ void print_ast(ast_node root, int depth) {
   //printf("%s, ", NODE_NAME(root->node_type));
   char * label = new_label(root, NODE_NAME(root->node_type));
   printf("%s ",label);
-  free(label);
 
   /* Print attributes specific to node types. */
   switch (root->node_type) {
@@ -140,6 +140,7 @@ struct ast_node_struct {
   // scope information
   int id;                       // unique id
   void * scope_table;           // void becuase of include dependencies
+  void * binding;               // symnode an ID_N use resolved to while the symtab was built (NULL if not yet declared)
   int line_number;              // yylineno that this node was synthesized on
   ast_node parent_function;     // for RETURN_N
 
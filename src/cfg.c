@@ -0,0 +1,321 @@
+/*
+ * cfg.c
+ *
+ * builds control flow graphs (basic blocks and their edges) over the
+ * quads between each PROLOG_Q and EPILOG_Q in the global quad_list.
+ *
+ * A new block starts at the PROLOG_Q, at every LABEL_Q and after every
+ * GOTO_Q, IFFALSE_Q, IFTRUE_Q and RET_Q. A GOTO_Q only has its target as
+ * successor, a conditional jump has its target and the next block, and
+ * every other block falls through to the next one. The block holding the EPILOG_Q has no
+ * successors.
+ *
+ * Yondon Fu and Matt McFarland - Delights (CS57 - 16W)
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+
+#include "cfg.h"
+#include "IR_gen.h"
+#include "intern.h"
+
+#define INIT_PRED_COUNT 2
+#define INIT_CFG_LIST_SIZE 8
+
+extern quad_arr * quad_list;
+
+/*
+ * label -> block it starts, sorted by interned label id for lookups
+ */
+typedef struct label_block {
+	char * label;
+	int block;
+} label_block;
+
+static int compare_label_block(const void * a, const void * b) {
+	return intern_id(((const label_block *)a)->label) - intern_id(((const label_block *)b)->label);
+}
+
+static int ends_block(quad_op op) {
+	return op == GOTO_Q || op == IFFALSE_Q || op == IFTRUE_Q || op == RET_Q;
+}
+
+static void add_edge(cfg * graph, int from, int to) {
+	basic_block * src = &graph->blocks[from];
+	basic_block * dest = &graph->blocks[to];
+
+	/* both edges of a conditional jump may go to the same block */
+	for (int s = 0; s < src->succ_count; s++) {
+		if (src->succs[s] == to)
+			return;
+	}
+	src->succs[src->succ_count++] = to;
+
+	if (dest->pred_count == dest->pred_size) {
+		dest->pred_size *= 2;
+		dest->preds = realloc(dest->preds, dest->pred_size * sizeof(int));
+		assert(dest->preds);
+	}
+	dest->preds[dest->pred_count++] = from;
+}
+
+static int lookup_label_block(label_block * labels, int label_count, char * label) {
+	label_block key;
+	key.label = label;
+
+	label_block * found = bsearch(&key, labels, label_count, sizeof(label_block), compare_label_block);
+	if (!found)
+		return NO_BLOCK;
+	return found->block;
+}
+
+/*
+ * numbers reachable blocks in reverse postorder (iterative dfs from the entry)
+ */
+static void compute_reverse_postorder(cfg * graph) {
+	int * visited = (int *)calloc(graph->block_count, sizeof(int));
+	int * stack = (int *)malloc(graph->block_count * sizeof(int));
+	int * next_succ = (int *)calloc(graph->block_count, sizeof(int));
+	assert(visited && stack && next_succ);
+
+	graph->rpo = (int *)malloc(graph->block_count * sizeof(int));
+	assert(graph->rpo);
+
+	int post_count = 0;
+	int top = 0;
+	stack[top++] = 0;
+	visited[0] = 1;
+
+	while (top > 0) {
+		basic_block * b = &graph->blocks[stack[top - 1]];
+
+		if (next_succ[b->id] < b->succ_count) {
+			int s = b->succs[next_succ[b->id]++];
+			if (!visited[s]) {
+				visited[s] = 1;
+				stack[top++] = s;
+			}
+		} else {
+			graph->rpo[post_count++] = b->id;
+			top--;
+		}
+	}
+
+	/* postorder -> reverse postorder */
+	for (int i = 0; i < post_count / 2; i++) {
+		int tmp = graph->rpo[i];
+		graph->rpo[i] = graph->rpo[post_count - 1 - i];
+		graph->rpo[post_count - 1 - i] = tmp;
+	}
+	graph->rpo_count = post_count;
+
+	free(visited);
+	free(stack);
+	free(next_succ);
+}
+
+cfg * build_cfg(int prolog, int epilog) {
+	if (!quad_list || prolog < 0 || epilog >= quad_list->count || prolog > epilog)
+		return NULL;
+
+	cfg * graph = (cfg *)calloc(1, sizeof(cfg));
+	assert(graph);
+
+	graph->prolog = prolog;
+	graph->epilog = epilog;
+	if (quad_list->arr[prolog].args[0].type != NULL_ARG)
+		graph->function = quad_list->arr[prolog].args[0].symnode;
+
+	int quad_count = epilog - prolog + 1;
+	graph->block_of = (int *)malloc(quad_count * sizeof(int));
+	assert(graph->block_of);
+
+	/*
+	 * find leaders and assign every quad to a block
+	 */
+	int block_count = 0;
+	int label_count = 0;
+	for (int i = prolog; i <= epilog; i++) {
+		quad * q = &quad_list->arr[i];
+
+		int leader = (i == prolog) || (q->op == LABEL_Q) || ends_block(quad_list->arr[i - 1].op);
+
+		/* consecutive labels share a block */
+		if (leader && i > prolog && q->op == LABEL_Q && quad_list->arr[i - 1].op == LABEL_Q)
+			leader = 0;
+
+		if (leader)
+			block_count++;
+		if (q->op == LABEL_Q)
+			label_count++;
+
+		graph->block_of[i - prolog] = block_count - 1;
+	}
+
+	graph->block_count = block_count;
+	graph->blocks = (basic_block *)calloc(block_count, sizeof(basic_block));
+	assert(graph->blocks);
+
+	label_block * labels = (label_block *)malloc((label_count + 1) * sizeof(label_block));
+	assert(labels);
+	label_count = 0;
+
+	for (int i = prolog; i <= epilog; i++) {
+		basic_block * b = &graph->blocks[graph->block_of[i - prolog]];
+
+		if (i == prolog || graph->block_of[i - prolog - 1] != graph->block_of[i - prolog]) {
+			b->id = graph->block_of[i - prolog];
+			b->first = i;
+			b->succs = (int *)malloc(2 * sizeof(int));
+			b->pred_size = INIT_PRED_COUNT;
+			b->preds = (int *)malloc(b->pred_size * sizeof(int));
+			assert(b->succs && b->preds);
+		}
+		b->last = i;
+
+		if (quad_list->arr[i].op == LABEL_Q) {
+			labels[label_count].label = quad_list->arr[i].args[0].label;
+			labels[label_count].block = b->id;
+			label_count++;
+		}
+
+		if (quad_list->arr[i].op == EPILOG_Q)
+			graph->exit_block = b->id;
+	}
+
+	qsort(labels, label_count, sizeof(label_block), compare_label_block);
+
+	/*
+	 * connect blocks
+	 */
+	for (int id = 0; id < block_count; id++) {
+		basic_block * b = &graph->blocks[id];
+		quad * last = &quad_list->arr[b->last];
+
+		if (last->op == GOTO_Q || last->op == IFFALSE_Q || last->op == IFTRUE_Q) {
+			quad_arg * target = (last->op == GOTO_Q) ? &last->args[0] : &last->args[1];
+			int target_block = lookup_label_block(labels, label_count, target->label);
+
+			if (target_block == NO_BLOCK) {
+				fprintf(stderr, "cfg: jump to unknown label %s in quad %d\n", target->label, last->number);
+				exit(1);
+			}
+			add_edge(graph, id, target_block);
+		}
+
+		if (last->op != GOTO_Q && id != graph->exit_block && id + 1 < block_count)
+			add_edge(graph, id, id + 1);
+	}
+
+	free(labels);
+
+	compute_reverse_postorder(graph);
+
+	return graph;
+}
+
+cfg_list * build_cfg_list() {
+	cfg_list * graphs = (cfg_list *)calloc(1, sizeof(cfg_list));
+	assert(graphs);
+	graphs->size = INIT_CFG_LIST_SIZE;
+	graphs->arr = (cfg **)calloc(graphs->size, sizeof(cfg *));
+	assert(graphs->arr);
+
+	if (!quad_list)
+		return graphs;
+
+	for (int i = 0; i < quad_list->count; i++) {
+		if (quad_list->arr[i].op != PROLOG_Q)
+			continue;
+
+		int prolog = i;
+		while (i < quad_list->count && quad_list->arr[i].op != EPILOG_Q)
+			i++;
+
+		if (i == quad_list->count)
+			break;
+
+		if (graphs->count == graphs->size) {
+			graphs->size *= 2;
+			graphs->arr = realloc(graphs->arr, graphs->size * sizeof(cfg *));
+			assert(graphs->arr);
+		}
+		graphs->arr[graphs->count++] = build_cfg(prolog, i);
+	}
+
+	return graphs;
+}
+
+int get_block_of_quad(cfg * graph, int index) {
+	if (!graph || index < graph->prolog || index > graph->epilog)
+		return NO_BLOCK;
+	return graph->block_of[index - graph->prolog];
+}
+
+int find_label_quad(char * label, int prolog, int epilog) {
+	if (!label)
+		return -1;
+
+	for (int i = prolog; i <= epilog; i++) {
+		quad * q = &quad_list->arr[i];
+		if (q->op == LABEL_Q && q->args[0].label == label)
+			return i;
+	}
+	return -1;
+}
+
+void print_cfg(FILE * fp, cfg * graph) {
+	if (!graph)
+		return;
+
+	fprintf(fp, "function %s: %d blocks (quads %d - %d)\n",
+		graph->function ? graph->function->name : "?", graph->block_count, graph->prolog, graph->epilog);
+
+	for (int id = 0; id < graph->block_count; id++) {
+		basic_block * b = &graph->blocks[id];
+
+		fprintf(fp, "  B%d [quads %d - %d] preds:", id, b->first, b->last);
+		for (int p = 0; p < b->pred_count; p++)
+			fprintf(fp, " B%d", b->preds[p]);
+
+		fprintf(fp, "  succs:");
+		for (int s = 0; s < b->succ_count; s++)
+			fprintf(fp, " B%d", b->succs[s]);
+		fprintf(fp, "\n");
+	}
+}
+
+void print_cfg_list(FILE * fp, cfg_list * graphs) {
+	if (!graphs)
+		return;
+
+	for (int i = 0; i < graphs->count; i++)
+		print_cfg(fp, graphs->arr[i]);
+}
+
+void destroy_cfg(cfg * graph) {
+	if (!graph)
+		return;
+
+	for (int id = 0; id < graph->block_count; id++) {
+		free(graph->blocks[id].succs);
+		free(graph->blocks[id].preds);
+	}
+	free(graph->blocks);
+	free(graph->block_of);
+	free(graph->rpo);
+	free(graph);
+}
+
+void destroy_cfg_list(cfg_list * graphs) {
+	if (!graphs)
+		return;
+
+	for (int i = 0; i < graphs->count; i++)
+		destroy_cfg(graphs->arr[i]);
+	free(graphs->arr);
+	free(graphs);
+}
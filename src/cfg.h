@@ -0,0 +1,93 @@
+/*
+ * cfg.h
+ *
+ * control flow graph over the quads of each function
+ * Yondon Fu and Matt McFarland - Delights (CS57 - 16W)
+ */
+
+#ifndef _CFG_H
+#define _CFG_H
+
+#include <stdio.h>
+#include "quad.h"
+
+#define NO_BLOCK -1
+
+/*
+ * maximal run of quads that is only entered at its first quad and only
+ * left after its last quad
+ */
+typedef struct basic_block {
+	int id; 				// index into the owning cfg's blocks
+	int first; 				// quad_list index of first quad
+	int last; 				// quad_list index of last quad (inclusive)
+
+	int * succs; 			// successor block ids (at most 2 -- branch target, fall through)
+	int succ_count;
+	int * preds; 			// predecessor block ids
+	int pred_count;
+	int pred_size;
+} basic_block;
+
+/*
+ * control flow graph for the function whose quads are in [prolog, epilog].
+ * block 0 is the entry block (starts with PROLOG_Q), and the block ending
+ * with EPILOG_Q is the exit block.
+ */
+typedef struct cfg {
+	symnode_t * function; 	// function symbol from the PROLOG_Q
+	int prolog; 			// quad_list index of PROLOG_Q
+	int epilog; 			// quad_list index of EPILOG_Q
+
+	basic_block * blocks;
+	int block_count;
+	int exit_block;
+
+	int * block_of; 		// block id of quad (indexed by quad index - prolog)
+	int * rpo; 				// reachable blocks in reverse postorder
+	int rpo_count;
+} cfg;
+
+/*
+ * one cfg per function in the global quad_list, in program order
+ */
+typedef struct cfg_list {
+	cfg ** arr;
+	int count;
+	int size;
+} cfg_list;
+
+/*
+ * builds the cfg of the function whose quads are in [prolog, epilog].
+ * blocks are split before every LABEL_Q and after every GOTO_Q, IFFALSE_Q,
+ * IFTRUE_Q and RET_Q.
+ */
+cfg * build_cfg(int prolog, int epilog);
+
+/*
+ * builds a cfg for every function in the global quad_list
+ */
+cfg_list * build_cfg_list();
+
+/*
+ * returns the block containing the quad at quad_list index, or NO_BLOCK
+ */
+int get_block_of_quad(cfg * graph, int index);
+
+/*
+ * returns quad_list index of the LABEL_Q defining label in [prolog, epilog], or -1
+ */
+int find_label_quad(char * label, int prolog, int epilog);
+
+/*
+ * prints blocks with their quads and edges
+ */
+void print_cfg(FILE * fp, cfg * graph);
+
+void print_cfg_list(FILE * fp, cfg_list * graphs);
+
+void destroy_cfg(cfg * graph);
+
+void destroy_cfg_list(cfg_list * graphs);
+
+#endif 	// _CFG_H
@@ -338,7 +338,7 @@ int check_var_node(ast_node root) {
 	assert(root);
 
 	char * sym_name = root->left_child->value_string;
-	symnode_t * sym_n = find_symnode(root->scope_table, sym_name);
+	symnode_t * sym_n = resolve_identifier(root->left_child);
 
 	/* find symbol */
 	if (!sym_n) {
@@ -551,7 +551,7 @@ int check_call(ast_node root) {
 int check_sizeof(ast_node root) {
 
 	ast_node var = root->left_child;
-	symnode_t * sym = find_symnode(var->scope_table, var->left_child->value_string);
+	symnode_t * sym = resolve_identifier(var->left_child);
 	if (!sym) {
 		fprintf(stderr,"Invalid \'sizeof()\' call. Couldn't find symbol %s\n.",root->left_child->value_string);
 		return 1;
@@ -0,0 +1,317 @@
+/*
+ * const_fold.c
+ *
+ * constant folding and (block local) constant propagation over quads.
+ *
+ * Each function's basic blocks are walked in order while a table maps every
+ * temp and scalar local/parameter to the literal it is known to hold. Known
+ * operands are swapped for literals, quads whose operands are all literals
+ * are evaluated at compile time, and conditional jumps on literals are
+ * resolved. Knowledge is dropped at the start of every block. Globals are
+ * never tracked since any call could change them.
+ *
+ * Yondon Fu and Matt McFarland - Delights (CS57 - 16W)
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <limits.h>
+#include <assert.h>
+
+#include "const_fold.h"
+#include "cfg.h"
+#include "liveness.h" 	// for get_local_scalar()
+#include "IR_gen.h"
+#include "symtab.h"
+
+extern quad_arr * quad_list;
+
+/*
+ * variable -> known literal, open addressing keyed on the symnode.
+ * entries from an older generation are empty, so the whole table is
+ * forgotten by bumping gen.
+ */
+typedef struct const_entry {
+	symnode_t * var;
+	int value;
+	int known; 		// 0 if var was written with something unknown
+	int gen;
+} const_entry;
+
+typedef struct const_table {
+	const_entry * arr;
+	int size; 		// power of 2
+	int gen;
+} const_table;
+
+static void init_const_table(const_table * table, int quad_count) {
+	table->size = 16;
+	while (table->size < quad_count * QUAD_ARG_NUM * 2)
+		table->size *= 2;
+
+	table->arr = (const_entry *)calloc(table->size, sizeof(const_entry));
+	assert(table->arr);
+	table->gen = 1;
+}
+
+static const_entry * find_entry(const_table * table, symnode_t * var) {
+	unsigned long h = ((unsigned long)var >> 4) & (table->size - 1);
+
+	while (table->arr[h].gen == table->gen && table->arr[h].var != var)
+		h = (h + 1) & (table->size - 1);
+
+	return &table->arr[h];
+}
+
+static void set_known(const_table * table, symnode_t * var, int value, int known) {
+	const_entry * e = find_entry(table, var);
+	e->var = var;
+	e->gen = table->gen;
+	e->value = value;
+	e->known = known;
+}
+
+static int get_known(const_table * table, symnode_t * var, int * value) {
+	const_entry * e = find_entry(table, var);
+	if (e->gen != table->gen || !e->known)
+		return 0;
+
+	*value = e->value;
+	return 1;
+}
+
+static quad_arg new_literal(int value) {
+	quad_arg lit = { .type = INT_LITERAL_Q_ARG, .int_literal = value };
+	return lit;
+}
+
+static int is_literal(quad_arg * arg) {
+	return arg && arg->type == INT_LITERAL_Q_ARG;
+}
+
+/*
+ * replaces arg (in place) with a literal if its value is known
+ */
+static int propagate_arg(const_table * table, quad_arg * arg) {
+	symnode_t * var = get_local_scalar(arg);
+	int value;
+
+	if (var && get_known(table, var, &value)) {
+		*arg = new_literal(value);
+		return 1;
+	}
+	return 0;
+}
+
+int eval_binary_op(quad_op op, int a, int b, int * result) {
+	switch (op) {
+		case ADD_Q: *result = (int)((unsigned)a + (unsigned)b); return 1;
+		case SUB_Q: *result = (int)((unsigned)a - (unsigned)b); return 1;
+		case MUL_Q: *result = (int)((unsigned)a * (unsigned)b); return 1;
+		case DIV_Q:
+		case MOD_Q:
+			if (b == 0 || (a == INT_MIN && b == -1))
+				return 0; 		// leave runtime behaviour alone
+			*result = (op == DIV_Q) ? a / b : a % b;
+			return 1;
+		case LT_Q: *result = a < b; return 1;
+		case GT_Q: *result = a > b; return 1;
+		case LTE_Q: *result = a <= b; return 1;
+		case GTE_Q: *result = a >= b; return 1;
+		case NE_Q: *result = a != b; return 1;
+		case EQ_Q: *result = a == b; return 1;
+		default:
+			return 0;
+	}
+}
+
+int is_binary_op(quad_op op) {
+	switch (op) {
+		case ADD_Q: case SUB_Q: case MUL_Q: case DIV_Q: case MOD_Q:
+		case LT_Q: case GT_Q: case LTE_Q: case GTE_Q: case NE_Q: case EQ_Q:
+			return 1;
+		default:
+			return 0;
+	}
+}
+
+int eval_sizeof(quad_arg * of) {
+	if (of->type == SYMBOL_ARR_Q_ARG && of->int_literal != PASS_ARR_POINTER)
+		return TYPE_SIZE(of->symnode->s.v.type);
+	return of->symnode->s.v.byte_size;
+}
+
+/*
+ * turns q into "args[0] = value"
+ */
+static void make_assign(quad * q, int value) {
+	q->op = ASSIGN_Q;
+	q->args[1] = new_literal(value);
+	q->args[2] = NULL_QUAD_ARG;
+}
+
+/*
+ * folds one quad, updating what we know about the variables it writes.
+ * returns 1 if the quad changed.
+ */
+static int fold_quad(const_table * table, quad * q, char * removed) {
+	int changed = 0;
+	int value;
+
+	/*
+	 * swap known operands for literals
+	 */
+	switch (q->op) {
+		case ADD_Q: case SUB_Q: case MUL_Q: case DIV_Q: case MOD_Q:
+		case LT_Q: case GT_Q: case LTE_Q: case GTE_Q: case NE_Q: case EQ_Q:
+			changed |= propagate_arg(table, &q->args[2]);
+			/* fall through */
+		case NOT_Q:
+		case NEG_Q:
+		case ASSIGN_Q:
+			changed |= propagate_arg(table, &q->args[1]);
+			break;
+
+		case IFFALSE_Q:
+		case IFTRUE_Q:
+		case PARAM_Q:
+		case RET_Q:
+		case PRINT_Q:
+			changed |= propagate_arg(table, &q->args[0]);
+			break;
+
+		default:
+			break;
+	}
+
+	/*
+	 * evaluate
+	 */
+	if (is_binary_op(q->op) && is_literal(&q->args[1]) && is_literal(&q->args[2])) {
+		if (eval_binary_op(q->op, q->args[1].int_literal, q->args[2].int_literal, &value)) {
+			make_assign(q, value);
+			changed = 1;
+		}
+
+	} else if (q->op == NOT_Q && is_literal(&q->args[1])) {
+		make_assign(q, !q->args[1].int_literal);
+		changed = 1;
+
+	} else if (q->op == NEG_Q && is_literal(&q->args[1])) {
+		make_assign(q, (int)(0u - (unsigned)q->args[1].int_literal));
+		changed = 1;
+
+	} else if (q->op == SIZEOF_Q) {
+		make_assign(q, eval_sizeof(&q->args[1]));
+		changed = 1;
+
+	} else if ((q->op == IFFALSE_Q || q->op == IFTRUE_Q) && is_literal(&q->args[0])) {
+		int taken = (q->op == IFFALSE_Q) ? (q->args[0].int_literal == 0) : (q->args[0].int_literal != 0);
+
+		if (taken) {
+			q->op = GOTO_Q;
+			q->args[0] = q->args[1];
+			q->args[1] = NULL_QUAD_ARG;
+		} else {
+			removed[q->number] = 1;
+		}
+		changed = 1;
+	}
+
+	/*
+	 * record what the quad writes
+	 */
+	symnode_t * dest = get_local_scalar(&q->args[0]);
+	symnode_t * src;
+
+	switch (q->op) {
+		case ASSIGN_Q:
+			if (dest)
+				set_known(table, dest, is_literal(&q->args[1]) ? q->args[1].int_literal : 0, is_literal(&q->args[1]));
+			break;
+
+		case PRE_INC_Q:
+		case PRE_DEC_Q:
+		case POST_INC_Q:
+		case POST_DEC_Q:
+			src = get_local_scalar(&q->args[1]);
+			if (src && get_known(table, src, &value)) {
+				int step = q->args[2].int_literal;
+				int updated = (q->op == PRE_INC_Q || q->op == POST_INC_Q) ? value + step : value - step;
+				int result = (q->op == PRE_INC_Q || q->op == PRE_DEC_Q) ? updated : value;
+
+				set_known(table, src, updated, 1);
+				if (dest)
+					set_known(table, dest, result, 1);
+			} else {
+				if (src)
+					set_known(table, src, 0, 0);
+				if (dest)
+					set_known(table, dest, 0, 0);
+			}
+			break;
+
+		case ADD_Q: case SUB_Q: case MUL_Q: case DIV_Q: case MOD_Q:
+		case LT_Q: case GT_Q: case LTE_Q: case GTE_Q: case NE_Q: case EQ_Q:
+		case NOT_Q:
+		case NEG_Q:
+		case READ_Q:
+			if (dest)
+				set_known(table, dest, 0, 0);
+			break;
+
+		default:
+			break;
+	}
+
+	return changed;
+}
+
+int fold_function_constants(int prolog, int epilog, char * removed) {
+	cfg * graph = build_cfg(prolog, epilog);
+	if (!graph)
+		return 0;
+
+	const_table table;
+	init_const_table(&table, epilog - prolog + 1);
+
+	int folded = 0;
+	for (int id = 0; id < graph->block_count; id++) {
+		basic_block * b = &graph->blocks[id];
+
+		/* forget everything at block boundaries */
+		table.gen++;
+
+		for (int i = b->first; i <= b->last; i++)
+			folded += fold_quad(&table, &quad_list->arr[i], removed);
+	}
+
+	free(table.arr);
+	destroy_cfg(graph);
+	return folded;
+}
+
+int fold_constants() {
+	if (!quad_list)
+		return 0;
+
+	char * removed = (char *)calloc(quad_list->count + 1, sizeof(char));
+	assert(removed);
+
+	int folded = 0;
+	for (int i = 0; i < quad_list->count; i++) {
+		if (quad_list->arr[i].op != PROLOG_Q)
+			continue;
+
+		int prolog = i;
+		while (i < quad_list->count && quad_list->arr[i].op != EPILOG_Q)
+			i++;
+
+		if (i < quad_list->count)
+			folded += fold_function_constants(prolog, i, removed);
+	}
+
+	remove_quads(removed);
+	free(removed);
+	return folded;
+}
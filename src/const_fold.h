@@ -0,0 +1,51 @@
+/*
+ * const_fold.h
+ *
+ * constant folding and propagation over the quad list
+ * Yondon Fu and Matt McFarland - Delights (CS57 - 16W)
+ */
+
+#ifndef _CONST_FOLD_H
+#define _CONST_FOLD_H
+
+#include "quad.h"
+
+/*
+ * runs constant folding and propagation over every function in the global
+ * quad_list. call between CG() and create_ys().
+ *
+ * - temps and scalar locals/parameters assigned a literal are replaced by
+ *   that literal in the quads that read them, up to the end of the basic block
+ * - arithmetic, comparisons, not, negation and sizeof on literals become an
+ *   ASSIGN_Q of the result
+ * - IFFALSE_Q / IFTRUE_Q on a literal become a GOTO_Q or are removed
+ *
+ * returns the number of quads folded or removed
+ */
+int fold_constants();
+
+/*
+ * folds the function whose quads are in [prolog, epilog]. quads to delete
+ * are flagged in removed[] (indexed like quad_list->arr).
+ */
+int fold_function_constants(int prolog, int epilog, char * removed);
+
+/*
+ * evaluates a binary quad on literals. returns 0 if it can't be folded
+ * (division by zero, INT_MIN / -1). 32 bit wrap around is done in unsigned
+ * arithmetic, like the target.
+ */
+int eval_binary_op(quad_op op, int a, int b, int * result);
+
+/*
+ * arithmetic or comparison quad reading args[1] and args[2]
+ */
+int is_binary_op(quad_op op);
+
+/*
+ * bytes sizeof(of) evaluates to -- an element for an indexed array, the
+ * whole variable otherwise
+ */
+int eval_sizeof(quad_arg * of);
+
+#endif 	// _CONST_FOLD_H
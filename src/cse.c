@@ -0,0 +1,395 @@
+/*
+ * cse.c
+ *
+ * common subexpression elimination on SSA form by value numbering.
+ *
+ * CG makes a fresh temp and a fresh computation for every occurrence of an
+ * expression, so a[i] = a[i] + b[i] * b[i] copies i into an index temp four
+ * times. A version never changes once defined, so two quads applying the
+ * same operator to the same operands compute the same value, and the later
+ * one can go if the earlier one's block dominates it -- local value
+ * numbering carried down the dominator tree. Reads of the removed result
+ * are renamed to the earlier one in a final sweep.
+ *
+ * Globals and array elements are memory, not versions. A value read from
+ * one is only reused in the same block and is forgotten at a store that
+ * could change it or a call. Array stores forget every element, since a
+ * parameter array can be any array. Copies of a literal are left be --
+ * reusing one would keep the constant in a register to save an irmovl that
+ * costs what the rrmovl out of the register does.
+ *
+ * Yondon Fu and Matt McFarland - Delights (CS57 - 16W)
+ */
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <assert.h>
+
+#include "cse.h"
+#include "const_fold.h" 	// for is_binary_op()
+#include "liveness.h" 		// for get_local_scalar(), get_quad_def_args()
+#include "IR_gen.h" 		// for PASS_ARR_POINTER
+#include "symtab.h"
+
+#define INIT_ENTRY_COUNT 64
+
+#define NOT_NUMBERED 0 		// operand kinds
+#define PURE_OPERAND 1
+#define MEMORY_OPERAND 2
+
+/* value args[0] op args[1] is held by version value */
+typedef struct vn_entry {
+	quad_op op;
+	quad_arg args[2];
+	quad_arg value; 		// NULL_ARG once forgotten
+	int block;
+	int memory; 			// reads a global or an array element -- only valid in its block
+	int next; 				// next entry in its hash chain, -1 at the end
+} vn_entry;
+
+typedef struct cse_state {
+	ssa_function * fn;
+
+	vn_entry * entries;
+	int entry_count;
+	int entry_size;
+	int * heads; 			// hash -> first entry, -1 if none
+	int head_mask;
+	int block_first; 		// first entry made in the current block
+
+	temp_var ** replaced; 	// by temp id: version the temp's reads now read
+	char * index_use; 		// by temp id: read as an array index
+	int temp_size;
+} cse_state;
+
+static int operand_kind(quad_arg * arg) {
+	switch (arg->type) {
+		case INT_LITERAL_Q_ARG:
+		case TEMP_VAR_Q_ARG:
+			return PURE_OPERAND;
+
+		case SYMBOL_VAR_Q_ARG:
+			if (get_local_scalar(arg))
+				return PURE_OPERAND; 		// value on entry -- every write is to a version
+			if (arg->symnode && arg->symnode->sym_type == VAR_SYM && arg->symnode->s.v.modifier == SINGLE_DT)
+				return MEMORY_OPERAND;
+			return NOT_NUMBERED;
+
+		case SYMBOL_ARR_Q_ARG:
+			if (arg->int_literal == PASS_ARR_POINTER)
+				return PURE_OPERAND; 		// the array's address
+			return arg->temp ? MEMORY_OPERAND : NOT_NUMBERED;
+
+		default:
+			return NOT_NUMBERED;
+	}
+}
+
+static temp_var * replacement(cse_state * state, temp_var * t) {
+	while (t->id < state->temp_size && state->replaced[t->id])
+		t = state->replaced[t->id];
+	return t;
+}
+
+/* arg with the temps it reads renamed */
+static quad_arg canonical(cse_state * state, quad_arg * arg) {
+	quad_arg c = *arg;
+	if (c.type == TEMP_VAR_Q_ARG || (c.type == SYMBOL_ARR_Q_ARG && c.temp && c.int_literal != PASS_ARR_POINTER))
+		c.temp = replacement(state, c.temp);
+	return c;
+}
+
+static int same_operand(quad_arg * a, quad_arg * b) {
+	if (a->type != b->type)
+		return 0;
+
+	switch (a->type) {
+		case INT_LITERAL_Q_ARG:
+			return a->int_literal == b->int_literal;
+		case TEMP_VAR_Q_ARG:
+			return a->temp == b->temp;
+		case SYMBOL_VAR_Q_ARG:
+			return a->symnode == b->symnode;
+		case SYMBOL_ARR_Q_ARG:
+			return a->symnode == b->symnode && a->temp == b->temp && a->int_literal == b->int_literal;
+		default:
+			return a->type == NULL_ARG;
+	}
+}
+
+static unsigned hash_operand(quad_arg * arg) {
+	switch (arg->type) {
+		case INT_LITERAL_Q_ARG:
+			return (unsigned)arg->int_literal * 2654435761u;
+		case TEMP_VAR_Q_ARG:
+			return (unsigned)arg->temp->id * 40503u + 1;
+		case SYMBOL_VAR_Q_ARG:
+			return (unsigned)((uintptr_t)arg->symnode >> 4);
+		case SYMBOL_ARR_Q_ARG:
+			return (unsigned)((uintptr_t)arg->symnode >> 4) ^ (arg->temp ? (unsigned)arg->temp->id * 40503u : 0u) ^
+				(unsigned)arg->int_literal;
+		default:
+			return 0;
+	}
+}
+
+/* the same for a op b and b op a if op commutes */
+static unsigned hash_key(quad_op op, quad_arg * a, quad_arg * b) {
+	return ((unsigned)op * 31u + (hash_operand(a) ^ hash_operand(b))) & 0x7fffffff;
+}
+
+static int commutes(quad_op op) {
+	return op == ADD_Q || op == MUL_Q || op == EQ_Q || op == NE_Q;
+}
+
+static int is_usable(cse_state * state, int e, int block) {
+	vn_entry * entry = &state->entries[e];
+	if (entry->value.type == NULL_ARG)
+		return 0;
+	if (entry->memory)
+		return e >= state->block_first;
+	return ssa_dominates(state->fn, entry->block, block);
+}
+
+static vn_entry * find_entry(cse_state * state, quad_op op, quad_arg * a, quad_arg * b, int block) {
+	for (int e = state->heads[hash_key(op, a, b) & state->head_mask]; e != -1; e = state->entries[e].next) {
+		vn_entry * entry = &state->entries[e];
+		if (entry->op != op || !is_usable(state, e, block))
+			continue;
+		if (same_operand(&entry->args[0], a) && same_operand(&entry->args[1], b))
+			return entry;
+		if (commutes(op) && same_operand(&entry->args[0], b) && same_operand(&entry->args[1], a))
+			return entry;
+	}
+	return NULL;
+}
+
+static void add_entry(cse_state * state, quad_op op, quad_arg * a, quad_arg * b, quad_arg * value,
+	int block, int memory) {
+	if (state->entry_count == state->entry_size) {
+		state->entry_size *= 2;
+		state->entries = realloc(state->entries, state->entry_size * sizeof(vn_entry));
+		assert(state->entries);
+	}
+
+	unsigned slot = hash_key(op, a, b) & state->head_mask;
+	vn_entry * entry = &state->entries[state->entry_count];
+	entry->op = op;
+	entry->args[0] = *a;
+	entry->args[1] = *b;
+	entry->value = *value;
+	entry->block = block;
+	entry->memory = memory;
+	entry->next = state->heads[slot];
+	state->heads[slot] = state->entry_count++;
+}
+
+static int reads_global(vn_entry * entry, symnode_t * global) {
+	for (int i = 0; i < 2; i++) {
+		if (entry->args[i].type == SYMBOL_VAR_Q_ARG && entry->args[i].symnode == global)
+			return 1;
+	}
+	return 0;
+}
+
+static int reads_element(vn_entry * entry) {
+	for (int i = 0; i < 2; i++) {
+		if (entry->args[i].type == SYMBOL_ARR_Q_ARG && entry->args[i].int_literal != PASS_ARR_POINTER)
+			return 1;
+	}
+	return 0;
+}
+
+/*
+ * forgets the values read from global (any element if global is NULL and
+ * elements is set, all memory if neither)
+ */
+static void forget_memory(cse_state * state, symnode_t * global, int elements) {
+	for (int e = state->block_first; e < state->entry_count; e++) {
+		vn_entry * entry = &state->entries[e];
+		if (!entry->memory)
+			continue;
+		if ((global && reads_global(entry, global)) || (elements && reads_element(entry)) || (!global && !elements))
+			entry->value = NULL_QUAD_ARG;
+	}
+}
+
+/* can reads of version d read r instead? */
+static int can_replace(cse_state * state, quad_arg * d, quad_arg * r) {
+	if (r->type != TEMP_VAR_Q_ARG || r->temp == d->temp)
+		return 0;
+	if (d->temp->id >= state->temp_size || !state->index_use[d->temp->id])
+		return 1;
+
+	/* an index needs a temp, and a version of a variable goes back to being the variable */
+	return !is_version(state->fn, r) || state->fn->origin[r->temp->id].type == TEMP_VAR_Q_ARG;
+}
+
+/* is q a compare the quad after it jumps on? the two are fused */
+static int feeds_jump(ssa_block * b, int pos) {
+	quad * q = &b->quads[pos];
+	if (q->op != LT_Q && q->op != GT_Q && q->op != LTE_Q && q->op != GTE_Q && q->op != NE_Q && q->op != EQ_Q)
+		return 0;
+	if (pos + 1 == b->quad_count)
+		return 0;
+
+	quad * next = &b->quads[pos + 1];
+	return (next->op == IFFALSE_Q || next->op == IFTRUE_Q) && next->args[0].type == TEMP_VAR_Q_ARG &&
+		next->args[0].temp == q->args[0].temp;
+}
+
+/* does the quad at pos in b repeat a value already held? removes it if so */
+static int number_quad(cse_state * state, ssa_block * b, int pos) {
+	quad * q = &b->quads[pos];
+	quad_arg * d = &q->args[0];
+
+	if (!is_binary_op(q->op) && q->op != NOT_Q && q->op != NEG_Q && q->op != ASSIGN_Q)
+		return 0;
+	if (!is_version(state->fn, d) || feeds_jump(b, pos))
+		return 0;
+	if (q->op == ASSIGN_Q && q->args[1].type == INT_LITERAL_Q_ARG)
+		return 0;
+
+	quad_arg a = canonical(state, &q->args[1]);
+	quad_arg c = (q->op == ASSIGN_Q || q->op == NOT_Q || q->op == NEG_Q) ? NULL_QUAD_ARG : canonical(state, &q->args[2]);
+
+	int kind_a = operand_kind(&a);
+	int kind_c = (c.type == NULL_ARG) ? PURE_OPERAND : operand_kind(&c);
+	if (kind_a == NOT_NUMBERED || kind_c == NOT_NUMBERED)
+		return 0;
+
+	/* a copy of a temp: read the source instead */
+	quad_arg * r = NULL;
+	if (q->op == ASSIGN_Q && can_replace(state, d, &a))
+		r = &a;
+
+	vn_entry * entry = NULL;
+	if (!r) {
+		entry = find_entry(state, q->op, &a, &c, b->id);
+		if (entry && can_replace(state, d, &entry->value))
+			r = &entry->value;
+	}
+
+	if (r) {
+		state->replaced[d->temp->id] = r->temp;
+		ssa_remove_quad(b, pos);
+		return 1;
+	}
+
+	if (!entry) {
+		int memory = (kind_a == MEMORY_OPERAND || kind_c == MEMORY_OPERAND);
+		add_entry(state, q->op, &a, &c, d, b->id, memory);
+	}
+	return 0;
+}
+
+/* forgets what a store or call at q changes; a stored temp reads back as itself */
+static void record_stores(cse_state * state, quad * q, int block) {
+	if (q->op == PRECALL_Q) {
+		forget_memory(state, NULL, 0);
+		return;
+	}
+
+	quad_arg * defs[MAX_QUAD_REFS];
+	int count = get_quad_def_args(q, defs);
+	for (int i = 0; i < count; i++) {
+		if (defs[i]->type == SYMBOL_ARR_Q_ARG)
+			forget_memory(state, NULL, 1);
+		else if (defs[i]->type == SYMBOL_VAR_Q_ARG && operand_kind(defs[i]) == MEMORY_OPERAND)
+			forget_memory(state, defs[i]->symnode, 0);
+	}
+
+	if (q->op == ASSIGN_Q && operand_kind(&q->args[0]) == MEMORY_OPERAND) {
+		quad_arg location = canonical(state, &q->args[0]);
+		quad_arg value = canonical(state, &q->args[1]);
+		quad_arg none = NULL_QUAD_ARG;
+		if (value.type == TEMP_VAR_Q_ARG)
+			add_entry(state, ASSIGN_Q, &location, &none, &value, block, 1);
+	}
+}
+
+static void rename_reads(cse_state * state) {
+	ssa_function * fn = state->fn;
+
+	for (int r = 0; r < fn->rpo_count; r++) {
+		ssa_block * b = &fn->blocks[fn->rpo[r]];
+
+		for (int j = 0; j < b->phi_count; j++) {
+			for (int k = 0; k < b->pred_count; k++) {
+				if (b->phis[j].args[k].type == TEMP_VAR_Q_ARG)
+					b->phis[j].args[k].temp = replacement(state, b->phis[j].args[k].temp);
+			}
+		}
+
+		/* a removed quad's result is never written again, so this only touches reads */
+		for (int i = 0; i < b->quad_count; i++) {
+			for (int a = 0; a < QUAD_ARG_NUM; a++)
+				b->quads[i].args[a] = canonical(state, &b->quads[i].args[a]);
+		}
+	}
+}
+
+static int number_function(ssa_function * fn) {
+	cse_state state = { .fn = fn };
+
+	int quad_count = 0;
+	for (int r = 0; r < fn->rpo_count; r++)
+		quad_count += fn->blocks[fn->rpo[r]].quad_count;
+
+	state.entry_size = INIT_ENTRY_COUNT;
+	state.entries = (vn_entry *)malloc(state.entry_size * sizeof(vn_entry));
+	int heads = INIT_ENTRY_COUNT;
+	while (heads < quad_count)
+		heads *= 2;
+	state.heads = (int *)malloc(heads * sizeof(int));
+	state.head_mask = heads - 1;
+	state.temp_size = fn->origin_size;
+	state.replaced = (temp_var **)calloc(state.temp_size + 1, sizeof(temp_var *));
+	state.index_use = (char *)calloc(state.temp_size + 1, sizeof(char));
+	assert(state.entries && state.heads && state.replaced && state.index_use);
+	for (int i = 0; i < heads; i++)
+		state.heads[i] = -1;
+
+	for (int r = 0; r < fn->rpo_count; r++) {
+		ssa_block * b = &fn->blocks[fn->rpo[r]];
+		for (int i = 0; i < b->quad_count; i++) {
+			for (int a = 0; a < QUAD_ARG_NUM; a++) {
+				quad_arg * arg = &b->quads[i].args[a];
+				if (arg->type == SYMBOL_ARR_Q_ARG && arg->temp && arg->int_literal != PASS_ARR_POINTER &&
+					arg->temp->id < state.temp_size)
+					state.index_use[arg->temp->id] = 1;
+			}
+		}
+	}
+
+	int removed = 0;
+	for (int r = 0; r < fn->rpo_count; r++) {
+		ssa_block * b = &fn->blocks[fn->rpo[r]];
+		state.block_first = state.entry_count;
+
+		for (int pos = ssa_block_start(b); pos < b->quad_count; pos++) {
+			if (number_quad(&state, b, pos)) {
+				removed++;
+				pos--;
+				continue;
+			}
+			record_stores(&state, &b->quads[pos], b->id);
+		}
+	}
+
+	if (removed)
+		rename_reads(&state);
+
+	free(state.entries);
+	free(state.heads);
+	free(state.replaced);
+	free(state.index_use);
+	return removed;
+}
+
+int eliminate_common_subexpressions(ssa_program * prog) {
+	int removed = 0;
+	for (int f = 0; f < prog->function_count; f++)
+		removed += number_function(prog->functions[f]);
+	return removed;
+}
@@ -0,0 +1,33 @@
+/*
+ * cse.h
+ *
+ * common subexpression elimination by value numbering over SSA form
+ * Yondon Fu and Matt McFarland - Delights (CS57 - 16W)
+ */
+
+#ifndef _CSE_H
+#define _CSE_H
+
+#include "ssa.h"
+
+/*
+ * numbers the values quads compute, visiting blocks in reverse postorder,
+ * and removes a quad whose value an earlier one already holds:
+ *
+ * - a copy of a temp goes away and reads of its result read the source
+ * - arithmetic, NOT_Q / NEG_Q and compares (not the ones a jump right after
+ *   tests) with the same operator and operands reuse the earlier result if
+ *   its block dominates theirs
+ * - a load of a global or an array element, or arithmetic reading one,
+ *   is only reused within its block, until a store to that global, to any
+ *   array element or a call. storing a temp makes the stored location read
+ *   back as that temp.
+ *
+ * an array index keeps its temp: it's only replaced with a version that
+ * stays a temp out of SSA form. copies of a literal are left alone.
+ *
+ * returns the number of quads removed
+ */
+int eliminate_common_subexpressions(ssa_program * prog);
+
+#endif 	// _CSE_H
@@ -0,0 +1,154 @@
+/*
+ * dead_code.c
+ *
+ * removes code that can't affect the program's output:
+ *  - blocks the function entry can't reach (e.g. code after a return's
+ *    GOTO_Q to the epilog)
+ *  - quads that only compute temps or scalar locals that are never read
+ *    again (e.g. the temp of an expression statement, or the ASSIGN_Q of
+ *    a call's return value when the call is a statement)
+ *
+ * Yondon Fu and Matt McFarland - Delights (CS57 - 16W)
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "dead_code.h"
+#include "IR_gen.h"
+
+extern quad_arr * quad_list;
+
+int mark_unreachable_blocks(cfg * graph, char * removed) {
+	char * reachable = (char *)calloc(graph->block_count, sizeof(char));
+	assert(reachable);
+
+	for (int r = 0; r < graph->rpo_count; r++)
+		reachable[graph->rpo[r]] = 1;
+
+	/* epilog has to stay even if the function never returns */
+	reachable[graph->exit_block] = 1;
+
+	int marked = 0;
+	for (int id = 0; id < graph->block_count; id++) {
+		if (reachable[id])
+			continue;
+
+		for (int i = graph->blocks[id].first; i <= graph->blocks[id].last; i++) {
+			/* string constants are emitted after the code, wherever they were made */
+			if (quad_list->arr[i].op == STRING_Q || removed[i])
+				continue;
+
+			removed[i] = 1;
+			marked++;
+		}
+	}
+
+	free(reachable);
+	return marked;
+}
+
+/*
+ * can q be dropped if nothing reads what it writes? (no side effects)
+ */
+static int is_pure(quad * q) {
+	switch (q->op) {
+		case ADD_Q: case SUB_Q: case MUL_Q: case DIV_Q: case MOD_Q:
+		case LT_Q: case GT_Q: case LTE_Q: case GTE_Q: case NE_Q: case EQ_Q:
+		case PRE_INC_Q: case PRE_DEC_Q: case POST_INC_Q: case POST_DEC_Q:
+		case NOT_Q:
+		case NEG_Q:
+		case ASSIGN_Q:
+		case SIZEOF_Q:
+			return 1;
+		default:
+			return 0;
+	}
+}
+
+static int is_dead(liveness * info, quad * q, live_set_word * live) {
+	if (!is_pure(q))
+		return 0;
+
+	/* x = x */
+	if (q->op == ASSIGN_Q && get_local_scalar(&q->args[0]) != NULL &&
+		get_local_scalar(&q->args[0]) == get_local_scalar(&q->args[1]))
+		return 1;
+
+	/* every operand written must be a local scalar that isn't live */
+	symnode_t * vars[MAX_QUAD_REFS];
+	int count = get_quad_defs(q, vars);
+
+	int writes = (q->op == PRE_INC_Q || q->op == PRE_DEC_Q || q->op == POST_INC_Q || q->op == POST_DEC_Q) ? 2 : 1;
+	if (count != writes)
+		return 0; 		// writes a global or array element
+
+	for (int v = 0; v < count; v++) {
+		if (LIVE_TEST(live, get_live_var_number(info, vars[v])))
+			return 0;
+	}
+	return 1;
+}
+
+int mark_dead_quads(liveness * info, char * removed) {
+	cfg * graph = info->graph;
+	live_set_word * live = (live_set_word *)malloc(info->words * sizeof(live_set_word));
+	assert(live);
+
+	int marked = 0;
+	for (int id = 0; id < graph->block_count; id++) {
+		memcpy(live, LIVE_SET(info->live_out, info, id), info->words * sizeof(live_set_word));
+
+		for (int i = graph->blocks[id].last; i >= graph->blocks[id].first; i--) {
+			quad * q = &quad_list->arr[i];
+
+			if (removed[i])
+				continue;
+
+			/* a dead quad's operands don't become live */
+			if (is_dead(info, q, live)) {
+				removed[i] = 1;
+				marked++;
+				continue;
+			}
+
+			step_live_backward(info, q, live);
+		}
+	}
+
+	free(live);
+	return marked;
+}
+
+int eliminate_dead_code() {
+	if (!quad_list)
+		return 0;
+
+	int total = 0;
+	int marked = 1;
+
+	/* removing a use can kill the quad that fed it in another block, so repeat */
+	while (marked) {
+		char * removed = (char *)calloc(quad_list->count + 1, sizeof(char));
+		assert(removed);
+		marked = 0;
+
+		cfg_list * graphs = build_cfg_list();
+		for (int g = 0; g < graphs->count; g++) {
+			cfg * graph = graphs->arr[g];
+
+			marked += mark_unreachable_blocks(graph, removed);
+
+			liveness * info = compute_liveness(graph);
+			marked += mark_dead_quads(info, removed);
+			destroy_liveness(info);
+		}
+		destroy_cfg_list(graphs);
+
+		total += remove_quads(removed);
+		free(removed);
+	}
+
+	return total;
+}
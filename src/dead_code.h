@@ -0,0 +1,36 @@
+/*
+ * dead_code.h
+ *
+ * dead code and unreachable block elimination over the quad list
+ * Yondon Fu and Matt McFarland - Delights (CS57 - 16W)
+ */
+
+#ifndef _DEAD_CODE_H
+#define _DEAD_CODE_H
+
+#include "quad.h"
+#include "cfg.h"
+#include "liveness.h"
+
+/*
+ * removes unreachable blocks and quads whose results are never read from
+ * every function in the global quad_list, repeating until nothing changes.
+ * call between CG() and create_ys().
+ *
+ * returns the number of quads removed
+ */
+int eliminate_dead_code();
+
+/*
+ * flags the quads of blocks the entry can't reach in removed[] (the exit
+ * block and string definitions are always kept). returns number flagged.
+ */
+int mark_unreachable_blocks(cfg * graph, char * removed);
+
+/*
+ * flags quads that only write local scalars nobody reads afterwards.
+ * returns number flagged.
+ */
+int mark_dead_quads(liveness * info, char * removed);
+
+#endif 	// _DEAD_CODE_H
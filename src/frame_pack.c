@@ -0,0 +1,151 @@
+/*
+ * frame_pack.c
+ *
+ * temps from new_temp() are written once and read once, so most of them
+ * are only live for a couple of quads. Instead of a frame slot per temp,
+ * live ranges (from liveness analysis) are colored with frame slots in
+ * order of their start: a slot is handed to the next temp as soon as the
+ * temp holding it is dead. Frames shrink from one word per temp to one word
+ * per temp that is live at the same time.
+ *
+ * Yondon Fu and Matt McFarland - Delights (CS57 - 16W)
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "frame_pack.h"
+#include "cfg.h"
+#include "liveness.h"
+#include "types.h"
+
+extern quad_arr * quad_list;
+
+int frame_packing = 1;
+
+static void extend_range(temp_range * ranges, liveness * info, int n, int index) {
+	if (n < 0 || info->vars[n]->s.v.specie != TEMP_VAR)
+		return;
+
+	if (ranges[n].start == -1 || index < ranges[n].start)
+		ranges[n].start = index;
+	if (index > ranges[n].end)
+		ranges[n].end = index;
+}
+
+static void extend_refs(temp_range * ranges, liveness * info, symnode_t ** vars, int count, int index) {
+	for (int v = 0; v < count; v++)
+		extend_range(ranges, info, get_live_var_number(info, vars[v]), index);
+}
+
+static int compare_range_start(const void * a, const void * b) {
+	const temp_range * x = *(temp_range * const *)a;
+	const temp_range * y = *(temp_range * const *)b;
+	return x->start - y->start;
+}
+
+/*
+ * [start, end] for every temp of the function
+ */
+static void compute_temp_ranges(liveness * info, temp_range * ranges) {
+	cfg * graph = info->graph;
+	live_set_word * live = (live_set_word *)malloc(info->words * sizeof(live_set_word));
+	assert(live);
+
+	symnode_t * vars[MAX_QUAD_REFS];
+	for (int id = 0; id < graph->block_count; id++) {
+		memcpy(live, LIVE_SET(info->live_out, info, id), info->words * sizeof(live_set_word));
+
+		for (int i = graph->blocks[id].last; i >= graph->blocks[id].first; i--) {
+			quad * q = &quad_list->arr[i];
+
+			/* everything live after q is live at q */
+			for (int w = 0; w < info->words; w++) {
+				live_set_word bits = live[w];
+				for (int b = 0; bits != 0; b++, bits >>= 1) {
+					if (bits & 1)
+						extend_range(ranges, info, w * 32 + b, i);
+				}
+			}
+
+			extend_refs(ranges, info, vars, get_quad_defs(q, vars), i);
+			extend_refs(ranges, info, vars, get_quad_uses(q, vars), i);
+
+			step_live_backward(info, q, live);
+		}
+	}
+
+	free(live);
+}
+
+int pack_temp_slots(symnode_t * func_sym, int local_bytes) {
+	if (!quad_list || !func_sym)
+		return local_bytes;
+
+	/* find the function's quads */
+	int prolog = -1, epilog = -1;
+	for (int i = 0; i < quad_list->count && epilog == -1; i++) {
+		quad * q = &quad_list->arr[i];
+
+		if (q->op == PROLOG_Q && q->args[0].symnode == func_sym)
+			prolog = i;
+		else if (q->op == EPILOG_Q && prolog != -1)
+			epilog = i;
+	}
+	if (prolog == -1 || epilog == -1)
+		return local_bytes;
+
+	cfg * graph = build_cfg(prolog, epilog);
+	liveness * info = compute_liveness(graph);
+
+	temp_range * ranges = (temp_range *)malloc((info->var_count + 1) * sizeof(temp_range));
+	temp_range ** sorted = (temp_range **)malloc((info->var_count + 1) * sizeof(temp_range *));
+	int * slot_end = (int *)malloc((info->var_count + 1) * sizeof(int));
+	assert(ranges && sorted && slot_end);
+
+	for (int n = 0; n < info->var_count; n++) {
+		ranges[n].temp = info->vars[n];
+		ranges[n].start = -1;
+		ranges[n].end = -1;
+		ranges[n].slot = -1;
+	}
+
+	compute_temp_ranges(info, ranges);
+
+	int temp_count = 0;
+	for (int n = 0; n < info->var_count; n++) {
+		if (ranges[n].start != -1)
+			sorted[temp_count++] = &ranges[n];
+	}
+	qsort(sorted, temp_count, sizeof(temp_range *), compare_range_start);
+
+	/*
+	 * color ranges with slots. a slot frees up strictly after its temp's last
+	 * quad -- a quad may read an operand again after writing its result.
+	 */
+	int slot_count = 0;
+	for (int t = 0; t < temp_count; t++) {
+		temp_range * r = sorted[t];
+
+		for (int s = 0; s < slot_count; s++) {
+			if (slot_end[s] < r->start) {
+				r->slot = s;
+				break;
+			}
+		}
+		if (r->slot == -1)
+			r->slot = slot_count++;
+
+		slot_end[r->slot] = r->end;
+		r->temp->s.v.offset_of_frame_pointer = local_bytes - (r->slot + 1) * TYPE_SIZE(INT_TS);
+	}
+
+	free(ranges);
+	free(sorted);
+	free(slot_end);
+	destroy_liveness(info);
+	destroy_cfg(graph);
+
+	return local_bytes - slot_count * TYPE_SIZE(INT_TS);
+}
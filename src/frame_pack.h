@@ -0,0 +1,38 @@
+/*
+ * frame_pack.h
+ *
+ * shares frame slots between temps whose live ranges don't overlap
+ * Yondon Fu and Matt McFarland - Delights (CS57 - 16W)
+ */
+
+#ifndef _FRAME_PACK_H
+#define _FRAME_PACK_H
+
+#include "symtab.h"
+
+/*
+ * 1 (default) to pack temps into shared frame slots, 0 (--no-frame-pack) to
+ * give every temp its own slot like locals
+ */
+extern int frame_packing;
+
+/*
+ * live range of a temp over quad indices, and the slot it was packed into
+ */
+typedef struct temp_range {
+	symnode_t * temp;
+	int start; 			// first quad index where the temp is written or live
+	int end; 			// last quad index where the temp is read or live
+	int slot;
+} temp_range;
+
+/*
+ * gives the temps of func_sym frame offsets below local_bytes, sharing a
+ * slot between temps that are never live at the same time.
+ * temps that no quad references get no slot.
+ *
+ * returns the lowest offset used
+ */
+int pack_temp_slots(symnode_t * func_sym, int local_bytes);
+
+#endif 	// _FRAME_PACK_H
@@ -0,0 +1,395 @@
+/*
+ * induction.c
+ *
+ * strength reduction of array indexing on SSA form.
+ *
+ * A basic induction variable i of a loop is a header phi whose value coming
+ * round again is i + c for a literal c. An element a[i + k] the loop reads
+ * or writes then lives at a + 4 * (i + k), an address that also just moves
+ * by 4 * c a trip: it gets a variable p of its own, set to &a[init + k] in
+ * the preheader and stepped right after i is, and the access goes through
+ * p (ELEMENT_POINTER) where it would have scaled the index and added the
+ * array's base. The back end spends one add a trip on p instead.
+ *
+ * Every pointer wants one of the few registers, so a loop gets at most
+ * MAX_POINTER_IVS of them, given to the elements it touches most.
+ *
+ * Yondon Fu and Matt McFarland - Delights (CS57 - 16W)
+ */
+
+#include <stdlib.h>
+#include <assert.h>
+#include <limits.h>
+
+#include "induction.h"
+#include "loops.h"
+#include "IR_gen.h" 		// for PASS_ARR_POINTER, ELEMENT_POINTER
+#include "liveness.h" 		// for get_quad_use_args(), get_quad_def_args()
+#include "temp_list.h" 		// for new_scope_temp()
+#include "symtab.h"
+#include "types.h" 			// for TYPE_SIZE
+
+#define MAX_POINTER_IVS 2 		// pointers per loop
+#define MAX_IVS 8
+#define MAX_GROUPS 16
+#define MAX_DERIVE 8 			// copies and adds followed back from an index
+#define MAX_OFFSET (1 << 16)
+
+/* i1 = phi(init, i2, ...) in the header, i2 = i1 + step in the loop */
+typedef struct basic_iv {
+	temp_var * phi;
+	temp_var * next;
+	int step;
+	quad_arg init; 			// value from the preheader
+} basic_iv;
+
+/* the accesses a[i + offset] of one array and induction variable */
+typedef struct element_group {
+	quad_arg element; 		// one of the accesses
+	basic_iv * iv;
+	int offset;
+	int count;
+	quad_arg pointer; 		// p's version in the loop
+} element_group;
+
+typedef struct iv_state {
+	ssa_function * fn;
+	int * def_block; 		// by temp id: block of the quad defining the version
+	int * def_pos;
+	int def_size;
+
+	ssa_loop * loop;
+	basic_iv ivs[MAX_IVS];
+	int iv_count;
+	element_group groups[MAX_GROUPS];
+	int group_count;
+} iv_state;
+
+static void record_defs(iv_state * state) {
+	ssa_function * fn = state->fn;
+	free(state->def_block);
+	free(state->def_pos);
+
+	state->def_size = fn->origin_size;
+	state->def_block = (int *)malloc((state->def_size + 1) * sizeof(int));
+	state->def_pos = (int *)malloc((state->def_size + 1) * sizeof(int));
+	assert(state->def_block && state->def_pos);
+	for (int i = 0; i < state->def_size; i++)
+		state->def_block[i] = NO_BLOCK;
+
+	quad_arg * defs[MAX_QUAD_REFS];
+	for (int r = 0; r < fn->rpo_count; r++) {
+		ssa_block * b = &fn->blocks[fn->rpo[r]];
+		for (int i = 0; i < b->quad_count; i++) {
+			int count = get_quad_def_args(&b->quads[i], defs);
+			for (int d = 0; d < count; d++) {
+				if (is_version(fn, defs[d]) && defs[d]->temp->id < state->def_size) {
+					state->def_block[defs[d]->temp->id] = b->id;
+					state->def_pos[defs[d]->temp->id] = i;
+				}
+			}
+		}
+	}
+}
+
+/* the quad defining version t, NULL for phis and values on entry */
+static quad * def_of(iv_state * state, temp_var * t) {
+	if (t->id >= state->def_size || state->def_block[t->id] == NO_BLOCK)
+		return NULL;
+	return &state->fn->blocks[state->def_block[t->id]].quads[state->def_pos[t->id]];
+}
+
+/* t + step for a literal step, with the other operand in *from */
+static int literal_step(quad * q, temp_var ** from, int * step) {
+	quad_arg * a = &q->args[1];
+	quad_arg * b = &q->args[2];
+
+	if (q->op == ADD_Q && a->type == INT_LITERAL_Q_ARG) {
+		quad_arg * swap = a;
+		a = b;
+		b = swap;
+	}
+	if ((q->op != ADD_Q && q->op != SUB_Q) || a->type != TEMP_VAR_Q_ARG || b->type != INT_LITERAL_Q_ARG)
+		return 0;
+	if (b->int_literal > MAX_OFFSET || b->int_literal < -MAX_OFFSET)
+		return 0;
+
+	*from = a->temp;
+	*step = (q->op == ADD_Q) ? b->int_literal : -b->int_literal;
+	return 1;
+}
+
+static void find_ivs(iv_state * state) {
+	ssa_loop * l = state->loop;
+	ssa_block * h = &state->fn->blocks[l->header];
+	state->iv_count = 0;
+
+	for (int j = 0; j < h->phi_count && state->iv_count < MAX_IVS; j++) {
+		ssa_phi * phi = &h->phis[j];
+		quad_arg * init = NULL;
+		temp_var * next = NULL;
+		int k;
+
+		for (k = 0; k < h->pred_count; k++) {
+			if (h->preds[k] == l->preheader) {
+				init = &phi->args[k];
+			} else {
+				if (phi->args[k].type != TEMP_VAR_Q_ARG || (next && phi->args[k].temp != next))
+					break;
+				next = phi->args[k].temp;
+			}
+		}
+		if (k < h->pred_count || !init || init->type == NULL_ARG || !next)
+			continue;
+
+		quad * q = def_of(state, next);
+		temp_var * from;
+		int step;
+		if (!q || !in_loop(l, state->def_block[next->id]) || !literal_step(q, &from, &step) ||
+			from != phi->dest.temp || step == 0)
+			continue;
+
+		basic_iv * iv = &state->ivs[state->iv_count++];
+		iv->phi = phi->dest.temp;
+		iv->next = next;
+		iv->step = step;
+		iv->init = *init;
+	}
+}
+
+/* follows index t back through copies and literal adds to iv + *offset */
+static basic_iv * derive_index(iv_state * state, temp_var * t, int * offset) {
+	int total = 0;
+
+	for (int depth = 0; depth < MAX_DERIVE; depth++) {
+		for (int i = 0; i < state->iv_count; i++) {
+			if (state->ivs[i].phi == t) {
+				*offset = total;
+				return &state->ivs[i];
+			}
+		}
+
+		quad * q = def_of(state, t);
+		if (!q)
+			return NULL;
+
+		int step;
+		if (q->op == ASSIGN_Q && q->args[1].type == TEMP_VAR_Q_ARG) {
+			t = q->args[1].temp;
+		} else if (literal_step(q, &t, &step)) {
+			total += step;
+			if (total > MAX_OFFSET || total < -MAX_OFFSET)
+				return NULL;
+		} else {
+			return NULL;
+		}
+	}
+	return NULL;
+}
+
+/* is arg an element indexed by one of the loop's induction variables? */
+static element_group * group_of(iv_state * state, quad_arg * arg, int add) {
+	if (arg->type != SYMBOL_ARR_Q_ARG || !arg->temp || arg->int_literal == PASS_ARR_POINTER ||
+		arg->int_literal == ELEMENT_POINTER)
+		return NULL;
+
+	int offset;
+	basic_iv * iv = derive_index(state, arg->temp, &offset);
+	if (!iv)
+		return NULL;
+
+	for (int g = 0; g < state->group_count; g++) {
+		element_group * group = &state->groups[g];
+		if (group->element.symnode == arg->symnode && group->iv == iv && group->offset == offset)
+			return group;
+	}
+	if (!add || state->group_count == MAX_GROUPS)
+		return NULL;
+
+	element_group * group = &state->groups[state->group_count++];
+	group->element = *arg;
+	group->iv = iv;
+	group->offset = offset;
+	group->count = 0;
+	group->pointer = NULL_QUAD_ARG;
+	return group;
+}
+
+/* counts the accesses to each element indexed by an induction variable */
+static void collect_groups(iv_state * state) {
+	ssa_loop * l = state->loop;
+	quad_arg * uses[MAX_QUAD_REFS];
+	state->group_count = 0;
+
+	for (int i = 0; i < l->block_count; i++) {
+		ssa_block * b = &state->fn->blocks[l->blocks[i]];
+		for (int q = 0; q < b->quad_count; q++) {
+			int count = get_quad_use_args(&b->quads[q], uses);
+			for (int u = 0; u < count; u++) {
+				element_group * group = group_of(state, uses[u], 1);
+				if (group)
+					group->count++;
+			}
+		}
+	}
+}
+
+/* &a[init + offset] in bytes from a, if init is a literal */
+static int start_bytes(element_group * group, long long * bytes) {
+	if (group->iv->init.type != INT_LITERAL_Q_ARG)
+		return 0;
+	*bytes = ((long long)group->iv->init.int_literal + group->offset) * TYPE_SIZE(group->element.symnode->s.v.type);
+	return 1;
+}
+
+/* the MAX_POINTER_IVS groups with the most accesses get a pointer */
+static void choose_groups(iv_state * state) {
+	for (int chosen = 0; chosen < MAX_POINTER_IVS; chosen++) {
+		element_group * best = NULL;
+		for (int g = 0; g < state->group_count; g++) {
+			element_group * group = &state->groups[g];
+			long long bytes;
+			if (start_bytes(group, &bytes) && (bytes > INT_MAX || bytes < INT_MIN))
+				continue;
+			if (group->pointer.type == NULL_ARG && (!best || group->count > best->count))
+				best = group;
+		}
+		if (!best)
+			return;
+
+		temp_var * t = new_scope_temp(state->fn->scope);
+		quad_arg var = { .type = TEMP_VAR_Q_ARG, .temp = t };
+		best->pointer = new_version(state->fn, &var);
+	}
+}
+
+static void rewrite_accesses(iv_state * state) {
+	ssa_loop * l = state->loop;
+	quad_arg * uses[MAX_QUAD_REFS];
+
+	for (int i = 0; i < l->block_count; i++) {
+		ssa_block * b = &state->fn->blocks[l->blocks[i]];
+		for (int q = 0; q < b->quad_count; q++) {
+			int count = get_quad_use_args(&b->quads[q], uses);
+			for (int u = 0; u < count; u++) {
+				element_group * group = group_of(state, uses[u], 0);
+				if (group && group->pointer.type != NULL_ARG) {
+					uses[u]->temp = group->pointer.temp;
+					uses[u]->int_literal = ELEMENT_POINTER;
+				}
+			}
+		}
+	}
+}
+
+static quad_arg fresh_value(ssa_function * fn) {
+	quad_arg var = { .type = TEMP_VAR_Q_ARG, .temp = new_scope_temp(fn->scope) };
+	return new_version(fn, &var);
+}
+
+static quad_arg literal_arg(int value) {
+	quad_arg arg = NULL_QUAD_ARG;
+	arg.type = INT_LITERAL_Q_ARG;
+	arg.int_literal = value;
+	return arg;
+}
+
+static void append_quad(ssa_block * b, quad_op op, quad_arg dest, quad_arg a, quad_arg c) {
+	quad q = { .op = op, .args = { dest, a, c } };
+	ssa_insert_quad(b, ssa_block_end(b, &q.args[0]), &q);
+}
+
+/*
+ * p0 = &a[init + offset] in the preheader, p1 = phi(p0, p2, ...) in the
+ * header and p2 = p1 + step * size right after the induction variable steps
+ */
+static void add_pointer(iv_state * state, element_group * group) {
+	ssa_function * fn = state->fn;
+	ssa_loop * l = state->loop;
+	basic_iv * iv = group->iv;
+	int size = TYPE_SIZE(group->element.symnode->s.v.type);
+
+	quad_arg base = group->element;
+	base.int_literal = PASS_ARR_POINTER;
+	base.temp = NULL;
+
+	/* preheader */
+	ssa_block * p = &fn->blocks[l->preheader];
+	quad_arg start = new_version(fn, &group->pointer);
+	long long bytes;
+	if (start_bytes(group, &bytes) && bytes == 0) {
+		append_quad(p, ASSIGN_Q, start, base, NULL_QUAD_ARG);
+	} else if (start_bytes(group, &bytes)) {
+		append_quad(p, ADD_Q, start, base, literal_arg((int)bytes));
+	} else {
+		quad_arg index = iv->init;
+		if (group->offset != 0) {
+			quad_arg sum = fresh_value(fn);
+			append_quad(p, ADD_Q, sum, index, literal_arg(group->offset));
+			index = sum;
+		}
+		quad_arg scaled = fresh_value(fn);
+		append_quad(p, MUL_Q, scaled, index, literal_arg(size));
+		append_quad(p, ADD_Q, start, base, scaled);
+	}
+
+	/* step after the induction variable */
+	quad_arg stepped = new_version(fn, &group->pointer);
+	ssa_block * b = &fn->blocks[state->def_block[iv->next->id]];
+	int pos = 0;
+	while (b->quads[pos].args[0].type != TEMP_VAR_Q_ARG || b->quads[pos].args[0].temp != iv->next)
+		pos++;
+	quad step = { .op = ADD_Q, .args = { stepped, group->pointer, literal_arg(iv->step * size) } };
+	ssa_insert_quad(b, pos + 1, &step);
+
+	/* header */
+	ssa_block * h = &fn->blocks[l->header];
+	ssa_phi * phi = ssa_add_phi(h, &group->pointer);
+	for (int k = 0; k < h->pred_count; k++)
+		phi->args[k] = (h->preds[k] == l->preheader) ? start : stepped;
+}
+
+static int reduce_loop(iv_state * state) {
+	find_ivs(state);
+	if (state->iv_count == 0)
+		return 0;
+
+	collect_groups(state);
+	choose_groups(state);
+	rewrite_accesses(state);
+
+	int added = 0;
+	for (int g = 0; g < state->group_count; g++) {
+		if (state->groups[g].pointer.type != NULL_ARG) {
+			add_pointer(state, &state->groups[g]);
+			added++;
+		}
+	}
+	return added;
+}
+
+static int reduce_function(ssa_function * fn) {
+	loop_list * loops = find_loops(fn);
+	iv_state state = { .fn = fn };
+
+	int added = 0;
+	for (int i = 0; i < loops->count; i++) {
+		state.loop = &loops->loops[i];
+		if (state.loop->preheader == NO_BLOCK)
+			continue;
+		record_defs(&state);
+		added += reduce_loop(&state);
+	}
+
+	free(state.def_block);
+	free(state.def_pos);
+	destroy_loops(loops);
+	return added;
+}
+
+int reduce_induction_variables(ssa_program * prog) {
+	int added = 0;
+	for (int f = 0; f < prog->function_count; f++)
+		added += reduce_function(prog->functions[f]);
+	return added;
+}
@@ -0,0 +1,26 @@
+/*
+ * induction.h
+ *
+ * strength reduction of array indexing by loop induction variables
+ * Yondon Fu and Matt McFarland - Delights (CS57 - 16W)
+ */
+
+#ifndef _INDUCTION_H
+#define _INDUCTION_H
+
+#include "ssa.h"
+
+/*
+ * finds each loop's basic induction variables -- a header phi stepped by a
+ * literal once per trip -- and gives the array elements indexed by one of
+ * them (plus a literal) a pointer of their own. the pointer starts at the
+ * element in the preheader and steps with the variable, and the accesses
+ * read and write through it (ELEMENT_POINTER) instead of scaling the index
+ * and adding the array's base every time. the index copies are left for
+ * dce.
+ *
+ * returns the number of pointers added
+ */
+int reduce_induction_variables(ssa_program * prog);
+
+#endif 	// _INDUCTION_H
@@ -0,0 +1,579 @@
+/*
+ * inline.c
+ *
+ * inlines calls of small leaf functions in the quad list.
+ *
+ * A call costs its PARAM_Q pushes, the call, the callee's prolog (frame
+ * setup and saving the registers it uses), epilog and return, POSTRET_Q's
+ * stack reset and a copy of the return value -- more than the body of a
+ * helper that adds two numbers. Worse, the call makes the SSA passes forget
+ * every global and array element they know. A function that makes no calls
+ * can't recurse, so its body copied into the caller is final.
+ *
+ * The temps of a copy are fresh temps of the caller. Its parameters, scalar
+ * locals and return value can be assigned more than once, and around a loop
+ * of the callee, so they become fresh locals of the caller instead, which
+ * the passes after this one treat like the caller's own: the copies into
+ * the parameters fold away, and the allocator can keep them in registers.
+ * A parameter array is replaced by the array passed
+ * in -- only a global or a local array of the caller, since pushing on an
+ * array parameter passes the address of its frame slot. A callee with local
+ * arrays or sizeof isn't inlined.
+ *
+ * Loops are found as the quads between a label and a jump back to it, and
+ * the calls nested deepest go first, smaller callees before bigger ones,
+ * until the quads the copies add reach the budget.
+ *
+ * Yondon Fu and Matt McFarland - Delights (CS57 - 16W)
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <assert.h>
+
+#include "inline.h"
+#include "IR_gen.h" 		// for new_pass_label(), PASS_ARR_POINTER
+#include "liveness.h" 		// for get_local_scalar()
+#include "intern.h"
+#include "symtab.h"
+#include "types.h" 			// for TYPE_SIZE
+
+#define INLINE_MAX_QUADS 24 		// biggest body inlined
+#define INLINE_MIN_BUDGET 256 		// quads the copies may add, at least
+#define INLINE_BUDGET_SHARE 2 		// or 1 / share of the program
+#define INIT_MAP_SIZE 32
+#define MAX_LOCAL_NAME 64 			// callee's name for a local, a dot and the copy's number
+
+extern quad_arr * quad_list;
+extern symboltable_t * symtab;
+
+typedef struct inline_callee {
+	symnode_t * function;
+	int first; 				// first quad of the body
+	int last; 				// its epilog label
+	int size; 				// quads a copy adds
+	int inlinable;
+} inline_callee;
+
+typedef struct call_site {
+	int precall;
+	int caller; 			// index of the caller's PROLOG_Q
+	inline_callee * callee;
+	int * params; 			// PARAM_Q of each parameter
+	quad_arg * param_args; 	// what each parameter reads as in the copy
+	int depth; 				// loops around the call
+} call_site;
+
+/* callee variable, temp or label -> its stand-in in one copy */
+typedef struct inline_map {
+	void * key;
+	quad_arg value;
+} inline_map;
+
+typedef struct inline_state {
+	quad * old;
+	int old_count;
+
+	inline_callee * callees;
+	int callee_count;
+
+	quad * arr; 			// the new quad list
+	int count;
+	int size;
+
+	inline_map * map;
+	int map_count;
+	int map_size;
+	symhashtable_t * scope; 	// caller of the copy being made
+} inline_state;
+
+/*
+ * ---------- functions ----------
+ */
+
+static int is_main(symnode_t * function) {
+	return strcmp(function->name, "main") == 0;
+}
+
+/* no calls, no local arrays, no sizeof and short enough */
+static void check_callee(inline_callee * c, quad * arr) {
+	c->inlinable = !is_main(c->function);
+	c->size = 0;
+
+	for (int i = c->first; i < c->last && c->inlinable; i++) {
+		quad * q = &arr[i];
+		if (q->op == PRECALL_Q || q->op == PARAM_Q || q->op == SIZEOF_Q)
+			c->inlinable = 0;
+		for (int a = 0; a < QUAD_ARG_NUM; a++) {
+			if (q->args[a].type == SYMBOL_ARR_Q_ARG && q->args[a].symnode->s.v.specie == LOCAL_VAR)
+				c->inlinable = 0;
+		}
+		if (q->op != LABEL_Q && q->op != STRING_Q)
+			c->size++;
+	}
+
+	if (c->size > INLINE_MAX_QUADS)
+		c->inlinable = 0;
+}
+
+static int find_callees(inline_state * state) {
+	state->callees = (inline_callee *)calloc(state->old_count, sizeof(inline_callee));
+	assert(state->callees);
+
+	int prolog = -1;
+	for (int i = 0; i < state->old_count; i++) {
+		quad * q = &state->old[i];
+		if (q->op == PROLOG_Q)
+			prolog = i;
+		if (q->op != EPILOG_Q || prolog < 0)
+			continue;
+
+		symnode_t * function = find_in_top_symboltable(symtab, state->old[prolog].args[0].label);
+		if (!function || state->old[i - 1].op != LABEL_Q)
+			return 1;
+
+		inline_callee * c = &state->callees[state->callee_count++];
+		c->function = function;
+		c->first = prolog + 1;
+		c->last = i - 1;
+		check_callee(c, state->old);
+		prolog = -1;
+	}
+	return 0;
+}
+
+static inline_callee * find_callee(inline_state * state, char * label) {
+	for (int c = 0; c < state->callee_count; c++) {
+		if (strcmp(state->callees[c].function->name, label) == 0)
+			return &state->callees[c];
+	}
+	return NULL;
+}
+
+/* which parameter of function is the variable param? */
+static int param_index(symnode_t * function, symnode_t * param) {
+	for (int k = 0; k < function->s.f.arg_count; k++) {
+		if (function->s.f.arg_arr[k].offset_of_frame_pointer == param->s.v.offset_of_frame_pointer)
+			return k;
+	}
+	assert(0);
+	return -1;
+}
+
+/*
+ * ---------- loop depth ----------
+ */
+
+typedef struct label_pos {
+	char * label;
+	int index;
+} label_pos;
+
+static int compare_label_pos(const void * a, const void * b) {
+	uintptr_t x = (uintptr_t)((const label_pos *)a)->label;
+	uintptr_t y = (uintptr_t)((const label_pos *)b)->label;
+	return (x > y) - (x < y);
+}
+
+/* depth[i] = number of jumps back over quad i */
+static int * loop_depths(quad * arr, int count) {
+	label_pos * labels = (label_pos *)malloc((count + 1) * sizeof(label_pos));
+	int * depth = (int *)calloc(count + 1, sizeof(int));
+	assert(labels && depth);
+
+	int label_count = 0;
+	for (int i = 0; i < count; i++) {
+		if (arr[i].op == LABEL_Q) {
+			labels[label_count].label = arr[i].args[0].label;
+			labels[label_count++].index = i;
+		}
+	}
+	qsort(labels, label_count, sizeof(label_pos), compare_label_pos);
+
+	for (int i = 0; i < count; i++) {
+		quad * q = &arr[i];
+		label_pos key;
+		if (q->op == GOTO_Q)
+			key.label = q->args[0].label;
+		else if (q->op == IFFALSE_Q || q->op == IFTRUE_Q)
+			key.label = q->args[1].label;
+		else
+			continue;
+
+		label_pos * target = bsearch(&key, labels, label_count, sizeof(label_pos), compare_label_pos);
+		if (target && target->index <= i) {
+			depth[target->index]++;
+			depth[i + 1]--;
+		}
+	}
+
+	for (int i = 1; i < count; i++)
+		depth[i] += depth[i - 1];
+
+	free(labels);
+	return depth;
+}
+
+/*
+ * ---------- call sites ----------
+ */
+
+/* can the argument of PARAM_Q p stand in for an array parameter? */
+static int passes_array(quad * p) {
+	quad_arg * arg = &p->args[0];
+	return arg->type == SYMBOL_ARR_Q_ARG && arg->int_literal == PASS_ARR_POINTER &&
+		(arg->symnode->s.v.specie == GLOBAL_VAR || arg->symnode->s.v.specie == LOCAL_VAR);
+}
+
+static int can_inline(inline_state * state, call_site * site, int * stack) {
+	int i = site->precall;
+	if (!site->callee->inlinable || i + 2 >= state->old_count ||
+		state->old[i + 1].op != POSTRET_Q || state->old[i + 2].op != ASSIGN_Q ||
+		state->old[i + 2].args[1].type != RETURN_Q_ARG)
+		return 0;
+
+	symnode_t * function = site->callee->function;
+	for (int k = 0; k < function->s.f.arg_count; k++) {
+		if (function->s.f.arg_arr[k].modifier == ARRAY_DT && !passes_array(&state->old[stack[k]]))
+			return 0;
+	}
+	return 1;
+}
+
+/*
+ * every call that could be inlined, matching PARAM_Q to PRECALL_Q -- an
+ * argument can be a call, so the PARAM_Qs of calls nest like brackets.
+ * returns -1 if the quads don't add up.
+ */
+static int find_call_sites(inline_state * state, call_site * sites, int * depth) {
+	int * stack = (int *)malloc(state->old_count * sizeof(int));
+	assert(stack);
+	int top = 0;
+	int site_count = 0;
+	int caller = -1;
+
+	for (int i = 0; i < state->old_count; i++) {
+		quad * q = &state->old[i];
+		if (q->op == PROLOG_Q)
+			caller = i;
+		if (q->op == PARAM_Q)
+			stack[top++] = i;
+		if (q->op != PRECALL_Q)
+			continue;
+
+		inline_callee * callee = find_callee(state, q->args[0].label);
+		if (!callee || top < callee->function->s.f.arg_count) {
+			site_count = -1;
+			break;
+		}
+		int arg_count = callee->function->s.f.arg_count;
+		top -= arg_count;
+
+		call_site * site = &sites[site_count];
+		site->precall = i;
+		site->caller = caller;
+		site->callee = callee;
+		site->depth = depth[i];
+		if (!can_inline(state, site, &stack[top]))
+			continue;
+
+		site->params = (int *)malloc((arg_count + 1) * sizeof(int));
+		site->param_args = (quad_arg *)calloc(arg_count + 1, sizeof(quad_arg));
+		assert(site->params && site->param_args);
+		for (int k = 0; k < arg_count; k++) {
+			site->params[k] = stack[top + k];
+			if (callee->function->s.f.arg_arr[k].modifier == ARRAY_DT)
+				site->param_args[k] = state->old[stack[top + k]].args[0];
+		}
+		site_count++;
+	}
+
+	free(stack);
+	return site_count;
+}
+
+/* loops first, then small callees */
+static int compare_sites(const void * a, const void * b) {
+	const call_site * x = *(call_site * const *)a;
+	const call_site * y = *(call_site * const *)b;
+	if (x->depth != y->depth)
+		return y->depth - x->depth;
+	if (x->callee->size != y->callee->size)
+		return x->callee->size - y->callee->size;
+	return x->precall - y->precall;
+}
+
+/*
+ * ---------- copying ----------
+ */
+
+static void emit(inline_state * state, quad_op op, quad_arg * a1, quad_arg * a2) {
+	if (state->count + 1 >= state->size) {
+		state->size *= 2;
+		state->arr = realloc(state->arr, state->size * sizeof(quad));
+		assert(state->arr);
+	}
+
+	quad * q = &state->arr[state->count];
+	q->number = state->count++;
+	q->op = op;
+	q->args[0] = a1 ? *a1 : NULL_QUAD_ARG;
+	q->args[1] = a2 ? *a2 : NULL_QUAD_ARG;
+	q->args[2] = NULL_QUAD_ARG;
+}
+
+static void emit_quad(inline_state * state, quad * q) {
+	emit(state, q->op, &q->args[0], &q->args[1]);
+	state->arr[state->count - 1].args[2] = q->args[2];
+}
+
+static quad_arg fresh_temp(inline_state * state) {
+	quad_arg arg = { .type = TEMP_VAR_Q_ARG, .temp = new_scope_temp(state->scope) };
+	assert(arg.temp);
+	return arg;
+}
+
+/* a new scalar local of the caller, named after the callee's variable */
+static quad_arg fresh_local(inline_state * state, char * name) {
+	static int locals = 0;
+
+	/* a dot can't appear in a C name, so the caller's own locals never clash */
+	char local[MAX_LOCAL_NAME];
+	snprintf(local, MAX_LOCAL_NAME, "%.40s.%d", name, locals++);
+
+	symnode_t * var = insert_into_symhashtable(state->scope, intern(compile_strings, local), NULL);
+	set_node_type(var, VAR_SYM);
+	var_symbol model = init_variable(var->name, INT_TS, SINGLE_DT, LOCAL_VAR, TYPE_SIZE(INT_TS));
+	set_node_var(var, &model);
+
+	quad_arg arg = { .type = SYMBOL_VAR_Q_ARG, .label = var->name, .symnode = var };
+	return arg;
+}
+
+static quad_arg * find_mapped(inline_state * state, void * key) {
+	for (int m = 0; m < state->map_count; m++) {
+		if (state->map[m].key == key)
+			return &state->map[m].value;
+	}
+	return NULL;
+}
+
+static void add_mapped(inline_state * state, void * key, quad_arg value) {
+	if (state->map_count == state->map_size) {
+		state->map_size = state->map_size ? state->map_size * 2 : INIT_MAP_SIZE;
+		state->map = realloc(state->map, state->map_size * sizeof(inline_map));
+		assert(state->map);
+	}
+	state->map[state->map_count].key = key;
+	state->map[state->map_count++].value = value;
+}
+
+/* the copy's stand-in for a temp, made on first sight */
+static quad_arg mapped_temp(inline_state * state, temp_var * temp) {
+	quad_arg * value = find_mapped(state, temp);
+	if (value)
+		return *value;
+
+	quad_arg copy = fresh_temp(state);
+	add_mapped(state, temp, copy);
+	return copy;
+}
+
+/* the copy's stand-in for a scalar local, made on first sight */
+static quad_arg mapped_local(inline_state * state, symnode_t * var) {
+	quad_arg * value = find_mapped(state, var);
+	if (value)
+		return *value;
+
+	quad_arg copy = fresh_local(state, var->name);
+	add_mapped(state, var, copy);
+	return copy;
+}
+
+static void map_arg(inline_state * state, call_site * site, quad_arg * arg) {
+	symnode_t * function = site->callee->function;
+	quad_arg * value;
+
+	switch (arg->type) {
+		case TEMP_VAR_Q_ARG:
+			*arg = mapped_temp(state, arg->temp);
+			break;
+
+		case SYMBOL_VAR_Q_ARG:
+			if (!get_local_scalar(arg))
+				break; 			// global
+			if (arg->symnode->s.v.specie == PARAMETER_VAR)
+				*arg = site->param_args[param_index(function, arg->symnode)];
+			else
+				*arg = mapped_local(state, arg->symnode);
+			break;
+
+		case SYMBOL_ARR_Q_ARG:
+			if (arg->temp && arg->int_literal != PASS_ARR_POINTER)
+				arg->temp = mapped_temp(state, arg->temp).temp;
+			if (arg->symnode->s.v.specie == PARAMETER_VAR) {
+				quad_arg * array = &site->param_args[param_index(function, arg->symnode)];
+				arg->symnode = array->symnode;
+				arg->label = array->label;
+			}
+			break;
+
+		case LABEL_Q_ARG:
+			value = find_mapped(state, arg->label);
+			if (value)
+				*arg = *value;
+			break;
+
+		default:
+			break;
+	}
+}
+
+/* the callee's body in place of the call, its return value in result */
+static void emit_body(inline_state * state, call_site * site, quad_arg * result) {
+	inline_callee * c = site->callee;
+	quad_arg zero = { .type = INT_LITERAL_Q_ARG, .int_literal = 0 };
+	char * epilog = state->old[c->last].args[0].label;
+	state->map_count = 0;
+
+	for (int i = c->first; i <= c->last; i++) {
+		if (state->old[i].op == LABEL_Q) {
+			quad_arg label = { .type = LABEL_Q_ARG, .label = new_pass_label("INLINE") };
+			add_mapped(state, state->old[i].args[0].label, label);
+		}
+	}
+
+	for (int i = c->first; i <= c->last; i++) {
+		quad q = state->old[i];
+
+		/* strings stay with the callee, which is still emitted */
+		if (q.op == STRING_Q)
+			continue;
+		/* the return right before the epilog falls through */
+		if (q.op == GOTO_Q && i == c->last - 1 && q.args[0].label == epilog)
+			continue;
+
+		for (int a = 0; a < QUAD_ARG_NUM; a++)
+			map_arg(state, site, &q.args[a]);
+
+		if (q.op == RET_Q)
+			emit(state, ASSIGN_Q, result, (q.args[0].type == NULL_ARG) ? &zero : &q.args[0]);
+		else
+			emit_quad(state, &q);
+	}
+}
+
+/*
+ * ---------- the pass ----------
+ */
+
+/* picks sites by priority until the budget runs out, numbering the chosen */
+static int choose_sites(inline_state * state, call_site * sites, int site_count, int * site_of) {
+	call_site ** order = (call_site **)malloc((site_count + 1) * sizeof(call_site *));
+	assert(order);
+	for (int s = 0; s < site_count; s++)
+		order[s] = &sites[s];
+	qsort(order, site_count, sizeof(call_site *), compare_sites);
+
+	int budget = state->old_count / INLINE_BUDGET_SHARE;
+	if (budget < INLINE_MIN_BUDGET)
+		budget = INLINE_MIN_BUDGET;
+
+	int chosen = 0;
+	for (int s = 0; s < site_count; s++) {
+		call_site * site = order[s];
+		if (site->callee->size > budget)
+			continue;
+		budget -= site->callee->size;
+
+		int id = site - sites;
+		site_of[site->precall] = id;
+		for (int k = 0; k < site->callee->function->s.f.arg_count; k++)
+			site_of[site->params[k]] = id;
+		chosen++;
+	}
+
+	free(order);
+	return chosen;
+}
+
+static void rebuild(inline_state * state, call_site * sites, int * site_of) {
+	state->size = state->old_count * 2 + 1;
+	state->arr = (quad *)malloc(state->size * sizeof(quad));
+	assert(state->arr);
+
+	for (int i = 0; i < state->old_count; i++) {
+		quad * q = &state->old[i];
+		if (site_of[i] < 0) {
+			emit_quad(state, q);
+			continue;
+		}
+
+		call_site * site = &sites[site_of[i]];
+		state->scope = find_function_scope(symtab,
+			find_in_top_symboltable(symtab, state->old[site->caller].args[0].label));
+		assert(state->scope);
+		symnode_t * function = site->callee->function;
+
+		/* a scalar argument is copied where it was pushed */
+		if (q->op == PARAM_Q) {
+			for (int k = 0; k < function->s.f.arg_count; k++) {
+				if (site->params[k] != i || function->s.f.arg_arr[k].modifier == ARRAY_DT)
+					continue;
+				site->param_args[k] = fresh_local(state, function->s.f.arg_arr[k].name);
+				emit(state, ASSIGN_Q, &site->param_args[k], &q->args[0]);
+			}
+			continue;
+		}
+
+		/* PRECALL_Q, POSTRET_Q and the copy of the return value */
+		quad_arg result = fresh_local(state, function->name);
+		emit_body(state, site, &result);
+		emit(state, ASSIGN_Q, &state->old[i + 2].args[0], &result);
+		i += 2;
+	}
+}
+
+int inline_functions() {
+	if (!quad_list || quad_list->count == 0)
+		return 0;
+
+	inline_state state = { .old = quad_list->arr, .old_count = quad_list->count };
+	if (find_callees(&state)) {
+		free(state.callees);
+		return 0;
+	}
+
+	int * depth = loop_depths(state.old, state.old_count);
+	call_site * sites = (call_site *)calloc(state.old_count, sizeof(call_site));
+	int * site_of = (int *)malloc(state.old_count * sizeof(int));
+	assert(sites && site_of);
+	for (int i = 0; i < state.old_count; i++)
+		site_of[i] = -1;
+
+	int site_count = find_call_sites(&state, sites, depth);
+	int chosen = 0;
+	if (site_count > 0)
+		chosen = choose_sites(&state, sites, site_count, site_of);
+
+	if (chosen > 0) {
+		rebuild(&state, sites, site_of);
+		free(quad_list->arr);
+		quad_list->arr = state.arr;
+		quad_list->count = state.count;
+		quad_list->size = state.size;
+	}
+
+	for (int s = 0; s < site_count; s++) {
+		free(sites[s].params);
+		free(sites[s].param_args);
+	}
+	free(sites);
+	free(site_of);
+	free(depth);
+	free(state.map);
+	free(state.callees);
+	return chosen;
+}
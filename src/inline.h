@@ -0,0 +1,32 @@
+/*
+ * inline.h
+ *
+ * inlining of small leaf functions at their call sites
+ * Yondon Fu and Matt McFarland - Delights (CS57 - 16W)
+ */
+
+#ifndef _INLINE_H
+#define _INLINE_H
+
+#include "quad.h"
+
+/*
+ * replaces calls of small functions that make no calls themselves (and so
+ * can't recurse) with a copy of the callee's body in the global quad_list:
+ *
+ * - each scalar PARAM_Q becomes a copy of the argument into a temp standing
+ *   in for the parameter, and an array argument takes the place of the
+ *   parameter array in the callee's element accesses
+ * - the callee's temps and scalar locals get fresh temps of the caller, its
+ *   labels fresh labels, and a RET_Q is a copy into the call's result
+ * - PRECALL_Q and POSTRET_Q go away
+ *
+ * calls in loops go first, then calls of smaller bodies, until the quads
+ * added use up a budget growing with the program. callees keep their own
+ * code. call before the other passes, which clean up the copies.
+ *
+ * returns the number of calls inlined
+ */
+int inline_functions();
+
+#endif 	// _INLINE_H
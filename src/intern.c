@@ -0,0 +1,109 @@
+/*
+ * intern.c
+ *
+ * hash-consed strings: the parser, new_label and make_temp_name all go
+ * through intern, so a name that shows up many times (an identifier used
+ * all over a function, a loop's exit label rebuilt by every break) is
+ * stored once, and comparing names is comparing pointers.
+ *
+ * Yondon Fu and Matt McFarland - Delights (CS57 - 16W)
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "intern.h"
+
+#define INIT_STRING_TABLE_SIZE 256 	// power of 2
+
+/* Peter Weinberger's hash function, from Aho, Sethi, & Ullman
+   p. 436. */
+static unsigned hashPJW(const char *s) {
+	unsigned h = 0, g;
+	const char *p;
+
+	for (p = s; *p != '\0'; p++) {
+		h = (h << 4) + *p;
+		if ((g = (h & 0xf0000000)) != 0)
+			h ^= (g >> 24) ^ g;
+	}
+
+	return h;
+}
+
+static intern_entry ** new_slots(int size) {
+	intern_entry ** slots = (intern_entry **)calloc(size, sizeof(intern_entry *));
+	if (!slots) {
+		fprintf(stderr, "intern: ran out of memory\n");
+		exit(1);
+	}
+	return slots;
+}
+
+string_table * create_string_table(arena * strings) {
+	string_table * table = (string_table *)calloc(1, sizeof(string_table));
+	if (!table) {
+		fprintf(stderr, "intern: ran out of memory\n");
+		exit(1);
+	}
+
+	table->size = INIT_STRING_TABLE_SIZE;
+	table->slots = new_slots(table->size);
+	table->strings = strings;
+	return table;
+}
+
+/*
+ * doubles the slot array, keeping the table at most half full
+ */
+static void grow_string_table(string_table * table) {
+	int size = table->size * 2;
+	intern_entry ** slots = new_slots(size);
+
+	for (int i = 0; i < table->size; i++) {
+		intern_entry * e = table->slots[i];
+		if (!e)
+			continue;
+
+		unsigned h = e->hash & (size - 1);
+		while (slots[h])
+			h = (h + 1) & (size - 1);
+		slots[h] = e;
+	}
+
+	free(table->slots);
+	table->slots = slots;
+	table->size = size;
+}
+
+char * intern(string_table * table, const char * s) {
+	unsigned hash = hashPJW(s);
+	unsigned h = hash & (table->size - 1);
+
+	for (intern_entry * e; (e = table->slots[h]) != NULL; h = (h + 1) & (table->size - 1)) {
+		if (e->hash == hash && strcmp(e->str, s) == 0)
+			return e->str;
+	}
+
+	size_t len = strlen(s) + 1;
+	intern_entry * e = (intern_entry *)arena_calloc(table->strings, 1, sizeof(intern_entry) + len);
+	e->hash = hash;
+	e->id = table->count;
+	memcpy(e->str, s, len);
+
+	table->slots[h] = e;
+	table->count++;
+	if (2 * table->count > table->size)
+		grow_string_table(table);
+
+	return e->str;
+}
+
+void destroy_string_table(string_table * table) {
+	if (!table)
+		return;
+
+	free(table->slots);
+	free(table);
+}
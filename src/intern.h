@@ -0,0 +1,59 @@
+/*
+ * intern.h
+ *
+ * string table that keeps one copy of every identifier, temp name and
+ * label, so two names are equal exactly when their pointers are
+ * Yondon Fu and Matt McFarland - Delights (CS57 - 16W)
+ */
+
+#ifndef _INTERN_H
+#define _INTERN_H
+
+#include <stddef.h>
+
+#include "arena.h"
+
+/*
+ * an interned string is the str of one of these -- the hash and id ride
+ * in front of it so intern_hash / intern_id are a load
+ */
+typedef struct intern_entry {
+	unsigned hash;
+	int id; 				// dense, in order of first intern
+	char str[];
+} intern_entry;
+
+typedef struct string_table {
+	intern_entry ** slots; 	// open addressing, size is a power of 2
+	int size;
+	int count;
+	arena * strings; 		// where the entries are allocated
+} string_table;
+
+/*
+ * string table of the current compilation -- created and released by main
+ * together with compile_arena
+ */
+extern string_table * compile_strings;
+
+string_table * create_string_table(arena * strings);
+
+/*
+ * returns the canonical copy of s, adding it if it's new. the result
+ * lives as long as the table's arena.
+ */
+char * intern(string_table * table, const char * s);
+
+/*
+ * hash / id of a string returned by intern (anything else is undefined)
+ */
+#define INTERN_ENTRY(S) 	((intern_entry *)((S) - offsetof(intern_entry, str)))
+#define intern_hash(S) 		(INTERN_ENTRY(S)->hash)
+#define intern_id(S) 		(INTERN_ENTRY(S)->id)
+
+/*
+ * frees the table itself; the strings go with the arena
+ */
+void destroy_string_table(string_table * table);
+
+#endif 	// _INTERN_H
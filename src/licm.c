@@ -0,0 +1,218 @@
+/*
+ * licm.c
+ *
+ * loop invariant code motion on SSA form.
+ *
+ * A version is defined once, so a quad whose operands all come from outside
+ * a loop computes the same value on every trip around it and can run once in
+ * the loop's preheader instead. Its result keeps its name and the preheader
+ * dominates every use of it, so nothing else changes. Only quads that can't
+ * fault or write memory move -- they may now run when the loop body
+ * wouldn't have, which costs a few instructions but changes nothing.
+ *
+ * Loops are visited inner first and each one's blocks in rpo, so a chain of
+ * invariant quads moves in one sweep, and a quad moved into an inner loop's
+ * preheader is looked at again as part of the loop around it.
+ *
+ * Yondon Fu and Matt McFarland - Delights (CS57 - 16W)
+ */
+
+#include <stdlib.h>
+#include <assert.h>
+
+#include "licm.h"
+#include "loops.h"
+#include "const_fold.h" 	// for is_binary_op()
+#include "liveness.h" 		// for get_quad_use_args(), get_quad_def_args()
+#include "symtab.h"
+
+#define INIT_STORED_COUNT 4
+
+typedef struct licm_state {
+	ssa_function * fn;
+	int * def_block; 			// by temp id: block defining the version
+	int def_size;
+
+	/* the loop being visited */
+	ssa_loop * loop;
+	int has_call;
+	symnode_t ** stored; 		// globals the loop writes
+	int stored_count;
+	int stored_size;
+} licm_state;
+
+static int is_global_scalar(quad_arg * arg) {
+	return arg->type == SYMBOL_VAR_Q_ARG && arg->symnode && arg->symnode->sym_type == VAR_SYM &&
+		arg->symnode->s.v.modifier == SINGLE_DT && arg->symnode->s.v.specie == GLOBAL_VAR;
+}
+
+static void record_defs(licm_state * state, ssa_block * b) {
+	for (int j = 0; j < b->phi_count; j++) {
+		if (is_version(state->fn, &b->phis[j].dest))
+			state->def_block[b->phis[j].dest.temp->id] = b->id;
+	}
+
+	quad_arg * defs[MAX_QUAD_REFS];
+	for (int i = 0; i < b->quad_count; i++) {
+		int count = get_quad_def_args(&b->quads[i], defs);
+		for (int d = 0; d < count; d++) {
+			if (is_version(state->fn, defs[d]))
+				state->def_block[defs[d]->temp->id] = b->id;
+		}
+	}
+}
+
+/* calls and stores to globals in the loop */
+static void scan_loop(licm_state * state) {
+	state->has_call = 0;
+	state->stored_count = 0;
+
+	quad_arg * defs[MAX_QUAD_REFS];
+	for (int i = 0; i < state->loop->block_count; i++) {
+		ssa_block * b = &state->fn->blocks[state->loop->blocks[i]];
+
+		for (int q = 0; q < b->quad_count; q++) {
+			if (b->quads[q].op == PRECALL_Q)
+				state->has_call = 1;
+
+			int count = get_quad_def_args(&b->quads[q], defs);
+			for (int d = 0; d < count; d++) {
+				if (!is_global_scalar(defs[d]))
+					continue;
+				if (state->stored_count == state->stored_size) {
+					state->stored_size = state->stored_size ? state->stored_size * 2 : INIT_STORED_COUNT;
+					state->stored = realloc(state->stored, state->stored_size * sizeof(symnode_t *));
+					assert(state->stored);
+				}
+				state->stored[state->stored_count++] = defs[d]->symnode;
+			}
+		}
+	}
+}
+
+/* does arg hold the same value on every trip around the loop? */
+static int is_invariant(licm_state * state, quad_arg * arg) {
+	switch (arg->type) {
+		case INT_LITERAL_Q_ARG:
+			return 1;
+
+		case TEMP_VAR_Q_ARG:
+			if (!is_version(state->fn, arg))
+				return 1; 		// value on entry
+			return arg->temp->id < state->def_size && state->def_block[arg->temp->id] != NO_BLOCK &&
+				!in_loop(state->loop, state->def_block[arg->temp->id]);
+
+		case SYMBOL_VAR_Q_ARG:
+			if (get_local_scalar(arg))
+				return 1; 		// every write is to a version
+			if (!is_global_scalar(arg) || state->has_call)
+				return 0;
+			for (int i = 0; i < state->stored_count; i++) {
+				if (state->stored[i] == arg->symnode)
+					return 0;
+			}
+			return 1;
+
+		default:
+			return 0; 		// array elements, return values ...
+	}
+}
+
+static int is_comparison(quad_op op) {
+	return op == LT_Q || op == GT_Q || op == LTE_Q || op == GTE_Q || op == NE_Q || op == EQ_Q;
+}
+
+/* can the quad at pos in b move to the preheader? */
+static int is_hoistable(licm_state * state, ssa_block * b, int pos) {
+	quad * q = &b->quads[pos];
+
+	if (!is_binary_op(q->op) && q->op != NOT_Q && q->op != NEG_Q && q->op != ASSIGN_Q)
+		return 0;
+	if (!is_version(state->fn, &q->args[0]))
+		return 0;
+
+	/* dividing by zero, or INT_MIN by -1, faults */
+	if ((q->op == DIV_Q || q->op == MOD_Q) && (q->args[2].type != INT_LITERAL_Q_ARG ||
+		q->args[2].int_literal == 0 || q->args[2].int_literal == -1))
+		return 0;
+
+	/*
+	 * a copy into a variable would only come back as a copy out of the
+	 * preheader's temp, and copying a literal costs what a load does
+	 */
+	if (q->op == ASSIGN_Q && (state->fn->origin[q->args[0].temp->id].type != TEMP_VAR_Q_ARG ||
+		q->args[1].type == INT_LITERAL_Q_ARG))
+		return 0;
+
+	/* a compare the next quad jumps on is fused with the jump */
+	if (is_comparison(q->op) && pos + 1 < b->quad_count) {
+		quad * next = &b->quads[pos + 1];
+		if ((next->op == IFFALSE_Q || next->op == IFTRUE_Q) && next->args[0].type == TEMP_VAR_Q_ARG &&
+			next->args[0].temp == q->args[0].temp)
+			return 0;
+	}
+
+	quad_arg * uses[MAX_QUAD_REFS];
+	int count = get_quad_use_args(q, uses);
+	for (int u = 0; u < count; u++) {
+		if (uses[u]->type != NULL_ARG && !is_invariant(state, uses[u]))
+			return 0;
+	}
+	return 1;
+}
+
+static int hoist_loop(licm_state * state) {
+	ssa_loop * l = state->loop;
+	int moved = 0;
+
+	scan_loop(state);
+
+	for (int i = 0; i < l->block_count; i++) {
+		ssa_block * b = &state->fn->blocks[l->blocks[i]];
+
+		for (int pos = ssa_block_start(b); pos < b->quad_count; pos++) {
+			if (!is_hoistable(state, b, pos))
+				continue;
+
+			ssa_block * p = &state->fn->blocks[l->preheader];
+			quad q = b->quads[pos];
+			ssa_remove_quad(b, pos--);
+			ssa_insert_quad(p, ssa_block_end(p, &q.args[0]), &q);
+			state->def_block[q.args[0].temp->id] = p->id;
+			moved++;
+		}
+	}
+	return moved;
+}
+
+static int hoist_function(ssa_function * fn) {
+	loop_list * loops = find_loops(fn);
+
+	licm_state state = { .fn = fn };
+	state.def_size = fn->origin_size;
+	state.def_block = (int *)malloc((state.def_size + 1) * sizeof(int));
+	assert(state.def_block);
+	for (int i = 0; i < state.def_size; i++)
+		state.def_block[i] = NO_BLOCK;
+	for (int r = 0; r < fn->rpo_count; r++)
+		record_defs(&state, &fn->blocks[fn->rpo[r]]);
+
+	int moved = 0;
+	for (int i = 0; i < loops->count; i++) {
+		state.loop = &loops->loops[i];
+		if (state.loop->preheader != NO_BLOCK)
+			moved += hoist_loop(&state);
+	}
+
+	free(state.stored);
+	free(state.def_block);
+	destroy_loops(loops);
+	return moved;
+}
+
+int hoist_loop_invariants(ssa_program * prog) {
+	int moved = 0;
+	for (int f = 0; f < prog->function_count; f++)
+		moved += hoist_function(prog->functions[f]);
+	return moved;
+}
@@ -0,0 +1,26 @@
+/*
+ * licm.h
+ *
+ * loop invariant code motion over SSA form
+ * Yondon Fu and Matt McFarland - Delights (CS57 - 16W)
+ */
+
+#ifndef _LICM_H
+#define _LICM_H
+
+#include "ssa.h"
+
+/*
+ * moves the computations each loop repeats with the same operands to its
+ * preheader, innermost loops first so a value can move out of several
+ * loops. a quad moves if it's arithmetic, a compare not feeding a jump, or
+ * a copy into a temp (an array index, say), and everything it reads is a
+ * literal, a value from outside the loop, a local's value on entry or a
+ * global the loop doesn't store to or call anything that could.
+ * DIV_Q / MOD_Q only move dividing by a literal that can't fault.
+ *
+ * returns the number of quads moved
+ */
+int hoist_loop_invariants(ssa_program * prog);
+
+#endif 	// _LICM_H
@@ -0,0 +1,307 @@
+/*
+ * liveness.c
+ *
+ * live variable analysis: a variable is live at a point if some path from
+ * there reads it before writing it. Solved per function as the usual
+ * backward dataflow problem over the cfg's blocks,
+ *
+ *     live_out(B) = union of live_in(S) for successors S
+ *     live_in(B)  = use(B) + (live_out(B) - def(B))
+ *
+ * iterated in postorder until nothing changes.
+ *
+ * Yondon Fu and Matt McFarland - Delights (CS57 - 16W)
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "liveness.h"
+#include "symtab.h"
+#include "IR_gen.h" 		// for PASS_ARR_POINTER
+
+extern quad_arr * quad_list;
+
+symnode_t * get_local_scalar(quad_arg * arg) {
+	if (!arg)
+		return NULL;
+
+	symnode_t * var;
+	if (arg->type == TEMP_VAR_Q_ARG)
+		var = (symnode_t *)arg->temp->temp_symnode;
+	else if (arg->type == SYMBOL_VAR_Q_ARG)
+		var = arg->symnode;
+	else
+		return NULL;
+
+	if (!var || var->sym_type != VAR_SYM || var->s.v.modifier != SINGLE_DT || var->s.v.specie == GLOBAL_VAR)
+		return NULL;
+	return var;
+}
+
+static void add_use(quad_arg * arg, symnode_t ** vars, int * count) {
+	/* array element -- its index temp is read */
+	if (arg->type == SYMBOL_ARR_Q_ARG) {
+		if (arg->temp != NULL && arg->int_literal != PASS_ARR_POINTER)
+			vars[(*count)++] = (symnode_t *)arg->temp->temp_symnode;
+		return;
+	}
+
+	symnode_t * var = get_local_scalar(arg);
+	if (var)
+		vars[(*count)++] = var;
+}
+
+int get_quad_use_args(quad * q, quad_arg ** args) {
+	int count = 0;
+
+	switch (q->op) {
+		case ADD_Q: case SUB_Q: case MUL_Q: case DIV_Q: case MOD_Q:
+		case LT_Q: case GT_Q: case LTE_Q: case GTE_Q: case NE_Q: case EQ_Q:
+		case PRE_INC_Q: case PRE_DEC_Q: case POST_INC_Q: case POST_DEC_Q:
+			args[count++] = &q->args[1];
+			args[count++] = &q->args[2];
+			break;
+
+		case NOT_Q:
+		case NEG_Q:
+		case ASSIGN_Q:
+			args[count++] = &q->args[1];
+			break;
+
+		case READ_Q:
+			break;
+
+		case IFFALSE_Q:
+		case IFTRUE_Q:
+		case PARAM_Q:
+		case RET_Q:
+		case PRINT_Q:
+			args[count++] = &q->args[0];
+			return count;
+
+		default:
+			return count;
+	}
+
+	/* storing into an array element reads the index */
+	if (q->args[0].type == SYMBOL_ARR_Q_ARG)
+		args[count++] = &q->args[0];
+
+	return count;
+}
+
+int get_quad_def_args(quad * q, quad_arg ** args) {
+	int count = 0;
+
+	switch (q->op) {
+		case PRE_INC_Q: case PRE_DEC_Q: case POST_INC_Q: case POST_DEC_Q:
+			args[count++] = &q->args[1];
+			/* fall through */
+		case ADD_Q: case SUB_Q: case MUL_Q: case DIV_Q: case MOD_Q:
+		case LT_Q: case GT_Q: case LTE_Q: case GTE_Q: case NE_Q: case EQ_Q:
+		case NOT_Q:
+		case NEG_Q:
+		case ASSIGN_Q:
+		case SIZEOF_Q:
+		case READ_Q:
+			args[count++] = &q->args[0];
+			break;
+
+		default:
+			break;
+	}
+
+	return count;
+}
+
+int get_quad_uses(quad * q, symnode_t ** vars) {
+	quad_arg * args[MAX_QUAD_REFS];
+	int arg_count = get_quad_use_args(q, args);
+
+	int count = 0;
+	for (int a = 0; a < arg_count; a++)
+		add_use(args[a], vars, &count);
+	return count;
+}
+
+int get_quad_defs(quad * q, symnode_t ** vars) {
+	quad_arg * args[MAX_QUAD_REFS];
+	int arg_count = get_quad_def_args(q, args);
+
+	int count = 0;
+	symnode_t * var;
+	for (int a = 0; a < arg_count; a++) {
+		if ((var = get_local_scalar(args[a])) != NULL)
+			vars[count++] = var;
+	}
+	return count;
+}
+
+static unsigned long hash_var(symnode_t * var, int size) {
+	return ((unsigned long)var >> 4) & (size - 1);
+}
+
+int get_live_var_number(liveness * info, symnode_t * var) {
+	unsigned long h = hash_var(var, info->map_size);
+
+	while (info->map_keys[h] != NULL) {
+		if (info->map_keys[h] == var)
+			return info->map_values[h];
+		h = (h + 1) & (info->map_size - 1);
+	}
+	return -1;
+}
+
+static void number_var(liveness * info, symnode_t * var) {
+	unsigned long h = hash_var(var, info->map_size);
+
+	while (info->map_keys[h] != NULL) {
+		if (info->map_keys[h] == var)
+			return;
+		h = (h + 1) & (info->map_size - 1);
+	}
+
+	info->map_keys[h] = var;
+	info->map_values[h] = info->var_count;
+	info->vars[info->var_count++] = var;
+}
+
+void step_live_backward(liveness * info, quad * q, live_set_word * set) {
+	symnode_t * vars[MAX_QUAD_REFS];
+	int count;
+
+	count = get_quad_defs(q, vars);
+	for (int v = 0; v < count; v++)
+		LIVE_REMOVE(set, get_live_var_number(info, vars[v]));
+
+	count = get_quad_uses(q, vars);
+	for (int v = 0; v < count; v++)
+		LIVE_ADD(set, get_live_var_number(info, vars[v]));
+}
+
+liveness * compute_liveness(cfg * graph) {
+	if (!graph)
+		return NULL;
+
+	liveness * info = (liveness *)calloc(1, sizeof(liveness));
+	assert(info);
+	info->graph = graph;
+
+	/*
+	 * number every variable the function reads or writes
+	 */
+	int ref_count = (graph->epilog - graph->prolog + 1) * MAX_QUAD_REFS * 2;
+	info->map_size = 16;
+	while (info->map_size < ref_count * 2)
+		info->map_size *= 2;
+	info->map_keys = (symnode_t **)calloc(info->map_size, sizeof(symnode_t *));
+	info->map_values = (int *)malloc(info->map_size * sizeof(int));
+	info->vars = (symnode_t **)malloc((ref_count + 1) * sizeof(symnode_t *));
+	assert(info->map_keys && info->map_values && info->vars);
+
+	symnode_t * vars[MAX_QUAD_REFS];
+	for (int i = graph->prolog; i <= graph->epilog; i++) {
+		int count = get_quad_uses(&quad_list->arr[i], vars);
+		for (int v = 0; v < count; v++)
+			number_var(info, vars[v]);
+
+		count = get_quad_defs(&quad_list->arr[i], vars);
+		for (int v = 0; v < count; v++)
+			number_var(info, vars[v]);
+	}
+
+	info->words = info->var_count / 32 + 1;
+	int set_bytes = graph->block_count * info->words * sizeof(live_set_word);
+	info->use = (live_set_word *)calloc(1, set_bytes);
+	info->def = (live_set_word *)calloc(1, set_bytes);
+	info->live_in = (live_set_word *)calloc(1, set_bytes);
+	info->live_out = (live_set_word *)calloc(1, set_bytes);
+	assert(info->use && info->def && info->live_in && info->live_out);
+
+	/*
+	 * local use / def of each block (walk backwards so a read after a write isn't a use)
+	 */
+	for (int id = 0; id < graph->block_count; id++) {
+		live_set_word * use = LIVE_SET(info->use, info, id);
+		live_set_word * def = LIVE_SET(info->def, info, id);
+
+		for (int i = graph->blocks[id].last; i >= graph->blocks[id].first; i--) {
+			quad * q = &quad_list->arr[i];
+			int count = get_quad_defs(q, vars);
+			for (int v = 0; v < count; v++) {
+				int n = get_live_var_number(info, vars[v]);
+				LIVE_ADD(def, n);
+				LIVE_REMOVE(use, n);
+			}
+
+			count = get_quad_uses(q, vars);
+			for (int v = 0; v < count; v++)
+				LIVE_ADD(use, get_live_var_number(info, vars[v]));
+		}
+	}
+
+	/*
+	 * iterate to a fixed point -- unreachable blocks are solved too, after the reachable ones
+	 */
+	int * order = (int *)malloc(graph->block_count * sizeof(int));
+	char * in_rpo = (char *)calloc(graph->block_count, sizeof(char));
+	assert(order && in_rpo);
+
+	int order_count = 0;
+	for (int r = graph->rpo_count - 1; r >= 0; r--) {
+		order[order_count++] = graph->rpo[r];
+		in_rpo[graph->rpo[r]] = 1;
+	}
+	for (int id = graph->block_count - 1; id >= 0; id--) {
+		if (!in_rpo[id])
+			order[order_count++] = id;
+	}
+
+	int changed = 1;
+	while (changed) {
+		changed = 0;
+
+		for (int o = 0; o < order_count; o++) {
+			int id = order[o];
+			basic_block * b = &graph->blocks[id];
+			live_set_word * out = LIVE_SET(info->live_out, info, id);
+			live_set_word * in = LIVE_SET(info->live_in, info, id);
+			live_set_word * use = LIVE_SET(info->use, info, id);
+			live_set_word * def = LIVE_SET(info->def, info, id);
+
+			for (int s = 0; s < b->succ_count; s++) {
+				live_set_word * succ_in = LIVE_SET(info->live_in, info, b->succs[s]);
+				for (int w = 0; w < info->words; w++)
+					out[w] |= succ_in[w];
+			}
+
+			for (int w = 0; w < info->words; w++) {
+				live_set_word new_in = use[w] | (out[w] & ~def[w]);
+				if (new_in != in[w]) {
+					in[w] = new_in;
+					changed = 1;
+				}
+			}
+		}
+	}
+
+	free(order);
+	free(in_rpo);
+	return info;
+}
+
+void destroy_liveness(liveness * info) {
+	if (!info)
+		return;
+
+	free(info->vars);
+	free(info->map_keys);
+	free(info->map_values);
+	free(info->use);
+	free(info->def);
+	free(info->live_in);
+	free(info->live_out);
+	free(info);
+}
@@ -0,0 +1,82 @@
+/*
+ * liveness.h
+ *
+ * live variable analysis over a function's control flow graph
+ * Yondon Fu and Matt McFarland - Delights (CS57 - 16W)
+ */
+
+#ifndef _LIVENESS_H
+#define _LIVENESS_H
+
+#include "quad.h"
+#include "cfg.h"
+
+#define MAX_QUAD_REFS 4 		// most scalars a quad can read or write
+
+typedef unsigned int live_set_word;
+
+/*
+ * live in / live out sets for every block of a cfg. tracked variables are
+ * temps and scalar locals/parameters (see get_local_scalar()), numbered
+ * 0 .. var_count - 1. each set is `words` live_set_words long.
+ */
+typedef struct liveness {
+	cfg * graph;
+
+	int var_count;
+	symnode_t ** vars; 		// variable number -> symbol
+	int map_size; 			// power of 2
+	symnode_t ** map_keys; 	// open addressing symbol -> variable number
+	int * map_values;
+
+	int words;
+	live_set_word * use; 		// read in block before any write (block_count sets)
+	live_set_word * def; 		// written in block
+	live_set_word * live_in;
+	live_set_word * live_out;
+} liveness;
+
+#define LIVE_SET(SETS, INFO, BLOCK) 	( (SETS) + (BLOCK) * (INFO)->words )
+#define LIVE_TEST(SET, N) 				( ((SET)[(N) / 32] >> ((N) % 32)) & 1u )
+#define LIVE_ADD(SET, N) 				( (SET)[(N) / 32] |= (1u << ((N) % 32)) )
+#define LIVE_REMOVE(SET, N) 			( (SET)[(N) / 32] &= ~(1u << ((N) % 32)) )
+
+/*
+ * symbol of a temp or non-global scalar variable (the values that only this
+ * function can see), NULL for anything else
+ */
+symnode_t * get_local_scalar(quad_arg * arg);
+
+/*
+ * fills vars with the local scalars quad q reads / writes. returns how many.
+ * an array element store writes memory, not a scalar, but reads its index temp.
+ */
+int get_quad_uses(quad * q, symnode_t ** vars);
+int get_quad_defs(quad * q, symnode_t ** vars);
+
+/*
+ * fills args with the operands quad q reads / writes, whatever they hold
+ * (literals, globals, ...). a SYMBOL_ARR_Q_ARG among the reads stands for
+ * its index temp. returns how many. passes rewrite operands through these.
+ */
+int get_quad_use_args(quad * q, quad_arg ** args);
+int get_quad_def_args(quad * q, quad_arg ** args);
+
+/*
+ * runs the backward dataflow analysis over graph
+ */
+liveness * compute_liveness(cfg * graph);
+
+/*
+ * variable number of var, or -1 if it isn't tracked
+ */
+int get_live_var_number(liveness * info, symnode_t * var);
+
+/*
+ * set = (set - defs(q)) + uses(q) -- walks a live set backwards over q
+ */
+void step_live_backward(liveness * info, quad * q, live_set_word * set);
+
+void destroy_liveness(liveness * info);
+
+#endif 	// _LIVENESS_H
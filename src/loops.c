@@ -0,0 +1,353 @@
+/*
+ * loops.c
+ *
+ * finds natural loops over the dominator tree of a function in SSA form
+ * and gives each one a preheader, the block loop invariant code moves to.
+ *
+ * A back edge is an edge into a block that dominates its source. The loop
+ * of a header is the header plus every block that reaches one of its back
+ * edges without passing the header -- found walking preds backwards from
+ * the edges' sources. Two loops are either nested or apart, so sorting them
+ * by size puts every inner loop before the loops around it.
+ *
+ * Yondon Fu and Matt McFarland - Delights (CS57 - 16W)
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "loops.h"
+#include "IR_gen.h" 	// for new_pass_label()
+#include "liveness.h" 	// for get_quad_use_args()
+
+#define INIT_LOOP_COUNT 4
+
+int in_loop(ssa_loop * l, int id) {
+	return id >= 0 && id < l->body_size && l->body[id];
+}
+
+static int compare_loop_size(const void * a, const void * b) {
+	const ssa_loop * x = (const ssa_loop *)a;
+	const ssa_loop * y = (const ssa_loop *)b;
+	if (x->block_count != y->block_count)
+		return x->block_count - y->block_count;
+	return x->header - y->header;
+}
+
+/* adds the blocks that reach latch without passing l's header */
+static void add_loop_blocks(ssa_function * fn, ssa_loop * l, int latch, int * stack) {
+	int top = 0;
+	if (!l->body[latch]) {
+		l->body[latch] = 1;
+		stack[top++] = latch;
+	}
+
+	while (top > 0) {
+		ssa_block * b = &fn->blocks[stack[--top]];
+		for (int k = 0; k < b->pred_count; k++) {
+			int p = b->preds[k];
+			if (!l->body[p] && fn->blocks[p].reachable) {
+				l->body[p] = 1;
+				stack[top++] = p;
+			}
+		}
+	}
+}
+
+static loop_list * detect_loops(ssa_function * fn) {
+	loop_list * loops = (loop_list *)calloc(1, sizeof(loop_list));
+	int * loop_of = (int *)malloc(fn->block_count * sizeof(int)); 	// header -> loop
+	int * stack = (int *)malloc(fn->block_count * sizeof(int));
+	assert(loops && loop_of && stack);
+	for (int id = 0; id < fn->block_count; id++)
+		loop_of[id] = -1;
+
+	int size = 0;
+	for (int r = 0; r < fn->rpo_count; r++) {
+		ssa_block * b = &fn->blocks[fn->rpo[r]];
+
+		for (int s = 0; s < b->succ_count; s++) {
+			int h = b->succs[s];
+			if (!ssa_dominates(fn, h, b->id))
+				continue;
+
+			if (loop_of[h] < 0) {
+				if (loops->count == size) {
+					size = size ? size * 2 : INIT_LOOP_COUNT;
+					loops->loops = realloc(loops->loops, size * sizeof(ssa_loop));
+					assert(loops->loops);
+				}
+				ssa_loop * l = &loops->loops[loops->count];
+				l->header = h;
+				l->preheader = NO_BLOCK;
+				l->body_size = fn->block_count;
+				l->body = (char *)calloc(l->body_size, sizeof(char));
+				assert(l->body);
+				l->body[h] = 1;
+				loop_of[h] = loops->count++;
+			}
+			add_loop_blocks(fn, &loops->loops[loop_of[h]], b->id, stack);
+		}
+	}
+
+	for (int i = 0; i < loops->count; i++) {
+		ssa_loop * l = &loops->loops[i];
+		l->blocks = (int *)malloc(fn->rpo_count * sizeof(int));
+		assert(l->blocks);
+		l->block_count = 0;
+		for (int r = 0; r < fn->rpo_count; r++) {
+			if (l->body[fn->rpo[r]])
+				l->blocks[l->block_count++] = fn->rpo[r];
+		}
+	}
+	qsort(loops->loops, loops->count, sizeof(ssa_loop), compare_loop_size);
+
+	free(stack);
+	free(loop_of);
+	return loops;
+}
+
+/* the one pred of l's header outside l, if it goes nowhere else */
+static int existing_preheader(ssa_function * fn, ssa_loop * l) {
+	ssa_block * h = &fn->blocks[l->header];
+	int outside = NO_BLOCK;
+
+	for (int k = 0; k < h->pred_count; k++) {
+		if (in_loop(l, h->preds[k]))
+			continue;
+		if (outside != NO_BLOCK)
+			return NO_BLOCK;
+		outside = h->preds[k];
+	}
+
+	if (outside != NO_BLOCK && fn->blocks[outside].succ_count == 1)
+		return outside;
+	return NO_BLOCK;
+}
+
+/* does b end in a jump? */
+static int ends_in_jump(ssa_block * b) {
+	if (b->quad_count == 0)
+		return 0;
+	quad_op op = b->quads[b->quad_count - 1].op;
+	return op == GOTO_Q || op == IFFALSE_Q || op == IFTRUE_Q;
+}
+
+/*
+ * puts a new block before l's header taking over its preds outside l.
+ * returns 0 if there are none, or if a block of l falls through into the
+ * header, leaving it be.
+ */
+static int add_preheader(ssa_function * fn, ssa_loop * l) {
+	int h_id = l->header;
+
+	int outside_count = 0;
+	for (int k = 0; k < fn->blocks[h_id].pred_count; k++)
+		outside_count += !in_loop(l, fn->blocks[h_id].preds[k]);
+	if (outside_count == 0)
+		return 0;
+
+	/* the block before the header in the layout would fall into the new one */
+	int before = NO_BLOCK;
+	for (int id = 0; id != h_id; id = fn->blocks[id].layout_next) {
+		if (fn->blocks[id].reachable)
+			before = id;
+	}
+	if (before != NO_BLOCK && in_loop(l, before)) {
+		ssa_block * b = &fn->blocks[before];
+		if (b->quad_count == 0 || b->quads[b->quad_count - 1].op != GOTO_Q)
+			return 0;
+	}
+
+	int p_id = ssa_add_block(fn, h_id);
+	ssa_block * h = &fn->blocks[h_id];
+	ssa_block * p = &fn->blocks[p_id];
+
+	/* outside preds move to p */
+	int * outside_k = (int *)malloc(h->pred_count * sizeof(int));
+	assert(outside_k);
+	outside_count = 0;
+	quad_arg label = NULL_QUAD_ARG;
+
+	for (int k = 0; k < h->pred_count; k++) {
+		if (in_loop(l, h->preds[k]))
+			continue;
+		outside_k[outside_count++] = k;
+
+		ssa_block * o = &fn->blocks[h->preds[k]];
+		for (int s = 0; s < o->succ_count; s++) {
+			if (o->succs[s] == h_id)
+				o->succs[s] = p_id;
+		}
+
+		/* a jump to the header now jumps to p */
+		if (ends_in_jump(o) && o->succs[0] == p_id) {
+			if (label.type == NULL_ARG) {
+				label.type = LABEL_Q_ARG;
+				label.label = new_pass_label("PREHEADER");
+			}
+			quad * jump = &o->quads[o->quad_count - 1];
+			jump->args[(jump->op == GOTO_Q) ? 0 : 1] = label;
+		}
+	}
+
+	if (label.type != NULL_ARG) {
+		quad q = { .op = LABEL_Q, .args = { label, NULL_QUAD_ARG, NULL_QUAD_ARG } };
+		ssa_insert_quad(p, 0, &q);
+	}
+
+	p->pred_size = outside_count;
+	p->preds = realloc(p->preds, p->pred_size * sizeof(int));
+	assert(p->preds);
+	for (int i = 0; i < outside_count; i++)
+		p->preds[p->pred_count++] = h->preds[outside_k[i]];
+
+	/*
+	 * a phi in the header gets the value from p -- the one outside value,
+	 * or a phi in p merging them
+	 */
+	for (int j = 0; j < h->phi_count; j++) {
+		ssa_phi * phi = &h->phis[j];
+		quad_arg value = phi->args[outside_k[0]];
+
+		if (outside_count > 1) {
+			quad_arg version = new_version(fn, &phi->dest);
+			ssa_phi * merge = ssa_add_phi(p, &version);
+			for (int i = 0; i < outside_count; i++)
+				merge->args[i] = phi->args[outside_k[i]];
+			value = version;
+		}
+
+		int kept = 0;
+		for (int k = 0; k < h->pred_count; k++) {
+			if (in_loop(l, h->preds[k]))
+				phi->args[kept++] = phi->args[k];
+		}
+		phi->args[kept] = value;
+	}
+
+	int kept = 0;
+	for (int k = 0; k < h->pred_count; k++) {
+		if (in_loop(l, h->preds[k]))
+			h->preds[kept++] = h->preds[k];
+	}
+	h->preds[kept++] = p_id;
+	h->pred_count = kept;
+
+	p->succs[0] = h_id;
+	p->succ_count = 1;
+
+	free(outside_k);
+	return 1;
+}
+
+/* the one value phi merges besides its own, if it's a temp */
+static temp_var * trivial_value(ssa_phi * phi, int pred_count) {
+	temp_var * value = NULL;
+
+	for (int k = 0; k < pred_count; k++) {
+		quad_arg * arg = &phi->args[k];
+		if (arg->type != TEMP_VAR_Q_ARG)
+			return NULL;
+		if (arg->temp == phi->dest.temp || arg->temp == value)
+			continue;
+		if (value)
+			return NULL;
+		value = arg->temp;
+	}
+	return value;
+}
+
+static temp_var * replacement(temp_var ** replaced, int size, temp_var * t) {
+	while (t->id < size && replaced[t->id])
+		t = replaced[t->id];
+	return t;
+}
+
+/*
+ * a header phi merging the value from the preheader with itself, as a new
+ * preheader leaves behind for a variable set on both sides of an if before
+ * the loop, is just that value -- and an invariant one
+ */
+static void remove_trivial_phis(ssa_function * fn) {
+	int size = fn->origin_size;
+	temp_var ** replaced = (temp_var **)calloc(size + 1, sizeof(temp_var *));
+	assert(replaced);
+
+	int changed;
+	do {
+		changed = 0;
+		for (int r = 0; r < fn->rpo_count; r++) {
+			ssa_block * b = &fn->blocks[fn->rpo[r]];
+			int kept = 0;
+
+			for (int j = 0; j < b->phi_count; j++) {
+				ssa_phi * phi = &b->phis[j];
+				for (int k = 0; k < b->pred_count; k++) {
+					if (phi->args[k].type == TEMP_VAR_Q_ARG)
+						phi->args[k].temp = replacement(replaced, size, phi->args[k].temp);
+				}
+
+				temp_var * value = trivial_value(phi, b->pred_count);
+				if (value && phi->dest.temp->id < size) {
+					replaced[phi->dest.temp->id] = value;
+					free(phi->args);
+					changed = 1;
+					continue;
+				}
+				b->phis[kept++] = *phi;
+			}
+			b->phi_count = kept;
+		}
+	} while (changed);
+
+	quad_arg * uses[MAX_QUAD_REFS];
+	for (int r = 0; r < fn->rpo_count; r++) {
+		ssa_block * b = &fn->blocks[fn->rpo[r]];
+		for (int i = 0; i < b->quad_count; i++) {
+			int count = get_quad_use_args(&b->quads[i], uses);
+			for (int u = 0; u < count; u++) {
+				quad_arg * arg = uses[u];
+				if (arg->type == TEMP_VAR_Q_ARG ||
+					(arg->type == SYMBOL_ARR_Q_ARG && arg->temp && arg->int_literal != PASS_ARR_POINTER))
+					arg->temp = replacement(replaced, size, arg->temp);
+			}
+		}
+	}
+
+	free(replaced);
+}
+
+loop_list * find_loops(ssa_function * fn) {
+	loop_list * loops = detect_loops(fn);
+
+	int added = 0;
+	for (int i = 0; i < loops->count; i++) {
+		ssa_loop * l = &loops->loops[i];
+		l->preheader = existing_preheader(fn, l);
+		if (l->preheader == NO_BLOCK)
+			added += add_preheader(fn, l);
+	}
+
+	/* the new blocks are in the loops around theirs */
+	if (added) {
+		ssa_update_cfg(fn);
+		remove_trivial_phis(fn);
+		destroy_loops(loops);
+		loops = detect_loops(fn);
+		for (int i = 0; i < loops->count; i++)
+			loops->loops[i].preheader = existing_preheader(fn, &loops->loops[i]);
+	}
+
+	return loops;
+}
+
+void destroy_loops(loop_list * loops) {
+	for (int i = 0; i < loops->count; i++) {
+		free(loops->loops[i].body);
+		free(loops->loops[i].blocks);
+	}
+	free(loops->loops);
+	free(loops);
+}
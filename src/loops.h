@@ -0,0 +1,49 @@
+/*
+ * loops.h
+ *
+ * natural loops of a function in SSA form, each with a preheader
+ * Yondon Fu and Matt McFarland - Delights (CS57 - 16W)
+ */
+
+#ifndef _LOOPS_H
+#define _LOOPS_H
+
+#include "ssa.h"
+
+/*
+ * every back edge n -> header (header dominates n) with the blocks that
+ * reach n without going through header. back edges into one header make
+ * one loop.
+ */
+typedef struct ssa_loop {
+	int header;
+	int preheader; 		// only pred of header outside the loop, NO_BLOCK if none
+	char * body; 		// by block id: is the block in the loop?
+	int body_size;
+	int * blocks; 		// the loop's blocks in rpo
+	int block_count;
+} ssa_loop;
+
+typedef struct loop_list {
+	ssa_loop * loops; 	// inner loops before the loops around them
+	int count;
+} loop_list;
+
+/*
+ * finds fn's natural loops. a loop whose header has more than one pred
+ * outside it, or one that also goes elsewhere, gets a new preheader block
+ * falling into the header, with jumps into the loop retargeted to it and
+ * phis for the values they brought. (a loop is left without one if a block
+ * inside it falls through into the header.) fn's rpo and dominators are
+ * kept up to date.
+ */
+loop_list * find_loops(ssa_function * fn);
+
+void destroy_loops(loop_list * loops);
+
+/*
+ * is block id in loop l?
+ */
+int in_loop(ssa_loop * l, int id);
+
+#endif 	// _LOOPS_H
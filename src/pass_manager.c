@@ -0,0 +1,140 @@
+/*
+ * pass_manager.c
+ *
+ * the table of optimization passes and the loop that runs a pipeline of
+ * them. passes over quads see the global quad_list; passes over SSA form
+ * share one ssa_program, built when the first of a run of SSA passes needs
+ * it and translated back when a quad pass (or the end) comes next.
+ *
+ * Yondon Fu and Matt McFarland - Delights (CS57 - 16W)
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "pass_manager.h"
+#include "const_fold.h"
+#include "dead_code.h"
+#include "sccp.h"
+#include "cse.h"
+#include "licm.h"
+#include "induction.h"
+#include "inline.h"
+#include "stats.h"
+#include "types.h" 		// for TRACE
+
+extern quad_arr * quad_list;
+
+static const opt_pass pass_table[] = {
+	{"inline", QUAD_PASS, inline_functions, NULL, "inlining of small leaf functions"},
+	{"fold", QUAD_PASS, fold_constants, NULL, "block local constant folding and propagation"},
+	{"dce", QUAD_PASS, eliminate_dead_code, NULL, "unreachable block and dead quad removal"},
+	{"sccp", SSA_PASS, NULL, propagate_conditional_constants, "sparse conditional constant propagation"},
+	{"cse", SSA_PASS, NULL, eliminate_common_subexpressions, "common subexpression elimination by value numbering"},
+	{"licm", SSA_PASS, NULL, hoist_loop_invariants, "loop invariant code motion"},
+	{"ivs", SSA_PASS, NULL, reduce_induction_variables, "strength reduction of induction variable indexing"},
+	{NULL, QUAD_PASS, NULL, NULL, NULL}
+};
+
+static const opt_pass * find_pass(const char * name, size_t length) {
+	for (int i = 0; pass_table[i].name != NULL; i++) {
+		if (strlen(pass_table[i].name) == length && strncmp(pass_table[i].name, name, length) == 0)
+			return &pass_table[i];
+	}
+	return NULL;
+}
+
+int set_opt_level(pass_pipeline * pipeline, int level) {
+	static const char * levels[] = { "", "fold,dce", "inline,fold,sccp,cse,licm,ivs,dce" };
+
+	if (level < 0 || level > 2)
+		return 1;
+	return parse_pass_list(pipeline, levels[level]);
+}
+
+int parse_pass_list(pass_pipeline * pipeline, const char * list) {
+	pipeline->count = 0;
+
+	while (*list != '\0') {
+		size_t length = strcspn(list, ",");
+		const opt_pass * pass = find_pass(list, length);
+
+		if (!pass) {
+			fprintf(stderr, "unknown pass %.*s\n", (int)length, list);
+			return 1;
+		}
+		if (pipeline->count == MAX_PIPELINE_PASSES) {
+			fprintf(stderr, "more than %d passes\n", MAX_PIPELINE_PASSES);
+			return 1;
+		}
+		pipeline->passes[pipeline->count++] = pass;
+
+		list += length;
+		if (*list == ',')
+			list++;
+	}
+	return 0;
+}
+
+static ssa_program * enter_ssa() {
+	TRACE(VERBOSE_PHASES, "building SSA form of %d quads\n", quad_list->count);
+	stats_begin_phase("ssa");
+	ssa_program * prog = build_ssa();
+	stats_end_phase();
+	return prog;
+}
+
+static void exit_ssa(pass_pipeline * pipeline, ssa_program * prog) {
+	if (pipeline->dump_ssa) {
+		printf("\n\n ----- PRINTING SSA FORM -----\n");
+		print_ssa(prog);
+	}
+
+	TRACE(VERBOSE_PHASES, "leaving SSA form\n");
+	stats_begin_phase("out-of-ssa");
+	leave_ssa(prog);
+	stats_end_phase();
+	stats_count("quads", quad_list->count);
+}
+
+int run_passes(pass_pipeline * pipeline) {
+	if (!quad_list)
+		return 0;
+
+	ssa_program * prog = NULL;
+	int total = 0;
+
+	for (int p = 0; p < pipeline->count; p++) {
+		const opt_pass * pass = pipeline->passes[p];
+		int changed;
+
+		if (pass->kind == SSA_PASS && !prog)
+			prog = enter_ssa();
+		if (pass->kind == QUAD_PASS && prog) {
+			exit_ssa(pipeline, prog);
+			prog = NULL;
+		}
+
+		stats_begin_phase(pass->name);
+		if (pass->kind == SSA_PASS)
+			changed = pass->run_ssa(prog);
+		else
+			changed = pass->run_quads();
+		stats_end_phase();
+		stats_count("changed", changed);
+		if (pass->kind == QUAD_PASS)
+			stats_count("quads", quad_list->count);
+
+		TRACE(VERBOSE_PHASES, "pass %s: %d changes\n", pass->name, changed);
+		total += changed;
+	}
+
+	if (prog)
+		exit_ssa(pipeline, prog);
+	return total;
+}
+
+void print_pass_names(FILE * fp) {
+	for (int i = 0; pass_table[i].name != NULL; i++)
+		fprintf(fp, "  %-6s %s\n", pass_table[i].name, pass_table[i].description);
+}
@@ -0,0 +1,67 @@
+/*
+ * pass_manager.h
+ *
+ * the optimization passes run between CG() and create_ys(), by -O level
+ * or as listed with --passes
+ * Yondon Fu and Matt McFarland - Delights (CS57 - 16W)
+ */
+
+#ifndef _PASS_MANAGER_H
+#define _PASS_MANAGER_H
+
+#include <stdio.h>
+#include "ssa.h"
+
+#define MAX_PIPELINE_PASSES 32
+
+/*
+ * a pass works on the quad list or on SSA form. the manager builds SSA
+ * form before an SSA pass and translates back before a quad pass (and at
+ * the end), so consecutive SSA passes share one SSA form.
+ */
+typedef enum pass_kind {
+	QUAD_PASS,
+	SSA_PASS
+} pass_kind;
+
+typedef struct opt_pass {
+	const char * name;
+	pass_kind kind;
+	int (*run_quads)(); 				// QUAD_PASS
+	int (*run_ssa)(ssa_program * prog); 	// SSA_PASS
+	const char * description;
+} opt_pass;
+
+typedef struct pass_pipeline {
+	const opt_pass * passes[MAX_PIPELINE_PASSES];
+	int count;
+	int dump_ssa; 		// print SSA form each time the pipeline leaves it
+} pass_pipeline;
+
+/*
+ * fills pipeline with the passes of -O level:
+ *   0  none
+ *   1  fold, dce
+ *   2  inline, fold, sccp, cse, licm, ivs, dce
+ * returns 1 for an unknown level
+ */
+int set_opt_level(pass_pipeline * pipeline, int level);
+
+/*
+ * fills pipeline from a comma separated list of pass names. returns 1 if a
+ * name is unknown or the list is too long.
+ */
+int parse_pass_list(pass_pipeline * pipeline, const char * list);
+
+/*
+ * runs the pipeline over the global quad_list, each pass as a --stats phase.
+ * returns the number of changes the passes reported.
+ */
+int run_passes(pass_pipeline * pipeline);
+
+/*
+ * one line per known pass, for usage messages
+ */
+void print_pass_names(FILE * fp);
+
+#endif 	// _PASS_MANAGER_H
@@ -0,0 +1,648 @@
+/*
+ * peephole.c
+ *
+ * print_code() translates one quad at a time, so neighbouring quads leave
+ * obvious redundancies behind: a temp stored and immediately loaded back,
+ * constants reloaded into a register that already holds them, values moved
+ * through %eax / %ebx only to be copied again, and jumps to jumps or to the
+ * very next label. create_ys() buffers each function's code in memory and
+ * runs the passes here over it before writing it out.
+ *
+ * Register use at labels and jumps follows from how quads are translated:
+ * %ebx and %edi are scratch inside a single quad so they are never live
+ * across one, %eax may carry a return value into the epilog, and the
+ * allocator's registers (%ecx, %edx, %esi) are assumed live everywhere.
+ *
+ * Yondon Fu and Matt McFarland - Delights (CS57 - 16W)
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+
+#include "peephole.h"
+#include "y86_code_gen.h" 	// for my_register_t
+
+#define INIT_BUFFER_SIZE 64
+#define MAX_CACHED_SLOTS 32 	// memory words remembered by forward_values
+#define MAX_JUMP_HOPS 16
+#define MAX_PEEPHOLE_ROUNDS 10
+#define IO_WINDOW 0x00FFFE00 	// memory mapped device registers (DSTR, DHXR, KHXR, ...) start here
+
+#define REG_MASK(X) 	( 1 << (X) )
+#define ALL_REGS 		0xff
+#define SCRATCH_REGS 	( REG_MASK(EBX_R) | REG_MASK(EDI_R) )
+
+int peephole_enabled = 1;
+
+static char * reg_names[] = {"%eax", "%ecx", "%edx", "%ebx", "%esp", "%ebp", "%esi", "%edi"};
+
+/*
+ * ----- parsing -----
+ */
+
+static y86_line * new_line(y86_buffer * buf, y86_line_kind kind) {
+	if (buf->count == buf->size) {
+		buf->size *= 2;
+		buf->lines = realloc(buf->lines, buf->size * sizeof(y86_line));
+		assert(buf->lines);
+	}
+
+	y86_line * l = &buf->lines[buf->count++];
+	memset(l, 0, sizeof(y86_line));
+	l->kind = kind;
+	return l;
+}
+
+static void copy_trimmed(char * dest, const char * src, int len) {
+	while (len > 0 && (*src == ' ' || *src == '\t')) {
+		src++;
+		len--;
+	}
+	while (len > 0 && (src[len - 1] == ' ' || src[len - 1] == '\t'))
+		len--;
+
+	if (len >= MAX_OPERAND_LEN)
+		len = MAX_OPERAND_LEN - 1;
+	memcpy(dest, src, len);
+	dest[len] = '\0';
+}
+
+static void parse_line(y86_buffer * buf, char * line) {
+	int len = strlen(line);
+
+	/* "nop # ..." lines are only there as comments -- keep the comment, drop the nop */
+	if (strncmp(line, "\tnop #", 6) == 0) {
+		y86_line * l = new_line(buf, LINE_OTHER);
+		l->text = (char *)malloc(len + 2);
+		assert(l->text);
+		sprintf(l->text, "\t%s\n", line + 5);
+		return;
+	}
+
+	if (line[0] == '\t' && line[1] != '#' && line[1] != '\0') {
+		y86_line * l = new_line(buf, LINE_INSTR);
+		char * rest = line + 1;
+		char * space = strchr(rest, ' ');
+		int op_len = space ? space - rest : (int)strlen(rest);
+
+		if (op_len >= MAX_OPCODE_LEN)
+			op_len = MAX_OPCODE_LEN - 1;
+		memcpy(l->op, rest, op_len);
+		l->op[op_len] = '\0';
+
+		if (space) {
+			char * comma = strstr(space, ", ");
+			if (comma) {
+				copy_trimmed(l->a, space, comma - space);
+				copy_trimmed(l->b, comma + 2, strlen(comma + 2));
+			} else {
+				copy_trimmed(l->a, space, strlen(space));
+			}
+		}
+		return;
+	}
+
+	if (len > 1 && line[len - 1] == ':' && line[0] != '\t') {
+		y86_line * l = new_line(buf, LINE_LABEL);
+		copy_trimmed(l->a, line, len - 1);
+		return;
+	}
+
+	y86_line * l = new_line(buf, LINE_OTHER);
+	l->text = (char *)malloc(len + 2);
+	assert(l->text);
+	sprintf(l->text, "%s\n", line);
+}
+
+static void parse_code(y86_buffer * buf, char * code) {
+	char * line = code;
+	while (*line != '\0') {
+		char * end = strchr(line, '\n');
+		if (end)
+			*end = '\0';
+
+		parse_line(buf, line);
+
+		if (!end)
+			break;
+		line = end + 1;
+	}
+}
+
+static void write_code(y86_buffer * buf, FILE * fp) {
+	for (int i = 0; i < buf->count; i++) {
+		y86_line * l = &buf->lines[i];
+		if (l->deleted)
+			continue;
+
+		switch (l->kind) {
+			case LINE_LABEL:
+				fprintf(fp, "%s:\n", l->a);
+				break;
+
+			case LINE_INSTR:
+				fprintf(fp, "\t%s", l->op);
+				if (l->a[0] != '\0')
+					fprintf(fp, " %s", l->a);
+				if (l->b[0] != '\0')
+					fprintf(fp, ", %s", l->b);
+				fprintf(fp, "\n");
+				break;
+
+			default:
+				fprintf(fp, "%s", l->text);
+				break;
+		}
+	}
+}
+
+/*
+ * ----- instruction effects -----
+ */
+
+/* register named exactly by operand, or -1 */
+static int reg_number(const char * operand) {
+	for (int r = 0; r < 8; r++) {
+		if (strcmp(operand, reg_names[r]) == 0)
+			return r;
+	}
+	return -1;
+}
+
+/* base register of a memory operand "D(%reg)", -1 for an absolute address */
+static int mem_base(const char * operand) {
+	const char * paren = strchr(operand, '(');
+	if (!paren)
+		return -1;
+
+	char reg[MAX_OPERAND_LEN];
+	copy_trimmed(reg, paren + 1, strcspn(paren + 1, ")"));
+	return reg_number(reg);
+}
+
+static int is_op(y86_line * l, const char * op) {
+	return l->kind == LINE_INSTR && strcmp(l->op, op) == 0;
+}
+
+static int is_jump(y86_line * l) {
+	return l->kind == LINE_INSTR && l->op[0] == 'j';
+}
+
+static int is_control(y86_line * l) {
+	return is_jump(l) || is_op(l, "call") || is_op(l, "ret") || is_op(l, "halt");
+}
+
+static int is_arith(y86_line * l) {
+	return is_op(l, "addl") || is_op(l, "subl") || is_op(l, "andl") || is_op(l, "xorl") ||
+		is_op(l, "mull") || is_op(l, "divl") || is_op(l, "modl");
+}
+
+static int bit_of(const char * operand) {
+	int r = reg_number(operand);
+	return r == -1 ? 0 : REG_MASK(r);
+}
+
+static int base_bit_of(const char * operand) {
+	int r = mem_base(operand);
+	return r == -1 ? 0 : REG_MASK(r);
+}
+
+/*
+ * registers l reads, and registers it overwrites without reading first
+ */
+static void get_effects(y86_line * l, int * reads, int * kills) {
+	*reads = 0;
+	*kills = 0;
+
+	if (is_op(l, "irmovl")) {
+		*kills = bit_of(l->b);
+	} else if (is_op(l, "rrmovl")) {
+		*reads = bit_of(l->a);
+		*kills = bit_of(l->b);
+	} else if (strncmp(l->op, "cmov", 4) == 0) {
+		*reads = bit_of(l->a) | bit_of(l->b); 	// destination survives if the move isn't taken
+	} else if (is_op(l, "mrmovl")) {
+		*reads = base_bit_of(l->a);
+		*kills = bit_of(l->b) & ~*reads;
+	} else if (is_op(l, "rmmovl")) {
+		*reads = bit_of(l->a) | base_bit_of(l->b);
+	} else if (is_arith(l)) {
+		*reads = bit_of(l->a) | bit_of(l->b);
+	} else if (is_op(l, "shll") || is_op(l, "shrl") || is_op(l, "iaddl")) {
+		*reads = bit_of(l->b); 		// first operand is an immediate
+	} else if (is_op(l, "pushl")) {
+		*reads = bit_of(l->a) | REG_MASK(ESP_R);
+	} else if (is_op(l, "popl")) {
+		*reads = REG_MASK(ESP_R);
+		*kills = bit_of(l->a);
+	} else if (!is_op(l, "nop")) {
+		*reads = ALL_REGS; 		// unknown -- assume the worst
+	}
+}
+
+/* registers that may be read after control reaches l */
+static int live_at(y86_line * l) {
+	if (l->kind == LINE_LABEL)
+		return ALL_REGS & ~SCRATCH_REGS;
+	if (is_op(l, "halt"))
+		return 0;
+	if (is_op(l, "call"))
+		return ALL_REGS & ~SCRATCH_REGS & ~REG_MASK(EAX_R);
+	return ALL_REGS & ~SCRATCH_REGS;
+}
+
+/*
+ * 1 if reg's value after line i is never read
+ */
+static int is_dead_after(y86_buffer * buf, int i, int reg) {
+	int bit = REG_MASK(reg);
+
+	for (int j = i + 1; j < buf->count; j++) {
+		y86_line * l = &buf->lines[j];
+		if (l->deleted || l->kind == LINE_OTHER)
+			continue;
+
+		if (l->kind == LINE_LABEL || is_control(l))
+			return !(live_at(l) & bit);
+
+		int reads, kills;
+		get_effects(l, &reads, &kills);
+		if (reads & bit)
+			return 0;
+		if (kills & bit)
+			return 1;
+	}
+	return 0;
+}
+
+/* next line after i that isn't deleted or a comment, or -1 */
+static int next_line(y86_buffer * buf, int i) {
+	for (int j = i + 1; j < buf->count; j++) {
+		if (!buf->lines[j].deleted && buf->lines[j].kind != LINE_OTHER)
+			return j;
+	}
+	return -1;
+}
+
+/*
+ * ----- forwarding -----
+ */
+
+typedef struct cached_slot {
+	char mem[MAX_OPERAND_LEN]; 	// memory operand
+	int reg; 					// register holding the same value
+} cached_slot;
+
+typedef struct value_state {
+	char reg_const[8][MAX_OPERAND_LEN]; 	// immediate each register holds, "" if unknown
+	cached_slot slots[MAX_CACHED_SLOTS];
+	int slot_count;
+} value_state;
+
+static void forget_all(value_state * s) {
+	for (int r = 0; r < 8; r++)
+		s->reg_const[r][0] = '\0';
+	s->slot_count = 0;
+}
+
+static void remove_slot(value_state * s, int k) {
+	s->slots[k] = s->slots[--s->slot_count];
+}
+
+/* reg is about to be overwritten */
+static void forget_reg(value_state * s, int reg) {
+	if (reg < 0)
+		return;
+
+	s->reg_const[reg][0] = '\0';
+	for (int k = s->slot_count - 1; k >= 0; k--) {
+		if (s->slots[k].reg == reg || mem_base(s->slots[k].mem) == reg)
+			remove_slot(s, k);
+	}
+}
+
+/*
+ * 1 if mem is an absolute address in the I/O window. a load there takes the
+ * next input and a store prints, so neither is ever a copy of the other.
+ */
+static int is_io_address(const char * mem) {
+	return !strchr(mem, '(') && strtoul(mem, NULL, 0) >= IO_WINDOW;
+}
+
+static int find_slot(value_state * s, char * mem) {
+	if (is_io_address(mem))
+		return -1;
+
+	for (int k = 0; k < s->slot_count; k++) {
+		if (strcmp(s->slots[k].mem, mem) == 0)
+			return k;
+	}
+	return -1;
+}
+
+static void remember_slot(value_state * s, char * mem, int reg) {
+	if (reg < 0 || mem_base(mem) == reg || is_io_address(mem))
+		return;
+
+	int k = find_slot(s, mem);
+	if (k == -1) {
+		if (s->slot_count == MAX_CACHED_SLOTS)
+			remove_slot(s, 0);
+		k = s->slot_count++;
+		strcpy(s->slots[k].mem, mem);
+	}
+	s->slots[k].reg = reg;
+}
+
+/*
+ * memory at mem is about to be written. frame slots (%ebp relative) only
+ * alias themselves, but a store through any other register may hit a frame
+ * slot of a local array, and absolute stores may hit anything not on the frame.
+ */
+static void forget_memory(value_state * s, char * mem) {
+	int base = mem_base(mem);
+
+	for (int k = s->slot_count - 1; k >= 0; k--) {
+		int slot_base = mem_base(s->slots[k].mem);
+		if (base != EBP_R || slot_base != EBP_R || strcmp(s->slots[k].mem, mem) == 0)
+			remove_slot(s, k);
+	}
+}
+
+int forward_values(y86_buffer * buf) {
+	value_state s;
+	forget_all(&s);
+	int changed = 0;
+
+	for (int i = 0; i < buf->count; i++) {
+		y86_line * l = &buf->lines[i];
+		if (l->deleted || l->kind == LINE_OTHER)
+			continue;
+
+		if (l->kind == LINE_LABEL) {
+			forget_all(&s);
+			continue;
+		}
+
+		if (is_op(l, "irmovl")) {
+			int dest = reg_number(l->b);
+			if (dest >= 0 && strcmp(s.reg_const[dest], l->a) == 0) {
+				l->deleted = 1; 		// already holds this constant
+				changed = 1;
+				continue;
+			}
+			forget_reg(&s, dest);
+			if (dest >= 0)
+				strcpy(s.reg_const[dest], l->a);
+
+		} else if (is_op(l, "rrmovl")) {
+			int src = reg_number(l->a);
+			int dest = reg_number(l->b);
+			if (src == dest) {
+				l->deleted = 1;
+				changed = 1;
+				continue;
+			}
+			forget_reg(&s, dest);
+			if (src >= 0 && dest >= 0)
+				strcpy(s.reg_const[dest], s.reg_const[src]);
+
+		} else if (is_op(l, "mrmovl")) {
+			int dest = reg_number(l->b);
+			int k = find_slot(&s, l->a);
+
+			if (k != -1 && s.slots[k].reg == dest) {
+				l->deleted = 1; 		// register already holds this word
+				changed = 1;
+				continue;
+			}
+
+			if (k != -1) {
+				/* load -> copy of the register that holds the word */
+				int src = s.slots[k].reg;
+				strcpy(l->op, "rrmovl");
+				strcpy(l->a, reg_names[src]);
+				changed = 1;
+
+				forget_reg(&s, dest);
+				if (dest >= 0)
+					strcpy(s.reg_const[dest], s.reg_const[src]);
+			} else {
+				char mem[MAX_OPERAND_LEN];
+				strcpy(mem, l->a);
+				forget_reg(&s, dest);
+				remember_slot(&s, mem, dest);
+			}
+
+		} else if (is_op(l, "rmmovl")) {
+			forget_memory(&s, l->b);
+			remember_slot(&s, l->b, reg_number(l->a));
+
+		} else if (is_op(l, "call") || is_op(l, "ret") || is_op(l, "halt") || is_op(l, "jmp")) {
+			forget_all(&s);
+
+		} else if (is_jump(l)) {
+			/*
+			 * conditional jumps change nothing on the fall through path, but
+			 * scratch registers must not be read past a jump (is_dead_after
+			 * takes them to be dead there)
+			 */
+			forget_reg(&s, EBX_R);
+			forget_reg(&s, EDI_R);
+
+		} else if (is_op(l, "pushl") || is_op(l, "popl")) {
+			forget_reg(&s, ESP_R);
+			if (is_op(l, "popl"))
+				forget_reg(&s, reg_number(l->a));
+
+		} else {
+			/* arithmetic, shifts and conditional moves write their second operand */
+			int reads, kills;
+			get_effects(l, &reads, &kills);
+			if (reads == ALL_REGS)
+				forget_all(&s);
+			else
+				forget_reg(&s, reg_number(l->b));
+		}
+	}
+
+	return changed;
+}
+
+/*
+ * ----- move coalescing -----
+ */
+
+int coalesce_moves(y86_buffer * buf) {
+	int changed = 0;
+
+	for (int i = 0; i < buf->count; i++) {
+		y86_line * l = &buf->lines[i];
+		if (l->deleted || l->kind != LINE_INSTR)
+			continue;
+
+		int j = next_line(buf, i);
+		if (j == -1 || buf->lines[j].kind != LINE_INSTR)
+			continue;
+		y86_line * next = &buf->lines[j];
+
+		/*
+		 * "load X, %t; rrmovl %t, %r" with %t dead after -> "load X, %r"
+		 */
+		if ((is_op(l, "irmovl") || is_op(l, "mrmovl") || is_op(l, "rrmovl")) && is_op(next, "rrmovl")) {
+			int temp = reg_number(l->b);
+			int dest = reg_number(next->b);
+
+			if (temp >= 0 && dest >= 0 && temp != dest && reg_number(next->a) == temp &&
+				temp != ESP_R && temp != EBP_R && is_dead_after(buf, j, temp)) {
+				strcpy(l->b, next->b);
+				next->deleted = 1;
+				changed = 1;
+				continue;
+			}
+		}
+
+		/*
+		 * "rrmovl %r, %t; op %t, Y" with %t dead after -> "op %r, Y"
+		 */
+		if (is_op(l, "rrmovl")) {
+			int src = reg_number(l->a);
+			int temp = reg_number(l->b);
+
+			if (src < 0 || temp < 0 || temp == ESP_R || temp == EBP_R || reg_number(next->a) != temp)
+				continue;
+
+			int only_first_operand =
+				((is_arith(next) || is_op(next, "rrmovl")) && reg_number(next->b) != temp) ||
+				(is_op(next, "rmmovl") && mem_base(next->b) != temp) ||
+				is_op(next, "pushl");
+
+			if (only_first_operand && is_dead_after(buf, j, temp)) {
+				strcpy(next->a, l->a);
+				l->deleted = 1;
+				changed = 1;
+			}
+		}
+	}
+
+	return changed;
+}
+
+/*
+ * ----- jumps -----
+ */
+
+typedef struct label_line {
+	char * name;
+	int line;
+} label_line;
+
+static int compare_label_line(const void * a, const void * b) {
+	return strcmp(((const label_line *)a)->name, ((const label_line *)b)->name);
+}
+
+static int find_label_line(label_line * labels, int count, char * name) {
+	label_line key;
+	key.name = name;
+	label_line * found = bsearch(&key, labels, count, sizeof(label_line), compare_label_line);
+	return found ? found->line : -1;
+}
+
+int thread_jumps(y86_buffer * buf) {
+	int changed = 0;
+
+	label_line * labels = (label_line *)malloc((buf->count + 1) * sizeof(label_line));
+	assert(labels);
+	int label_count = 0;
+	for (int i = 0; i < buf->count; i++) {
+		if (buf->lines[i].kind == LINE_LABEL && !buf->lines[i].deleted) {
+			labels[label_count].name = buf->lines[i].a;
+			labels[label_count].line = i;
+			label_count++;
+		}
+	}
+	qsort(labels, label_count, sizeof(label_line), compare_label_line);
+
+	for (int i = 0; i < buf->count; i++) {
+		y86_line * l = &buf->lines[i];
+		if (l->deleted || !is_jump(l))
+			continue;
+
+		/* follow chains of labels that just jump on */
+		for (int hop = 0; hop < MAX_JUMP_HOPS; hop++) {
+			int target = find_label_line(labels, label_count, l->a);
+			if (target == -1)
+				break;
+
+			int k = target;
+			while ((k = next_line(buf, k)) != -1 && buf->lines[k].kind == LINE_LABEL)
+				;
+			if (k == -1 || !is_op(&buf->lines[k], "jmp") || strcmp(buf->lines[k].a, l->a) == 0)
+				break;
+
+			strcpy(l->a, buf->lines[k].a);
+			changed = 1;
+		}
+
+		/* jump to a label we'd fall into anyway */
+		for (int k = next_line(buf, i); k != -1 && buf->lines[k].kind == LINE_LABEL; k = next_line(buf, k)) {
+			if (strcmp(buf->lines[k].a, l->a) == 0) {
+				l->deleted = 1;
+				changed = 1;
+				break;
+			}
+		}
+		if (l->deleted)
+			continue;
+
+		/* nothing falls into the code after an unconditional jump */
+		if (is_op(l, "jmp")) {
+			for (int k = next_line(buf, i); k != -1 && buf->lines[k].kind == LINE_INSTR; k = next_line(buf, k)) {
+				buf->lines[k].deleted = 1;
+				changed = 1;
+			}
+		}
+	}
+
+	free(labels);
+	return changed;
+}
+
+/*
+ * ----- driver -----
+ */
+
+int peephole_optimize(char * code, FILE * fp) {
+	y86_buffer buf;
+	buf.size = INIT_BUFFER_SIZE;
+	buf.count = 0;
+	buf.lines = (y86_line *)malloc(buf.size * sizeof(y86_line));
+	assert(buf.lines);
+
+	parse_code(&buf, code);
+
+	int before = 0;
+	for (int i = 0; i < buf.count; i++)
+		before += (buf.lines[i].kind == LINE_INSTR);
+
+	for (int round = 0; round < MAX_PEEPHOLE_ROUNDS; round++) {
+		int changed = forward_values(&buf);
+		changed |= coalesce_moves(&buf);
+		changed |= thread_jumps(&buf);
+		if (!changed)
+			break;
+	}
+
+	write_code(&buf, fp);
+
+	int after = 0;
+	for (int i = 0; i < buf.count; i++) {
+		after += (buf.lines[i].kind == LINE_INSTR && !buf.lines[i].deleted);
+		free(buf.lines[i].text);
+	}
+	free(buf.lines);
+
+	return before - after;
+}
@@ -0,0 +1,68 @@
+/*
+ * peephole.h
+ *
+ * peephole optimizer over the Y86 instructions of a function
+ * Yondon Fu and Matt McFarland - Delights (CS57 - 16W)
+ */
+
+#ifndef _PEEPHOLE_H
+#define _PEEPHOLE_H
+
+#include <stdio.h>
+
+#define MAX_OPCODE_LEN 8
+#define MAX_OPERAND_LEN 64
+
+/*
+ * 1 (default) to buffer each function's instructions and run the peephole
+ * pass before writing them, 0 (--no-peephole) to write print_code()'s
+ * output unchanged
+ */
+extern int peephole_enabled;
+
+typedef enum {
+	LINE_INSTR, 	// instruction
+	LINE_LABEL, 	// "name:"
+	LINE_OTHER 		// comment or anything else, copied through untouched
+} y86_line_kind;
+
+/*
+ * one line of a function's buffered code
+ */
+typedef struct y86_line {
+	y86_line_kind kind;
+	int deleted;
+	char op[MAX_OPCODE_LEN]; 		// opcode for instructions
+	char a[MAX_OPERAND_LEN]; 		// first operand, label name for labels
+	char b[MAX_OPERAND_LEN]; 		// second operand
+	char * text; 					// whole line for LINE_OTHER
+} y86_line;
+
+typedef struct y86_buffer {
+	y86_line * lines;
+	int count;
+	int size;
+} y86_buffer;
+
+/*
+ * parses code (a function's worth of print_code() output), optimizes it
+ * and writes the result to fp
+ *
+ * returns number of instructions removed
+ */
+int peephole_optimize(char * code, FILE * fp);
+
+/*
+ * the individual passes -- each returns 1 if it changed something
+ *
+ * forward_values: store->load forwarding and dropping reloads of constants or
+ * 		memory a register already holds
+ * coalesce_moves: folds a move through a dead scratch register into its neighbour
+ * thread_jumps: jumps to jumps go straight to the final target, jumps to the
+ * 		next instruction are dropped
+ */
+int forward_values(y86_buffer * buf);
+int coalesce_moves(y86_buffer * buf);
+int thread_jumps(y86_buffer * buf);
+
+#endif 	// _PEEPHOLE_H
@@ -41,6 +41,7 @@ typedef enum {
 
 	/* jump operations */
 	IFFALSE_Q, // If false, jump to label
+	IFTRUE_Q, // If true, jump to label
 	GOTO_Q, // Go to label
 
 	PRINT_Q, // Print
@@ -93,6 +94,7 @@ static val_name_pair quad_op_table[] = {
 
 	/* jump operations */
 	{IFFALSE_Q, "if false"}, 	
+	{IFTRUE_Q, "if true"},
 	{GOTO_Q, "goto"},
 
 	{PRINT_Q, "print"},
@@ -148,24 +150,32 @@ typedef struct quad_arg {
   symnode_t * symnode; 		// function node for function labels
 } quad_arg;
 
+/* value of an unused quad argument */
+#define NULL_QUAD_ARG 	((quad_arg){ .type = NULL_ARG })
+
 /*
  * Quad structure
  *
  * op -> enumerated
  * dest -> where to store result
  * arg1 / arg2 -> can be registers, numbers or labels
+ *
+ * the args live inside the quad (type NULL_ARG when unused), so passes can
+ * rewrite one quad's operand without touching any other quad
  */
 typedef struct quad {
   int number;
   quad_op op;
-  quad_arg * args[QUAD_ARG_NUM];
+  quad_arg args[QUAD_ARG_NUM];
 } quad;
 
 /*
- * dynamically sized array of quads
+ * dynamically sized, contiguous array of quads -- arr[i].number == i.
+ * growing it moves the quads, so hold indices rather than quad pointers
+ * across gen_quad.
  */
 typedef struct quad_arr {
-  quad ** arr;
+  quad * arr;
   int size;       // max size
   int count;      // number of current entries (points at first unused entry)
 } quad_arr;
@@ -0,0 +1,444 @@
+/*
+ * reg_alloc.c
+ *
+ * linear scan register allocation for temps and scalar locals / parameters.
+ *
+ * Each function's quads are scanned once to build a live interval (quad index of
+ * first and last reference) for every candidate. Intervals that overlap a loop are
+ * stretched over the whole loop body when the variable is live at the loop's head
+ * (from liveness analysis), since its value can flow around the back edge.
+ * Intervals are then handed the free registers in order of their start; when we
+ * run out, whichever interval is cheapest to keep in memory (fewest
+ * references, weighted by loop depth) is spilled back to its frame slot.
+ *
+ * Allocated registers are callee saved: a function stores the registers it uses
+ * in its own frame during the prolog and restores them in the epilog, so values
+ * can stay in registers across calls.
+ *
+ * Yondon Fu and Matt McFarland - Delights (CS57 - 16W)
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+
+#include "reg_alloc.h"
+#include "IR_gen.h"
+#include "cfg.h"
+#include "liveness.h"
+#include "y86_code_gen.h" 	// for register numbers, is_fused_compare()
+#include "types.h"
+
+#define INIT_INTERVAL_COUNT 32
+#define LOOP_WEIGHT 8 			// a reference inside a loop counts this many times more
+#define MAX_LOOP_WEIGHT_DEPTH 4 // deeper loops don't weigh any more (avoids overflow)
+
+extern quad_arr * quad_list; 		// global quad list
+extern symboltable_t * symtab; 		// for function symbols
+
+/*
+ * registers that are never used as scratch space by the quad translation
+ * (%eax and %ebx hold operands, %edi holds array pointers)
+ */
+static int allocatable_regs[] = { ECX_R, EDX_R, ESI_R };
+
+#define NUM_ALLOCATABLE ( (int)(sizeof(allocatable_regs) / sizeof(allocatable_regs[0])) )
+
+/*
+ * dynamically sized array of intervals
+ */
+typedef struct interval_list {
+	live_interval * arr;
+	int count;
+	int size;
+	int * temp_map; 	// temp id -> index in arr (or -1)
+	int temp_map_size;
+} interval_list;
+
+/*
+ * back edge of a loop -- jump at tail goes back up to label at head
+ */
+typedef struct loop_range {
+	int head;
+	int tail;
+} loop_range;
+
+typedef struct loop_list {
+	loop_range * arr;
+	int count;
+	int size;
+} loop_list;
+
+/*
+ * returns 1 if var can be kept in a register (temps and scalar locals / params)
+ */
+static int is_candidate(symnode_t * var) {
+	if (!var || var->sym_type != VAR_SYM || var->s.v.modifier != SINGLE_DT)
+		return 0;
+
+	return var->s.v.specie == TEMP_VAR || var->s.v.specie == LOCAL_VAR || var->s.v.specie == PARAMETER_VAR;
+}
+
+/*
+ * returns the index of var's interval in lst, creating a new one if needed
+ */
+static int find_interval(interval_list * lst, symnode_t * var, temp_var * temp) {
+
+	/* temps are looked up by id */
+	if (temp != NULL) {
+		if (temp->id >= lst->temp_map_size) {
+			int new_size = lst->temp_map_size;
+			while (temp->id >= new_size)
+				new_size *= 2;
+			lst->temp_map = realloc(lst->temp_map, new_size * sizeof(int));
+			assert(lst->temp_map);
+			for (int i = lst->temp_map_size; i < new_size; i++)
+				lst->temp_map[i] = -1;
+			lst->temp_map_size = new_size;
+		}
+
+		if (lst->temp_map[temp->id] != -1)
+			return lst->temp_map[temp->id];
+
+	/* named variables are few, so just search */
+	} else {
+		for (int i = 0; i < lst->count; i++) {
+			if (lst->arr[i].var == var)
+				return i;
+		}
+	}
+
+	/* first reference -- make new interval */
+	if (lst->count == lst->size) {
+		lst->size *= 2;
+		lst->arr = realloc(lst->arr, lst->size * sizeof(live_interval));
+		assert(lst->arr);
+	}
+
+	live_interval * iv = &lst->arr[lst->count];
+	iv->var = var;
+	iv->start = -1;
+	iv->end = -1;
+	iv->weight = 0;
+	iv->reg = NO_REG;
+
+	if (temp != NULL)
+		lst->temp_map[temp->id] = lst->count;
+
+	return lst->count++;
+}
+
+/*
+ * records a reference to var (or temp) at quad index
+ */
+static void add_reference(interval_list * lst, symnode_t * var, temp_var * temp, int index, int weight) {
+	if (!is_candidate(var))
+		return;
+
+	int index_in_list = find_interval(lst, var, temp); 	// may grow lst->arr
+	live_interval * iv = &lst->arr[index_in_list];
+
+	if (iv->start == -1)
+		iv->start = index;
+	iv->end = index;
+	iv->weight += weight;
+}
+
+/*
+ * records the variables referenced by one quad argument
+ */
+static void add_arg_references(interval_list * lst, quad_arg * arg, int index, int weight) {
+	if (!arg)
+		return;
+
+	switch (arg->type) {
+		case TEMP_VAR_Q_ARG:
+			add_reference(lst, (symnode_t *)arg->temp->temp_symnode, arg->temp, index, weight);
+			break;
+
+		case SYMBOL_VAR_Q_ARG:
+			add_reference(lst, arg->symnode, NULL, index, weight);
+			break;
+
+		case SYMBOL_ARR_Q_ARG:
+			/* index temp is always read, even when storing into the array */
+			if (arg->temp != NULL)
+				add_reference(lst, (symnode_t *)arg->temp->temp_symnode, arg->temp, index, weight);
+			break;
+
+		default:
+			break;
+	}
+}
+
+/*
+ * collects the back edges (jumps up to an earlier label) in [prolog, epilog]
+ */
+static void find_loops(loop_list * loops, int prolog, int epilog) {
+	loops->count = 0;
+	loops->size = 8;
+	loops->arr = (loop_range *)calloc(loops->size, sizeof(loop_range));
+	assert(loops->arr);
+
+	for (int i = prolog; i <= epilog; i++) {
+		quad * q = &quad_list->arr[i];
+		char * target;
+
+		if (q->op == GOTO_Q)
+			target = q->args[0].label;
+		else if (q->op == IFFALSE_Q || q->op == IFTRUE_Q)
+			target = q->args[1].label;
+		else
+			continue;
+
+		int head = find_label_quad(target, prolog, i);
+		if (head == -1)
+			continue;
+
+		loops->arr[loops->count].head = head;
+		loops->arr[loops->count].tail = i;
+		loops->count++;
+		if (loops->count == loops->size) {
+			loops->size *= 2;
+			loops->arr = realloc(loops->arr, loops->size * sizeof(loop_range));
+			assert(loops->arr);
+		}
+	}
+}
+
+/*
+ * how much a reference at quad index counts towards keeping its variable in a register
+ */
+static int reference_weight(loop_list * loops, int index) {
+	int weight = 1;
+	int depth = 0;
+
+	for (int l = 0; l < loops->count; l++) {
+		if (loops->arr[l].head <= index && index <= loops->arr[l].tail && depth < MAX_LOOP_WEIGHT_DEPTH) {
+			weight *= LOOP_WEIGHT;
+			depth++;
+		}
+	}
+	return weight;
+}
+
+/*
+ * stretches intervals over loops their values can live across
+ */
+static void extend_over_loops(interval_list * lst, loop_list * loops, liveness * info) {
+
+	/*
+	 * a variable live at a loop's head is read before it's written again,
+	 * on the next trip round or after the loop, so it has to survive the
+	 * whole loop -- whether it's a temp, a local or written more than once.
+	 * anything else is dead by the time the loop repeats.
+	 */
+	int changed = 1;
+	while (changed) {
+		changed = 0;
+		for (int l = 0; l < loops->count; l++) {
+			loop_range * loop = &loops->arr[l];
+			live_set_word * live = LIVE_SET(info->live_in, info, get_block_of_quad(info->graph, loop->head));
+
+			for (int i = 0; i < lst->count; i++) {
+				live_interval * iv = &lst->arr[i];
+
+				if (iv->end < loop->head || iv->start > loop->tail)
+					continue;
+
+				int n = get_live_var_number(info, iv->var);
+				if (n != -1 && !LIVE_TEST(live, n))
+					continue;
+
+				if (iv->start > loop->head) {
+					iv->start = loop->head;
+					changed = 1;
+				}
+				if (iv->end < loop->tail) {
+					iv->end = loop->tail;
+					changed = 1;
+				}
+			}
+		}
+	}
+}
+
+/* sort intervals by start, heavier intervals first on ties */
+static int compare_start(const void * a, const void * b) {
+	const live_interval * x = *(live_interval * const *)a;
+	const live_interval * y = *(live_interval * const *)b;
+
+	if (x->start != y->start)
+		return x->start - y->start;
+	return y->weight - x->weight;
+}
+
+void allocate_registers() {
+	if (!quad_list)
+		return;
+
+	for (int i = 0; i < quad_list->count; i++) {
+		if (quad_list->arr[i].op != PROLOG_Q)
+			continue;
+
+		int prolog = i;
+		while (i < quad_list->count && quad_list->arr[i].op != EPILOG_Q)
+			i++;
+
+		if (i < quad_list->count)
+			allocate_function_registers(prolog, i);
+	}
+}
+
+void allocate_function_registers(int prolog, int epilog) {
+	interval_list lst;
+	lst.size = INIT_INTERVAL_COUNT;
+	lst.count = 0;
+	lst.arr = (live_interval *)calloc(lst.size, sizeof(live_interval));
+	assert(lst.arr);
+	lst.temp_map_size = INIT_INTERVAL_COUNT;
+	lst.temp_map = (int *)malloc(lst.temp_map_size * sizeof(int));
+	assert(lst.temp_map);
+	for (int i = 0; i < lst.temp_map_size; i++)
+		lst.temp_map[i] = -1;
+
+	loop_list loops;
+	find_loops(&loops, prolog, epilog);
+
+	/*
+	 * build intervals
+	 */
+	for (int i = prolog; i <= epilog; i++) {
+		quad * q = &quad_list->arr[i];
+		int weight = reference_weight(&loops, i);
+
+		for (int a = 0; a < QUAD_ARG_NUM; a++) {
+			quad_arg * arg = &q->args[a];
+			if (arg->type == NULL_ARG)
+				continue;
+
+			/* a fused comparison's result only ever lives in the condition codes */
+			if (a == 0 && (is_fused_compare(i) || ((q->op == IFFALSE_Q || q->op == IFTRUE_Q) && is_fused_compare(i - 1))))
+				continue;
+
+			/* parameters arrive in the frame, so they're live from the prolog on */
+			if (arg->type == SYMBOL_VAR_Q_ARG && arg->symnode->s.v.specie == PARAMETER_VAR)
+				add_reference(&lst, arg->symnode, NULL, prolog, 0);
+
+			add_arg_references(&lst, arg, i, weight);
+		}
+	}
+
+	cfg * graph = build_cfg(prolog, epilog);
+	liveness * info = compute_liveness(graph);
+	extend_over_loops(&lst, &loops, info);
+	destroy_liveness(info);
+	destroy_cfg(graph);
+
+	/*
+	 * linear scan
+	 */
+	live_interval ** sorted = (live_interval **)calloc(lst.count + 1, sizeof(live_interval *));
+	live_interval ** active = (live_interval **)calloc(NUM_ALLOCATABLE + 1, sizeof(live_interval *));
+	assert(sorted && active);
+
+	for (int i = 0; i < lst.count; i++)
+		sorted[i] = &lst.arr[i];
+	qsort(sorted, lst.count, sizeof(live_interval *), compare_start);
+
+	int active_count = 0;
+	int reg_free[NUM_ALLOCATABLE];
+	for (int r = 0; r < NUM_ALLOCATABLE; r++)
+		reg_free[r] = 1;
+
+	for (int i = 0; i < lst.count; i++) {
+		live_interval * iv = sorted[i];
+
+		/* expire intervals that ended before this one starts */
+		for (int a = 0; a < active_count; ) {
+			if (active[a]->end < iv->start) {
+				for (int r = 0; r < NUM_ALLOCATABLE; r++) {
+					if (allocatable_regs[r] == active[a]->reg)
+						reg_free[r] = 1;
+				}
+				active[a] = active[--active_count];
+			} else {
+				a++;
+			}
+		}
+
+		/* grab a free register */
+		int r;
+		for (r = 0; r < NUM_ALLOCATABLE && !reg_free[r]; r++)
+			;
+
+		if (r < NUM_ALLOCATABLE) {
+			reg_free[r] = 0;
+			iv->reg = allocatable_regs[r];
+			active[active_count++] = iv;
+			continue;
+		}
+
+		/* no registers left -- spill whichever interval is cheapest to leave in memory */
+		int cheapest = 0;
+		for (int a = 1; a < active_count; a++) {
+			if (active[a]->weight < active[cheapest]->weight || 
+				(active[a]->weight == active[cheapest]->weight && active[a]->end > active[cheapest]->end))
+				cheapest = a;
+		}
+
+		if (active[cheapest]->weight < iv->weight) {
+			iv->reg = active[cheapest]->reg;
+			active[cheapest]->reg = NO_REG;
+			active[cheapest] = iv;
+		}
+	}
+
+	/*
+	 * record assignments and reserve save slots in the frame
+	 */
+	symnode_t * func_sym = find_in_top_symboltable(symtab, quad_list->arr[prolog].args[0].label);
+	assert(func_sym);
+
+	int saved_regs = 0;
+	for (int i = 0; i < lst.count; i++) {
+		lst.arr[i].var->s.v.reg = lst.arr[i].reg;
+		if (lst.arr[i].reg != NO_REG)
+			saved_regs |= REG_BIT(lst.arr[i].reg);
+	}
+
+	func_sym->s.f.saved_regs = saved_regs;
+	func_sym->s.f.reg_save_offset = func_sym->s.f.stk_offset - TYPE_SIZE(INT_TS);
+	for (int r = EAX_R; r <= EDI_R; r++) {
+		if (saved_regs & REG_BIT(r))
+			func_sym->s.f.stk_offset -= TYPE_SIZE(INT_TS);
+	}
+
+	free(loops.arr);
+	free(sorted);
+	free(active);
+	free(lst.temp_map);
+	free(lst.arr);
+}
+
+int get_arg_register(quad_arg * arg) {
+	if (!arg)
+		return NO_REG;
+
+	switch (arg->type) {
+		case TEMP_VAR_Q_ARG:
+			return ((symnode_t *)arg->temp->temp_symnode)->s.v.reg;
+
+		case SYMBOL_VAR_Q_ARG:
+			return arg->symnode->s.v.reg;
+
+		case SYMBOL_ARR_Q_ARG:
+			if (arg->temp != NULL)
+				return ((symnode_t *)arg->temp->temp_symnode)->s.v.reg;
+			return NO_REG;
+
+		default:
+			return NO_REG;
+	}
+}
@@ -0,0 +1,48 @@
+/*
+ * reg_alloc.h
+ *
+ * header file for the linear scan register allocator
+ * Yondon Fu and Matt McFarland - Delights (CS57 - 16W)
+ */
+
+#ifndef _REG_ALLOC_H
+#define _REG_ALLOC_H
+
+#include "quad.h"
+#include "symtab.h"
+
+#define REG_BIT(X) ( 1 << (X) )
+
+/*
+ * live range of a temp or scalar local over a function's quads
+ */
+typedef struct live_interval {
+	symnode_t * var; 		// temp or variable symbol
+	int start; 				// quad index of first reference
+	int end; 				// quad index of last reference
+	int weight; 			// references weighted by loop depth -- cost of spilling
+	int reg; 				// assigned register, or NO_REG (like var_symbol.reg)
+} live_interval;
+
+/*
+ * runs the allocator over every function in the global quad_list.
+ * must be called after set_variable_memory_locations() because register
+ * save slots are added below each function's locals and temps.
+ *
+ * sets var_symbol.reg for every enregistered variable and the saved_regs
+ * mask / reg_save_offset of each function symbol
+ */
+void allocate_registers();
+
+/*
+ * allocates registers for the function whose quads are in [prolog, epilog]
+ */
+void allocate_function_registers(int prolog, int epilog);
+
+/*
+ * returns register holding arg's value, or NO_REG if it lives in memory.
+ * for SYMBOL_ARR_Q_ARG this is the register of the index temp.
+ */
+int get_arg_register(quad_arg * arg);
+
+#endif 	// _REG_ALLOC_H
@@ -0,0 +1,302 @@
+/*
+ * sccp.c
+ *
+ * sparse conditional constant propagation (Wegman and Zadeck) on SSA form.
+ *
+ * Every version starts out unknown. It becomes a constant once a definition
+ * that can run evaluates to one, and varying once it could hold two values;
+ * values only ever move down that way. A block counts only once an edge
+ * into it is known to run, and a branch on a constant only runs one of its
+ * edges, so definitions on the side never taken can't spoil a phi.
+ *
+ * Instead of the def-use worklists of the paper the reachable blocks are
+ * swept in reverse postorder until nothing moves -- the lattice is three
+ * levels deep, so that takes a few sweeps, and SSA form doesn't keep def-use
+ * chains for the worklists to follow.
+ *
+ * Yondon Fu and Matt McFarland - Delights (CS57 - 16W)
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "sccp.h"
+#include "const_fold.h" 	// for eval_binary_op(), eval_sizeof()
+#include "liveness.h" 		// for get_quad_use_args(), get_quad_def_args()
+
+#define UNKNOWN_VALUE 0
+#define CONSTANT_VALUE 1
+#define VARYING_VALUE 2
+
+typedef struct lattice_value {
+	int level;
+	int value; 		// if CONSTANT_VALUE
+} lattice_value;
+
+typedef struct sccp_state {
+	ssa_function * fn;
+	lattice_value * values; 	// by temp id
+	int value_count;
+	char * executable; 			// by block
+	char ** edge_executable; 	// by block, parallel to its preds
+	int changed;
+} sccp_state;
+
+static lattice_value make_value(int level, int value) {
+	lattice_value v = { .level = level, .value = value };
+	return v;
+}
+
+static lattice_value value_of(sccp_state * state, quad_arg * arg) {
+	if (arg->type == INT_LITERAL_Q_ARG)
+		return make_value(CONSTANT_VALUE, arg->int_literal);
+	if (is_version(state->fn, arg) && arg->temp->id < state->value_count)
+		return state->values[arg->temp->id];
+	return make_value(VARYING_VALUE, 0); 	// globals, entry values, memory ...
+}
+
+static lattice_value meet(lattice_value a, lattice_value b) {
+	if (a.level == UNKNOWN_VALUE)
+		return b;
+	if (b.level == UNKNOWN_VALUE)
+		return a;
+	if (a.level == VARYING_VALUE || b.level == VARYING_VALUE || a.value != b.value)
+		return make_value(VARYING_VALUE, 0);
+	return a;
+}
+
+/* version dest could also hold v */
+static void lower(sccp_state * state, quad_arg * dest, lattice_value v) {
+	if (!is_version(state->fn, dest) || dest->temp->id >= state->value_count)
+		return;
+
+	lattice_value * old = &state->values[dest->temp->id];
+	lattice_value lowered = meet(*old, v);
+	if (lowered.level != old->level || lowered.value != old->value) {
+		*old = lowered;
+		state->changed = 1;
+	}
+}
+
+static lattice_value evaluate(sccp_state * state, quad * q) {
+	lattice_value a, b;
+	int result;
+
+	switch (q->op) {
+		case ADD_Q: case SUB_Q: case MUL_Q: case DIV_Q: case MOD_Q:
+		case LT_Q: case GT_Q: case LTE_Q: case GTE_Q: case NE_Q: case EQ_Q:
+			a = value_of(state, &q->args[1]);
+			b = value_of(state, &q->args[2]);
+			if (a.level == VARYING_VALUE || b.level == VARYING_VALUE)
+				return make_value(VARYING_VALUE, 0);
+			if (a.level == UNKNOWN_VALUE || b.level == UNKNOWN_VALUE)
+				return make_value(UNKNOWN_VALUE, 0);
+			if (!eval_binary_op(q->op, a.value, b.value, &result))
+				return make_value(VARYING_VALUE, 0);
+			return make_value(CONSTANT_VALUE, result);
+
+		case NOT_Q:
+		case NEG_Q:
+			a = value_of(state, &q->args[1]);
+			if (a.level != CONSTANT_VALUE)
+				return a;
+			return make_value(CONSTANT_VALUE, (q->op == NOT_Q) ? !a.value : (int)(0u - (unsigned)a.value));
+
+		case ASSIGN_Q:
+			return value_of(state, &q->args[1]);
+
+		case SIZEOF_Q:
+			return make_value(CONSTANT_VALUE, eval_sizeof(&q->args[1]));
+
+		default:
+			return make_value(VARYING_VALUE, 0);
+	}
+}
+
+static void mark_edge(sccp_state * state, int from, int to) {
+	ssa_block * dest = &state->fn->blocks[to];
+
+	for (int k = 0; k < dest->pred_count; k++) {
+		if (dest->preds[k] == from && !state->edge_executable[to][k]) {
+			state->edge_executable[to][k] = 1;
+			state->executable[to] = 1;
+			state->changed = 1;
+		}
+	}
+}
+
+/* does a conditional jump on value c jump? */
+static int is_taken(quad * jump, int c) {
+	return (jump->op == IFFALSE_Q) ? (c == 0) : (c != 0);
+}
+
+static void visit_block(sccp_state * state, ssa_block * b) {
+	for (int j = 0; j < b->phi_count; j++) {
+		lattice_value v = make_value(UNKNOWN_VALUE, 0);
+		for (int k = 0; k < b->pred_count; k++) {
+			if (state->edge_executable[b->id][k])
+				v = meet(v, value_of(state, &b->phis[j].args[k]));
+		}
+		lower(state, &b->phis[j].dest, v);
+	}
+
+	quad_arg * defs[MAX_QUAD_REFS];
+	for (int i = 0; i < b->quad_count; i++) {
+		quad * q = &b->quads[i];
+		int count = get_quad_def_args(q, defs);
+		for (int d = 0; d < count; d++)
+			lower(state, defs[d], (defs[d] == &q->args[0]) ? evaluate(state, q) : make_value(VARYING_VALUE, 0));
+	}
+
+	/* which edges run */
+	quad * last = b->quad_count > 0 ? &b->quads[b->quad_count - 1] : NULL;
+	if (last && (last->op == IFFALSE_Q || last->op == IFTRUE_Q)) {
+		lattice_value c = value_of(state, &last->args[0]);
+		if (c.level == UNKNOWN_VALUE)
+			return;
+		if (c.level == CONSTANT_VALUE && b->succ_count == 2) {
+			mark_edge(state, b->id, is_taken(last, c.value) ? b->succs[0] : b->succs[1]);
+			return;
+		}
+	}
+
+	for (int s = 0; s < b->succ_count; s++)
+		mark_edge(state, b->id, b->succs[s]);
+}
+
+static quad_arg constant_arg(sccp_state * state, quad_arg * arg) {
+	quad_arg lit = { .type = INT_LITERAL_Q_ARG, .int_literal = state->values[arg->temp->id].value };
+	return lit;
+}
+
+static int is_constant(sccp_state * state, quad_arg * arg) {
+	return value_of(state, arg).level == CONSTANT_VALUE && arg->type != INT_LITERAL_Q_ARG;
+}
+
+static int is_pure(quad_op op) {
+	return is_binary_op(op) || op == NOT_Q || op == NEG_Q || op == ASSIGN_Q || op == SIZEOF_Q;
+}
+
+/*
+ * rewrites block b with what the analysis found. returns changes made;
+ * sets *cut if a branch lost an edge.
+ */
+static int rewrite_block(sccp_state * state, ssa_block * b, int * cut) {
+	int changed = 0;
+
+	/* constant phis become assignments */
+	int start = ssa_block_start(b);
+	int kept = 0;
+	for (int j = 0; j < b->phi_count; j++) {
+		ssa_phi * phi = &b->phis[j];
+
+		if (is_constant(state, &phi->dest)) {
+			quad copy = { .op = ASSIGN_Q, .args = { phi->dest, constant_arg(state, &phi->dest), NULL_QUAD_ARG } };
+			ssa_insert_quad(b, start++, &copy);
+			free(phi->args);
+			changed++;
+			continue;
+		}
+
+		for (int k = 0; k < b->pred_count; k++) {
+			if (is_constant(state, &phi->args[k])) {
+				phi->args[k] = constant_arg(state, &phi->args[k]);
+				changed++;
+			}
+		}
+		b->phis[kept++] = *phi;
+	}
+	b->phi_count = kept;
+
+	quad_arg * args[MAX_QUAD_REFS];
+	for (int i = start; i < b->quad_count; i++) {
+		quad * q = &b->quads[i];
+
+		/* reads -- an array index has to stay a temp */
+		int count = get_quad_use_args(q, args);
+		for (int a = 0; a < count; a++) {
+			if (args[a]->type == TEMP_VAR_Q_ARG && is_constant(state, args[a])) {
+				*args[a] = constant_arg(state, args[a]);
+				changed++;
+			}
+		}
+
+		/* definition */
+		if (is_pure(q->op) && is_constant(state, &q->args[0]) &&
+			!(q->op == ASSIGN_Q && q->args[1].type == INT_LITERAL_Q_ARG)) {
+			q->args[1] = constant_arg(state, &q->args[0]);
+			q->args[2] = NULL_QUAD_ARG;
+			q->op = ASSIGN_Q;
+			changed++;
+		}
+	}
+
+	/* branch on a constant */
+	quad * last = b->quad_count > 0 ? &b->quads[b->quad_count - 1] : NULL;
+	if (last && (last->op == IFFALSE_Q || last->op == IFTRUE_Q) && last->args[0].type == INT_LITERAL_Q_ARG) {
+		if (is_taken(last, last->args[0].int_literal)) {
+			last->op = GOTO_Q;
+			last->args[0] = last->args[1];
+			last->args[1] = NULL_QUAD_ARG;
+			if (b->succ_count == 2)
+				ssa_remove_edge(state->fn, b->id, b->succs[1]);
+		} else {
+			ssa_remove_quad(b, b->quad_count - 1);
+			if (b->succ_count == 2)
+				ssa_remove_edge(state->fn, b->id, b->succs[0]);
+		}
+		*cut = 1;
+		changed++;
+	}
+
+	return changed;
+}
+
+static int propagate_function(ssa_function * fn) {
+	sccp_state state;
+	state.fn = fn;
+	state.value_count = fn->origin_size;
+	state.values = (lattice_value *)calloc(state.value_count + 1, sizeof(lattice_value));
+	state.executable = (char *)calloc(fn->block_count, sizeof(char));
+	state.edge_executable = (char **)malloc(fn->block_count * sizeof(char *));
+	assert(state.values && state.executable && state.edge_executable);
+	for (int id = 0; id < fn->block_count; id++) {
+		state.edge_executable[id] = (char *)calloc(fn->blocks[id].pred_count + 1, sizeof(char));
+		assert(state.edge_executable[id]);
+	}
+
+	state.executable[fn->rpo[0]] = 1;
+	do {
+		state.changed = 0;
+		for (int r = 0; r < fn->rpo_count; r++) {
+			if (state.executable[fn->rpo[r]])
+				visit_block(&state, &fn->blocks[fn->rpo[r]]);
+		}
+	} while (state.changed);
+
+	int changed = 0;
+	int cut = 0;
+	for (int r = 0; r < fn->rpo_count; r++) {
+		if (state.executable[fn->rpo[r]])
+			changed += rewrite_block(&state, &fn->blocks[fn->rpo[r]], &cut);
+	}
+
+	/* blocks behind the edges that never run are gone now */
+	if (cut)
+		ssa_update_cfg(fn);
+
+	for (int id = 0; id < fn->block_count; id++)
+		free(state.edge_executable[id]);
+	free(state.edge_executable);
+	free(state.executable);
+	free(state.values);
+	return changed;
+}
+
+int propagate_conditional_constants(ssa_program * prog) {
+	int changed = 0;
+	for (int f = 0; f < prog->function_count; f++)
+		changed += propagate_function(prog->functions[f]);
+	return changed;
+}
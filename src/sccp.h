@@ -0,0 +1,26 @@
+/*
+ * sccp.h
+ *
+ * sparse conditional constant propagation over SSA form
+ * Yondon Fu and Matt McFarland - Delights (CS57 - 16W)
+ */
+
+#ifndef _SCCP_H
+#define _SCCP_H
+
+#include "ssa.h"
+
+/*
+ * finds the versions that hold one constant on every path that can run,
+ * treating branches on constants as going one way only, then
+ *
+ * - replaces reads of those versions with the constant
+ * - turns their definitions into an ASSIGN_Q of the constant (phis too)
+ * - turns IFFALSE_Q / IFTRUE_Q on a constant into a GOTO_Q or removes it,
+ *   and drops the blocks no longer reachable
+ *
+ * returns the number of quads and phis changed
+ */
+int propagate_conditional_constants(ssa_program * prog);
+
+#endif 	// _SCCP_H
@@ -0,0 +1,1128 @@
+/*
+ * ssa.c
+ *
+ * builds static single assignment form from each function's cfg and
+ * translates it back into quads.
+ *
+ * Construction follows Cytron et al.: dominators by the iterative
+ * algorithm of Cooper, Harvey and Kennedy over the reverse postorder, a phi
+ * for a variable at the iterated dominance frontier of its definitions
+ * wherever the variable is live on entry (pruned SSA), and renaming in a
+ * walk of the dominator tree that keeps a stack of the current version of
+ * every variable.
+ *
+ * Versions are ordinary temps, so a pass over SSA form sees the quads it
+ * already knows plus the phis. Going back, each phi becomes copies through a
+ * fresh temp -- one at the end of every predecessor, one at the top of the
+ * phi's block -- which needs no critical edge splitting and can't lose a
+ * copy or swap two values. Every version is then renamed back to its
+ * variable unless that would overwrite another version still live; the
+ * copies between versions that went home are x = x and disappear.
+ *
+ * Yondon Fu and Matt McFarland - Delights (CS57 - 16W)
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+
+#include "ssa.h"
+#include "cfg.h"
+#include "liveness.h"
+#include "IR_gen.h"
+#include "symtab.h"
+
+#define INIT_BLOCK_QUADS 8
+#define INIT_PHIS 2
+#define INIT_PRED_COUNT 2
+#define INIT_ORIGIN_SIZE 64
+#define UNDEFINED_BLOCK -2 		// idom not computed yet
+
+extern quad_arr * quad_list;
+extern symboltable_t * symtab;
+
+/*
+ * ---------- versions ----------
+ */
+
+int is_version(ssa_function * fn, quad_arg * arg) {
+	return arg->type == TEMP_VAR_Q_ARG && arg->temp->id < fn->origin_size &&
+		fn->origin[arg->temp->id].type != NULL_ARG;
+}
+
+/* variable arg is a version of, or arg itself */
+static quad_arg * variable_of(ssa_function * fn, quad_arg * arg) {
+	return is_version(fn, arg) ? &fn->origin[arg->temp->id] : arg;
+}
+
+quad_arg new_version(ssa_function * fn, quad_arg * var) {
+	quad_arg of = *variable_of(fn, var);
+	temp_var * t = new_scope_temp(fn->scope);
+
+	if (t->id >= fn->origin_size) {
+		int size = fn->origin_size ? fn->origin_size : INIT_ORIGIN_SIZE;
+		while (size <= t->id)
+			size *= 2;
+		fn->origin = realloc(fn->origin, size * sizeof(quad_arg));
+		assert(fn->origin);
+		for (int i = fn->origin_size; i < size; i++)
+			fn->origin[i] = NULL_QUAD_ARG;
+		fn->origin_size = size;
+	}
+	fn->origin[t->id] = of;
+
+	quad_arg version = { .type = TEMP_VAR_Q_ARG, .temp = t };
+	return version;
+}
+
+/*
+ * ---------- blocks ----------
+ */
+
+void ssa_insert_quad(ssa_block * b, int pos, quad * q) {
+	if (b->quad_count == b->quad_size) {
+		b->quad_size = b->quad_size ? b->quad_size * 2 : INIT_BLOCK_QUADS;
+		b->quads = realloc(b->quads, b->quad_size * sizeof(quad));
+		assert(b->quads);
+	}
+
+	memmove(&b->quads[pos + 1], &b->quads[pos], (b->quad_count - pos) * sizeof(quad));
+	b->quads[pos] = *q;
+	b->quad_count++;
+}
+
+void ssa_remove_quad(ssa_block * b, int pos) {
+	memmove(&b->quads[pos], &b->quads[pos + 1], (b->quad_count - pos - 1) * sizeof(quad));
+	b->quad_count--;
+}
+
+int ssa_block_start(ssa_block * b) {
+	int pos = 0;
+	while (pos < b->quad_count && (b->quads[pos].op == LABEL_Q || b->quads[pos].op == PROLOG_Q))
+		pos++;
+	return pos;
+}
+
+ssa_phi * ssa_add_phi(ssa_block * b, quad_arg * var) {
+	if (b->phi_count == b->phi_size) {
+		b->phi_size = b->phi_size ? b->phi_size * 2 : INIT_PHIS;
+		b->phis = realloc(b->phis, b->phi_size * sizeof(ssa_phi));
+		assert(b->phis);
+	}
+
+	ssa_phi * phi = &b->phis[b->phi_count++];
+	phi->dest = *var;
+	phi->args = (quad_arg *)malloc((b->pred_count > 0 ? b->pred_count : 1) * sizeof(quad_arg));
+	assert(phi->args);
+	for (int k = 0; k < b->pred_count; k++)
+		phi->args[k] = *var;
+	return phi;
+}
+
+static int is_comparison(quad_op op) {
+	return op == LT_Q || op == GT_Q || op == LTE_Q || op == GTE_Q || op == NE_Q || op == EQ_Q;
+}
+
+/* before a closing jump or return, and before the compare the jump tests */
+int ssa_block_end(ssa_block * b, quad_arg * value) {
+	int pos = b->quad_count;
+	if (pos == 0)
+		return 0;
+
+	quad * last = &b->quads[pos - 1];
+	if (last->op != GOTO_Q && last->op != IFFALSE_Q && last->op != IFTRUE_Q && last->op != RET_Q)
+		return pos;
+	pos--;
+
+	if ((last->op == IFFALSE_Q || last->op == IFTRUE_Q) && last->args[0].type == TEMP_VAR_Q_ARG && pos > 0) {
+		quad * compare = &b->quads[pos - 1];
+		if (is_comparison(compare->op) && compare->args[0].type == TEMP_VAR_Q_ARG &&
+			compare->args[0].temp == last->args[0].temp &&
+			!(value->type == TEMP_VAR_Q_ARG && value->temp == last->args[0].temp))
+			pos--;
+	}
+	return pos;
+}
+
+static void free_phis(ssa_block * b) {
+	for (int j = 0; j < b->phi_count; j++)
+		free(b->phis[j].args);
+	b->phi_count = 0;
+}
+
+void ssa_remove_edge(ssa_function * fn, int from, int to) {
+	ssa_block * src = &fn->blocks[from];
+	ssa_block * dest = &fn->blocks[to];
+
+	for (int s = 0; s < src->succ_count; s++) {
+		if (src->succs[s] == to) {
+			if (s == 0)
+				src->succs[0] = src->succs[1];
+			src->succ_count--;
+			break;
+		}
+	}
+
+	for (int k = 0; k < dest->pred_count; k++) {
+		if (dest->preds[k] != from)
+			continue;
+
+		int after = dest->pred_count - k - 1;
+		memmove(&dest->preds[k], &dest->preds[k + 1], after * sizeof(int));
+		for (int j = 0; j < dest->phi_count; j++)
+			memmove(&dest->phis[j].args[k], &dest->phis[j].args[k + 1], after * sizeof(quad_arg));
+		dest->pred_count--;
+		break;
+	}
+}
+
+void ssa_add_edge(ssa_function * fn, int from, int to) {
+	ssa_block * src = &fn->blocks[from];
+	ssa_block * dest = &fn->blocks[to];
+
+	src->succs[src->succ_count++] = to;
+
+	if (dest->pred_count == dest->pred_size) {
+		dest->pred_size *= 2;
+		dest->preds = realloc(dest->preds, dest->pred_size * sizeof(int));
+		assert(dest->preds);
+		for (int j = 0; j < dest->phi_count; j++) {
+			dest->phis[j].args = realloc(dest->phis[j].args, dest->pred_size * sizeof(quad_arg));
+			assert(dest->phis[j].args);
+		}
+	}
+	for (int j = 0; j < dest->phi_count; j++)
+		dest->phis[j].args[dest->pred_count] = NULL_QUAD_ARG;
+	dest->preds[dest->pred_count++] = from;
+}
+
+int ssa_add_block(ssa_function * fn, int before) {
+	int id = fn->block_count++;
+	fn->blocks = realloc(fn->blocks, fn->block_count * sizeof(ssa_block));
+	fn->rpo = realloc(fn->rpo, fn->block_count * sizeof(int));
+	assert(fn->blocks && fn->rpo);
+
+	ssa_block * b = &fn->blocks[id];
+	memset(b, 0, sizeof(ssa_block));
+	b->id = id;
+	b->reachable = 1;
+	b->idom = NO_BLOCK;
+	b->rpo_index = -1;
+	b->pred_size = INIT_PRED_COUNT;
+	b->preds = (int *)malloc(b->pred_size * sizeof(int));
+	assert(b->preds);
+
+	/* splice into the layout */
+	b->layout_next = before;
+	for (int prev = 0; prev != NO_BLOCK; prev = fn->blocks[prev].layout_next) {
+		if (fn->blocks[prev].layout_next == before) {
+			fn->blocks[prev].layout_next = id;
+			break;
+		}
+	}
+	return id;
+}
+
+int ssa_dominates(ssa_function * fn, int a, int b) {
+	while (b != NO_BLOCK && b != a)
+		b = fn->blocks[b].idom;
+	return b == a;
+}
+
+/*
+ * ---------- reverse postorder and dominators ----------
+ */
+
+/* same iterative dfs as the cfg's */
+static void compute_reverse_postorder(ssa_function * fn) {
+	int * stack = (int *)malloc(fn->block_count * sizeof(int));
+	int * next_succ = (int *)calloc(fn->block_count, sizeof(int));
+	assert(stack && next_succ);
+
+	for (int id = 0; id < fn->block_count; id++)
+		fn->blocks[id].rpo_index = -1;
+
+	int post_count = 0;
+	int top = 0;
+	stack[top++] = 0;
+	fn->blocks[0].rpo_index = 0; 		// visited
+
+	while (top > 0) {
+		ssa_block * b = &fn->blocks[stack[top - 1]];
+
+		if (next_succ[b->id] < b->succ_count) {
+			int s = b->succs[next_succ[b->id]++];
+			if (fn->blocks[s].rpo_index < 0) {
+				fn->blocks[s].rpo_index = 0;
+				stack[top++] = s;
+			}
+		} else {
+			fn->rpo[post_count++] = b->id;
+			top--;
+		}
+	}
+
+	/* postorder -> reverse postorder */
+	for (int i = 0; i < post_count / 2; i++) {
+		int tmp = fn->rpo[i];
+		fn->rpo[i] = fn->rpo[post_count - 1 - i];
+		fn->rpo[post_count - 1 - i] = tmp;
+	}
+	fn->rpo_count = post_count;
+	for (int r = 0; r < post_count; r++)
+		fn->blocks[fn->rpo[r]].rpo_index = r;
+
+	free(stack);
+	free(next_succ);
+}
+
+static int intersect(ssa_function * fn, int a, int b) {
+	while (a != b) {
+		while (fn->blocks[a].rpo_index > fn->blocks[b].rpo_index)
+			a = fn->blocks[a].idom;
+		while (fn->blocks[b].rpo_index > fn->blocks[a].rpo_index)
+			b = fn->blocks[b].idom;
+	}
+	return a;
+}
+
+/*
+ * Cooper, Harvey and Kennedy, "A Simple, Fast Dominance Algorithm"
+ */
+static void compute_dominators(ssa_function * fn) {
+	for (int id = 0; id < fn->block_count; id++)
+		fn->blocks[id].idom = UNDEFINED_BLOCK;
+
+	int entry = fn->rpo[0];
+	fn->blocks[entry].idom = entry;
+
+	int changed = 1;
+	while (changed) {
+		changed = 0;
+
+		for (int r = 1; r < fn->rpo_count; r++) {
+			ssa_block * b = &fn->blocks[fn->rpo[r]];
+
+			int new_idom = UNDEFINED_BLOCK;
+			for (int k = 0; k < b->pred_count; k++) {
+				int p = b->preds[k];
+				if (fn->blocks[p].idom == UNDEFINED_BLOCK)
+					continue;
+				new_idom = (new_idom == UNDEFINED_BLOCK) ? p : intersect(fn, p, new_idom);
+			}
+
+			if (b->idom != new_idom) {
+				b->idom = new_idom;
+				changed = 1;
+			}
+		}
+	}
+
+	for (int id = 0; id < fn->block_count; id++) {
+		if (id == entry || fn->blocks[id].idom == UNDEFINED_BLOCK)
+			fn->blocks[id].idom = NO_BLOCK;
+	}
+}
+
+/* keeps only the block's string definitions (they're emitted after the code) */
+static void drop_block(ssa_function * fn, ssa_block * b) {
+	int kept = 0;
+	for (int i = 0; i < b->quad_count; i++) {
+		if (b->quads[i].op == STRING_Q)
+			b->quads[kept++] = b->quads[i];
+	}
+	b->quad_count = kept;
+
+	free_phis(b);
+	while (b->succ_count > 0)
+		ssa_remove_edge(fn, b->id, b->succs[0]);
+	b->reachable = 0;
+}
+
+void ssa_update_cfg(ssa_function * fn) {
+	compute_reverse_postorder(fn);
+
+	/* the epilog has to stay even if the function never returns */
+	for (int id = 0; id < fn->block_count; id++) {
+		ssa_block * b = &fn->blocks[id];
+		if (b->reachable && b->rpo_index < 0 && id != fn->exit_block)
+			drop_block(fn, b);
+	}
+
+	compute_dominators(fn);
+}
+
+/*
+ * ---------- construction ----------
+ */
+
+/*
+ * x++ on a local scalar reads and writes x in one quad. as
+ *     d = x; x = x + step 	(post)   or   x = x + step; d = x 	(pre)
+ * the write gets a version of its own.
+ */
+static void split_increments(ssa_function * fn) {
+	for (int id = 0; id < fn->block_count; id++) {
+		ssa_block * b = &fn->blocks[id];
+		if (!b->reachable)
+			continue;
+
+		for (int i = 0; i < b->quad_count; i++) {
+			quad * q = &b->quads[i];
+			if (q->op != PRE_INC_Q && q->op != PRE_DEC_Q && q->op != POST_INC_Q && q->op != POST_DEC_Q)
+				continue;
+			if (!get_local_scalar(&q->args[1]))
+				continue;
+
+			int pre = (q->op == PRE_INC_Q || q->op == PRE_DEC_Q);
+			quad update = { .number = q->number, .op = (q->op == PRE_INC_Q || q->op == POST_INC_Q) ? ADD_Q : SUB_Q,
+				.args = { q->args[1], q->args[1], q->args[2] } };
+			quad copy = { .number = q->number, .op = ASSIGN_Q, .args = { q->args[0], q->args[1], NULL_QUAD_ARG } };
+
+			if (q->args[0].type == NULL_ARG) {
+				*q = update;
+			} else {
+				*q = pre ? update : copy;
+				ssa_insert_quad(b, i + 1, pre ? &copy : &update);
+				i++;
+			}
+		}
+	}
+}
+
+/*
+ * var_args[n] = operand form of liveness variable n -- the quad_arg CG
+ * used for a scalar, or a TEMP_VAR_Q_ARG for an index temp
+ */
+static quad_arg * collect_variables(ssa_function * fn, liveness * info) {
+	quad_arg * var_args = (quad_arg *)calloc(info->var_count + 1, sizeof(quad_arg));
+	assert(var_args);
+
+	quad_arg * args[MAX_QUAD_REFS];
+	for (int id = 0; id < fn->block_count; id++) {
+		ssa_block * b = &fn->blocks[id];
+
+		for (int i = 0; i < b->quad_count; i++) {
+			quad * q = &b->quads[i];
+			int count = get_quad_use_args(q, args);
+			count += get_quad_def_args(q, args + count);
+
+			for (int a = 0; a < count; a++) {
+				quad_arg * arg = args[a];
+				if (arg->type == SYMBOL_ARR_Q_ARG) {
+					if (arg->temp == NULL || arg->int_literal == PASS_ARR_POINTER)
+						continue;
+					int n = get_live_var_number(info, (symnode_t *)arg->temp->temp_symnode);
+					if (n >= 0) {
+						var_args[n].type = TEMP_VAR_Q_ARG;
+						var_args[n].temp = arg->temp;
+					}
+				} else {
+					symnode_t * var = get_local_scalar(arg);
+					int n = var ? get_live_var_number(info, var) : -1;
+					if (n >= 0)
+						var_args[n] = *arg;
+				}
+			}
+		}
+	}
+
+	return var_args;
+}
+
+static void append_int(int ** arr, int * count, int * size, int value) {
+	if (*count == *size) {
+		*size = *size ? *size * 2 : 4;
+		*arr = realloc(*arr, *size * sizeof(int));
+		assert(*arr);
+	}
+	(*arr)[(*count)++] = value;
+}
+
+/*
+ * phis at the iterated dominance frontier of each variable's definitions,
+ * kept only where the variable is live on entry
+ */
+static void place_phis(ssa_function * fn, liveness * info, quad_arg * var_args) {
+	int block_count = fn->block_count;
+
+	/* dominance frontiers */
+	int ** df = (int **)calloc(block_count, sizeof(int *));
+	int * df_count = (int *)calloc(block_count, sizeof(int));
+	int * df_size = (int *)calloc(block_count, sizeof(int));
+	int * df_last = (int *)malloc(block_count * sizeof(int));
+	assert(df && df_count && df_size && df_last);
+	for (int id = 0; id < block_count; id++)
+		df_last[id] = NO_BLOCK;
+
+	for (int r = 0; r < fn->rpo_count; r++) {
+		ssa_block * b = &fn->blocks[fn->rpo[r]];
+		if (b->pred_count < 2)
+			continue;
+
+		for (int k = 0; k < b->pred_count; k++) {
+			int runner = b->preds[k];
+			while (runner != NO_BLOCK && runner != b->idom) {
+				if (df_last[runner] != b->id) {
+					df_last[runner] = b->id;
+					append_int(&df[runner], &df_count[runner], &df_size[runner], b->id);
+				}
+				runner = fn->blocks[runner].idom;
+			}
+		}
+	}
+
+	/* blocks defining each variable, as lists threaded through def_next */
+	int var_count = info->var_count;
+	int * def_head = (int *)malloc((var_count + 1) * sizeof(int));
+	int * def_last = (int *)malloc((var_count + 1) * sizeof(int));
+	int * def_block = NULL;
+	int * def_next = NULL;
+	int def_count = 0, def_size = 0, next_count = 0, next_size = 0;
+	assert(def_head && def_last);
+	for (int n = 0; n < var_count; n++)
+		def_head[n] = def_last[n] = -1;
+
+	symnode_t * vars[MAX_QUAD_REFS];
+	for (int r = 0; r < fn->rpo_count; r++) {
+		ssa_block * b = &fn->blocks[fn->rpo[r]];
+
+		for (int i = 0; i < b->quad_count; i++) {
+			int count = get_quad_defs(&b->quads[i], vars);
+			for (int v = 0; v < count; v++) {
+				int n = get_live_var_number(info, vars[v]);
+				if (n < 0 || def_last[n] == b->id)
+					continue;
+				def_last[n] = b->id;
+				append_int(&def_block, &def_count, &def_size, b->id);
+				append_int(&def_next, &next_count, &next_size, def_head[n]);
+				def_head[n] = def_count - 1;
+			}
+		}
+	}
+
+	/* worklist over the frontiers, per variable */
+	int * has_phi = (int *)calloc(block_count, sizeof(int));
+	int * on_list = (int *)calloc(block_count, sizeof(int));
+	int * work = (int *)malloc(block_count * sizeof(int));
+	assert(has_phi && on_list && work);
+
+	for (int n = 0; n < var_count; n++) {
+		int work_count = 0;
+		for (int d = def_head[n]; d >= 0; d = def_next[d]) {
+			on_list[def_block[d]] = n + 1;
+			work[work_count++] = def_block[d];
+		}
+
+		while (work_count > 0) {
+			int x = work[--work_count];
+
+			for (int f = 0; f < df_count[x]; f++) {
+				int y = df[x][f];
+				if (has_phi[y] == n + 1)
+					continue;
+				has_phi[y] = n + 1;
+
+				if (LIVE_TEST(LIVE_SET(info->live_in, info, y), n))
+					ssa_add_phi(&fn->blocks[y], &var_args[n]);
+
+				if (on_list[y] != n + 1) {
+					on_list[y] = n + 1;
+					work[work_count++] = y;
+				}
+			}
+		}
+	}
+
+	for (int id = 0; id < block_count; id++)
+		free(df[id]);
+	free(df);
+	free(df_count);
+	free(df_size);
+	free(df_last);
+	free(def_head);
+	free(def_last);
+	free(def_block);
+	free(def_next);
+	free(has_phi);
+	free(on_list);
+	free(work);
+}
+
+/*
+ * current version of every variable while walking the dominator tree.
+ * the bottom of each stack is the variable itself (its value on entry).
+ */
+typedef struct rename_state {
+	ssa_function * fn;
+	liveness * info;
+	quad_arg * var_args;
+
+	quad_arg ** stacks;
+	int * stack_count;
+	int * stack_size;
+
+	int * pushed; 		// variable numbers in push order, popped per block
+	int pushed_count;
+	int pushed_size;
+} rename_state;
+
+static quad_arg * current_version(rename_state * state, int n) {
+	if (state->stack_count[n] == 0)
+		return &state->var_args[n];
+	return &state->stacks[n][state->stack_count[n] - 1];
+}
+
+static void push_version(rename_state * state, int n, quad_arg * version) {
+	if (state->stack_count[n] == state->stack_size[n]) {
+		state->stack_size[n] = state->stack_size[n] ? state->stack_size[n] * 2 : 4;
+		state->stacks[n] = realloc(state->stacks[n], state->stack_size[n] * sizeof(quad_arg));
+		assert(state->stacks[n]);
+	}
+	state->stacks[n][state->stack_count[n]++] = *version;
+	append_int(&state->pushed, &state->pushed_count, &state->pushed_size, n);
+}
+
+static int variable_number(rename_state * state, quad_arg * arg) {
+	symnode_t * var = get_local_scalar(variable_of(state->fn, arg));
+	return var ? get_live_var_number(state->info, var) : -1;
+}
+
+static void rename_block(rename_state * state, ssa_block * b) {
+	ssa_function * fn = state->fn;
+
+	for (int j = 0; j < b->phi_count; j++) {
+		int n = variable_number(state, &b->phis[j].dest);
+		quad_arg version = new_version(fn, &b->phis[j].dest);
+		b->phis[j].dest = version;
+		push_version(state, n, &version);
+	}
+
+	quad_arg * args[MAX_QUAD_REFS];
+	for (int i = 0; i < b->quad_count; i++) {
+		quad * q = &b->quads[i];
+
+		int count = get_quad_use_args(q, args);
+		for (int a = 0; a < count; a++) {
+			quad_arg * arg = args[a];
+
+			if (arg->type == SYMBOL_ARR_Q_ARG) {
+				if (arg->temp == NULL || arg->int_literal == PASS_ARR_POINTER)
+					continue;
+				int n = get_live_var_number(state->info, (symnode_t *)arg->temp->temp_symnode);
+				if (n >= 0)
+					arg->temp = current_version(state, n)->temp;
+			} else {
+				int n = get_local_scalar(arg) ? variable_number(state, arg) : -1;
+				if (n >= 0)
+					*arg = *current_version(state, n);
+			}
+		}
+
+		count = get_quad_def_args(q, args);
+		for (int a = 0; a < count; a++) {
+			if (!get_local_scalar(args[a]))
+				continue;
+			int n = variable_number(state, args[a]);
+			quad_arg version = new_version(fn, args[a]);
+			*args[a] = version;
+			push_version(state, n, &version);
+		}
+	}
+
+	/* fill in this block's column of each successor's phis */
+	for (int s = 0; s < b->succ_count; s++) {
+		ssa_block * succ = &fn->blocks[b->succs[s]];
+		for (int k = 0; k < succ->pred_count; k++) {
+			if (succ->preds[k] != b->id)
+				continue;
+			for (int j = 0; j < succ->phi_count; j++)
+				succ->phis[j].args[k] = *current_version(state, variable_number(state, &succ->phis[j].dest));
+		}
+	}
+}
+
+/*
+ * preorder walk of the dominator tree, popping each block's versions once
+ * its subtree is done (iterative -- the tree is as deep as the code is long)
+ */
+static void rename_variables(ssa_function * fn, liveness * info, quad_arg * var_args) {
+	rename_state state;
+	memset(&state, 0, sizeof(rename_state));
+	state.fn = fn;
+	state.info = info;
+	state.var_args = var_args;
+	state.stacks = (quad_arg **)calloc(info->var_count + 1, sizeof(quad_arg *));
+	state.stack_count = (int *)calloc(info->var_count + 1, sizeof(int));
+	state.stack_size = (int *)calloc(info->var_count + 1, sizeof(int));
+	assert(state.stacks && state.stack_count && state.stack_size);
+
+	/* dominator tree children, by counting sort on idom */
+	int block_count = fn->block_count;
+	int * child_start = (int *)calloc(block_count + 1, sizeof(int));
+	int * children = (int *)malloc((block_count + 1) * sizeof(int));
+	assert(child_start && children);
+	for (int r = 1; r < fn->rpo_count; r++)
+		child_start[fn->blocks[fn->rpo[r]].idom + 1]++;
+	for (int id = 0; id < block_count; id++)
+		child_start[id + 1] += child_start[id];
+	int * fill = (int *)malloc((block_count + 1) * sizeof(int));
+	assert(fill);
+	memcpy(fill, child_start, (block_count + 1) * sizeof(int));
+	for (int r = 1; r < fn->rpo_count; r++)
+		children[fill[fn->blocks[fn->rpo[r]].idom]++] = fn->rpo[r];
+	free(fill);
+
+	/* frame = block, or -1 - (pushed_count to pop back to) once its subtree is queued */
+	int * frames = (int *)malloc((2 * block_count + 1) * sizeof(int));
+	assert(frames);
+	int top = 0;
+	frames[top++] = fn->rpo[0];
+
+	while (top > 0) {
+		int frame = frames[--top];
+
+		if (frame < 0) {
+			int mark = -1 - frame;
+			while (state.pushed_count > mark)
+				state.stack_count[state.pushed[--state.pushed_count]]--;
+			continue;
+		}
+
+		frames[top++] = -1 - state.pushed_count;
+		rename_block(&state, &fn->blocks[frame]);
+		for (int c = child_start[frame]; c < child_start[frame + 1]; c++)
+			frames[top++] = children[c];
+	}
+
+	for (int n = 0; n < info->var_count; n++)
+		free(state.stacks[n]);
+	free(state.stacks);
+	free(state.stack_count);
+	free(state.stack_size);
+	free(state.pushed);
+	free(child_start);
+	free(children);
+	free(frames);
+}
+
+static ssa_function * build_function(int prolog, int epilog) {
+	cfg * graph = build_cfg(prolog, epilog);
+	liveness * info = compute_liveness(graph);
+
+	ssa_function * fn = (ssa_function *)calloc(1, sizeof(ssa_function));
+	assert(fn);
+	fn->function = graph->function;
+	fn->scope = find_function_scope(symtab, fn->function);
+	assert(fn->scope);
+
+	fn->block_count = graph->block_count;
+	fn->exit_block = graph->exit_block;
+	fn->blocks = (ssa_block *)calloc(fn->block_count, sizeof(ssa_block));
+	fn->rpo = (int *)malloc(fn->block_count * sizeof(int));
+	assert(fn->blocks && fn->rpo);
+
+	for (int id = 0; id < fn->block_count; id++) {
+		basic_block * from = &graph->blocks[id];
+		ssa_block * b = &fn->blocks[id];
+
+		b->id = id;
+		b->reachable = 1;
+		b->quad_count = from->last - from->first + 1;
+		b->quad_size = b->quad_count > INIT_BLOCK_QUADS ? b->quad_count : INIT_BLOCK_QUADS;
+		b->quads = (quad *)malloc(b->quad_size * sizeof(quad));
+		assert(b->quads);
+		memcpy(b->quads, &quad_list->arr[from->first], b->quad_count * sizeof(quad));
+
+		b->succ_count = from->succ_count;
+		for (int s = 0; s < from->succ_count; s++)
+			b->succs[s] = from->succs[s];
+
+		b->pred_count = from->pred_count;
+		b->pred_size = from->pred_count > INIT_PRED_COUNT ? from->pred_count : INIT_PRED_COUNT;
+		b->preds = (int *)malloc(b->pred_size * sizeof(int));
+		assert(b->preds);
+		memcpy(b->preds, from->preds, from->pred_count * sizeof(int));
+
+		b->layout_next = (id + 1 < fn->block_count) ? id + 1 : NO_BLOCK;
+	}
+
+	ssa_update_cfg(fn);
+	split_increments(fn);
+
+	quad_arg * var_args = collect_variables(fn, info);
+	place_phis(fn, info, var_args);
+	rename_variables(fn, info, var_args);
+
+	free(var_args);
+	destroy_liveness(info);
+	destroy_cfg(graph);
+	return fn;
+}
+
+ssa_program * build_ssa() {
+	ssa_program * prog = (ssa_program *)calloc(1, sizeof(ssa_program));
+	assert(prog);
+	if (!quad_list)
+		return prog;
+
+	int size = 0;
+	for (int i = 0; i < quad_list->count; i++) {
+		if (quad_list->arr[i].op == PROLOG_Q)
+			size++;
+	}
+	prog->functions = (ssa_function **)malloc((size + 1) * sizeof(ssa_function *));
+	prog->prologs = (int *)malloc((size + 1) * sizeof(int));
+	prog->epilogs = (int *)malloc((size + 1) * sizeof(int));
+	assert(prog->functions && prog->prologs && prog->epilogs);
+
+	for (int i = 0; i < quad_list->count; i++) {
+		if (quad_list->arr[i].op != PROLOG_Q)
+			continue;
+
+		int prolog = i;
+		while (i < quad_list->count && quad_list->arr[i].op != EPILOG_Q)
+			i++;
+		if (i == quad_list->count)
+			break;
+
+		prog->prologs[prog->function_count] = prolog;
+		prog->epilogs[prog->function_count] = i;
+		prog->functions[prog->function_count++] = build_function(prolog, i);
+	}
+
+	return prog;
+}
+
+/*
+ * ---------- out of SSA ----------
+ */
+
+static void insert_phi_copies(ssa_function * fn) {
+	for (int id = 0; id < fn->block_count; id++) {
+		ssa_block * b = &fn->blocks[id];
+		if (!b->reachable || b->phi_count == 0)
+			continue;
+
+		int start = ssa_block_start(b);
+		for (int j = 0; j < b->phi_count; j++) {
+			ssa_phi * phi = &b->phis[j];
+			quad_arg through = new_version(fn, &phi->dest);
+
+			for (int k = 0; k < b->pred_count; k++) {
+				ssa_block * p = &fn->blocks[b->preds[k]];
+				quad copy = { .op = ASSIGN_Q, .args = { through, phi->args[k], NULL_QUAD_ARG } };
+				ssa_insert_quad(p, ssa_block_end(p, &phi->args[k]), &copy);
+			}
+
+			quad copy = { .op = ASSIGN_Q, .args = { phi->dest, through, NULL_QUAD_ARG } };
+			ssa_insert_quad(b, start + j, &copy);
+		}
+		free_phis(b);
+	}
+}
+
+/*
+ * replaces each function's quads in quad_list by its blocks, in layout order,
+ * and moves prologs / epilogs to match
+ */
+static void write_back(ssa_program * prog) {
+	int total = quad_list->count;
+	for (int f = 0; f < prog->function_count; f++) {
+		total -= prog->epilogs[f] - prog->prologs[f] + 1;
+		for (int id = 0; id < prog->functions[f]->block_count; id++)
+			total += prog->functions[f]->blocks[id].quad_count;
+	}
+
+	quad * arr = (quad *)malloc((total + 1) * sizeof(quad));
+	assert(arr);
+
+	int in = 0, out = 0;
+	for (int f = 0; f < prog->function_count; f++) {
+		ssa_function * fn = prog->functions[f];
+
+		memcpy(&arr[out], &quad_list->arr[in], (prog->prologs[f] - in) * sizeof(quad));
+		out += prog->prologs[f] - in;
+		in = prog->epilogs[f] + 1;
+
+		prog->prologs[f] = out;
+		for (int id = 0; id != NO_BLOCK; id = fn->blocks[id].layout_next) {
+			memcpy(&arr[out], fn->blocks[id].quads, fn->blocks[id].quad_count * sizeof(quad));
+			out += fn->blocks[id].quad_count;
+		}
+		prog->epilogs[f] = out - 1;
+		assert(arr[out - 1].op == EPILOG_Q);
+	}
+	memcpy(&arr[out], &quad_list->arr[in], (quad_list->count - in) * sizeof(quad));
+	out += quad_list->count - in;
+
+	for (int i = 0; i < out; i++)
+		arr[i].number = i;
+
+	free(quad_list->arr);
+	quad_list->arr = arr;
+	quad_list->count = out;
+	quad_list->size = total + 1;
+}
+
+/* versions grouped by the variable they came from */
+typedef struct version_ref {
+	symnode_t * var;
+	int n; 			// liveness number of the version
+} version_ref;
+
+static int compare_version_ref(const void * a, const void * b) {
+	const version_ref * x = (const version_ref *)a;
+	const version_ref * y = (const version_ref *)b;
+	if (x->var != y->var)
+		return (x->var < y->var) ? -1 : 1;
+	return x->n - y->n;
+}
+
+/*
+ * renames the versions in quad_list[prolog, epilog] back to their variables.
+ * walking each block backwards, a version defined while another version of
+ * the same variable (or the variable's entry value) is live would clobber
+ * it -- one of the two keeps its temp instead. x = x copies left behind are
+ * flagged in removed[].
+ */
+static void restore_variables(ssa_function * fn, int prolog, int epilog, char * removed) {
+	cfg * graph = build_cfg(prolog, epilog);
+	liveness * info = compute_liveness(graph);
+	int var_count = info->var_count;
+
+	/* temp of each tracked temp */
+	temp_var ** temp_of = (temp_var **)calloc(var_count + 1, sizeof(temp_var *));
+	assert(temp_of);
+	for (int i = prolog; i <= epilog; i++) {
+		for (int a = 0; a < QUAD_ARG_NUM; a++) {
+			quad_arg * arg = &quad_list->arr[i].args[a];
+			if (arg->type != TEMP_VAR_Q_ARG && !(arg->type == SYMBOL_ARR_Q_ARG && arg->temp != NULL))
+				continue;
+			int n = get_live_var_number(info, (symnode_t *)arg->temp->temp_symnode);
+			if (n >= 0)
+				temp_of[n] = arg->temp;
+		}
+	}
+
+	/* group the versions: members[group_start[g] .. group_start[g + 1]) */
+	version_ref * refs = (version_ref *)malloc((var_count + 1) * sizeof(version_ref));
+	int * group_of = (int *)malloc((var_count + 1) * sizeof(int));
+	char * own = (char *)calloc(var_count + 1, sizeof(char)); 	// version keeps its temp
+	assert(refs && group_of && own);
+
+	int ref_count = 0;
+	for (int n = 0; n < var_count; n++) {
+		group_of[n] = -1;
+		if (!temp_of[n])
+			continue;
+
+		quad_arg version = { .type = TEMP_VAR_Q_ARG, .temp = temp_of[n] };
+		if (!is_version(fn, &version))
+			continue;
+		refs[ref_count].var = get_local_scalar(&fn->origin[temp_of[n]->id]);
+		refs[ref_count].n = n;
+		ref_count++;
+	}
+	qsort(refs, ref_count, sizeof(version_ref), compare_version_ref);
+
+	int * group_start = (int *)malloc((ref_count + 2) * sizeof(int));
+	int * group_entry = (int *)malloc((ref_count + 1) * sizeof(int)); 	// liveness number of the variable, or -1
+	assert(group_start && group_entry);
+	int group_count = 0;
+	for (int r = 0; r < ref_count; r++) {
+		if (r == 0 || refs[r].var != refs[r - 1].var) {
+			group_start[group_count] = r;
+			group_entry[group_count] = get_live_var_number(info, refs[r].var);
+			group_count++;
+		}
+		group_of[refs[r].n] = group_count - 1;
+	}
+	group_start[group_count] = ref_count;
+
+	/* interference at every definition */
+	live_set_word * live = (live_set_word *)malloc((info->words + 1) * sizeof(live_set_word));
+	assert(live);
+	symnode_t * vars[MAX_QUAD_REFS];
+
+	for (int id = 0; id < graph->block_count; id++) {
+		basic_block * b = &graph->blocks[id];
+		memcpy(live, LIVE_SET(info->live_out, info, id), info->words * sizeof(live_set_word));
+
+		for (int i = b->last; i >= b->first; i--) {
+			quad * q = &quad_list->arr[i];
+			int count = get_quad_defs(q, vars);
+
+			for (int d = 0; d < count; d++) {
+				int n = get_live_var_number(info, vars[d]);
+				if (n < 0 || group_of[n] < 0 || own[n])
+					continue;
+
+				int g = group_of[n];
+				symnode_t * src = (q->op == ASSIGN_Q) ? get_local_scalar(&q->args[1]) : NULL;
+				int copied = src ? get_live_var_number(info, src) : -1;
+				int dead = !LIVE_TEST(live, n);
+
+				int entry = group_entry[g];
+				if (entry >= 0 && entry != copied && LIVE_TEST(live, entry)) {
+					own[n] = 1;
+					continue;
+				}
+
+				for (int r = group_start[g]; r < group_start[g + 1]; r++) {
+					int w = refs[r].n;
+					if (w == n || w == copied || own[w] || !LIVE_TEST(live, w))
+						continue;
+					if (dead) {
+						own[n] = 1;
+						break;
+					}
+					own[w] = 1;
+				}
+			}
+
+			step_live_backward(info, q, live);
+		}
+	}
+
+	/* rename */
+	for (int i = prolog; i <= epilog; i++) {
+		quad * q = &quad_list->arr[i];
+
+		for (int a = 0; a < QUAD_ARG_NUM; a++) {
+			quad_arg * arg = &q->args[a];
+			if (arg->type == TEMP_VAR_Q_ARG && is_version(fn, arg)) {
+				int n = get_live_var_number(info, (symnode_t *)arg->temp->temp_symnode);
+				if (n < 0 || !own[n])
+					*arg = fn->origin[arg->temp->id];
+			} else if (arg->type == SYMBOL_ARR_Q_ARG && arg->temp != NULL) {
+				quad_arg index = { .type = TEMP_VAR_Q_ARG, .temp = arg->temp };
+				if (!is_version(fn, &index))
+					continue;
+				int n = get_live_var_number(info, (symnode_t *)arg->temp->temp_symnode);
+				if (n < 0 || !own[n])
+					arg->temp = fn->origin[arg->temp->id].temp;
+			}
+		}
+
+		if (q->op == ASSIGN_Q && get_local_scalar(&q->args[0]) != NULL &&
+			get_local_scalar(&q->args[0]) == get_local_scalar(&q->args[1]))
+			removed[i] = 1;
+	}
+
+	free(temp_of);
+	free(refs);
+	free(group_of);
+	free(own);
+	free(group_start);
+	free(group_entry);
+	free(live);
+	destroy_liveness(info);
+	destroy_cfg(graph);
+}
+
+static void destroy_ssa_function(ssa_function * fn) {
+	for (int id = 0; id < fn->block_count; id++) {
+		free_phis(&fn->blocks[id]);
+		free(fn->blocks[id].phis);
+		free(fn->blocks[id].quads);
+		free(fn->blocks[id].preds);
+	}
+	free(fn->blocks);
+	free(fn->rpo);
+	free(fn->origin);
+	free(fn);
+}
+
+void leave_ssa(ssa_program * prog) {
+	if (!prog)
+		return;
+
+	for (int f = 0; f < prog->function_count; f++)
+		insert_phi_copies(prog->functions[f]);
+
+	if (prog->function_count > 0) {
+		write_back(prog);
+
+		char * removed = (char *)calloc(quad_list->count + 1, sizeof(char));
+		assert(removed);
+		for (int f = 0; f < prog->function_count; f++)
+			restore_variables(prog->functions[f], prog->prologs[f], prog->epilogs[f], removed);
+		remove_quads(removed);
+		free(removed);
+	}
+
+	for (int f = 0; f < prog->function_count; f++)
+		destroy_ssa_function(prog->functions[f]);
+	free(prog->functions);
+	free(prog->prologs);
+	free(prog->epilogs);
+	free(prog);
+}
+
+/*
+ * ---------- printing ----------
+ */
+
+static void print_ssa_arg(quad_arg * arg) {
+	switch (arg->type) {
+		case INT_LITERAL_Q_ARG:
+			printf("Constant: %d", arg->int_literal);
+			break;
+		case TEMP_VAR_Q_ARG:
+			printf("Temp %d", arg->temp->id);
+			break;
+		case SYMBOL_VAR_Q_ARG:
+			printf("Symbol: %s", arg->label);
+			break;
+		default:
+			printf(" - ");
+			break;
+	}
+}
+
+void print_ssa(ssa_program * prog) {
+	if (!prog)
+		return;
+
+	for (int f = 0; f < prog->function_count; f++) {
+		ssa_function * fn = prog->functions[f];
+		int number = 0;
+
+		printf("function %s: %d blocks\n", fn->function ? fn->function->name : "?", fn->block_count);
+
+		for (int id = 0; id != NO_BLOCK; id = fn->blocks[id].layout_next) {
+			ssa_block * b = &fn->blocks[id];
+			if (!b->reachable)
+				continue;
+
+			printf("  B%d preds:", id);
+			for (int k = 0; k < b->pred_count; k++)
+				printf(" B%d", b->preds[k]);
+			printf("  succs:");
+			for (int s = 0; s < b->succ_count; s++)
+				printf(" B%d", b->succs[s]);
+			if (b->idom != NO_BLOCK)
+				printf("  idom: B%d", b->idom);
+			printf("\n");
+
+			for (int j = 0; j < b->phi_count; j++) {
+				printf("    phi ");
+				print_ssa_arg(&b->phis[j].dest);
+				printf(" <-");
+				for (int k = 0; k < b->pred_count; k++) {
+					printf("%s B%d: ", k ? "," : "", b->preds[k]);
+					print_ssa_arg(&b->phis[j].args[k]);
+				}
+				printf("\n");
+			}
+
+			for (int i = 0; i < b->quad_count; i++) {
+				b->quads[i].number = number++;
+				printf("    ");
+				print_quad(&b->quads[i]);
+			}
+		}
+	}
+}
@@ -0,0 +1,172 @@
+/*
+ * ssa.h
+ *
+ * static single assignment form of every function in the quad list, for
+ * the optimization passes the pass manager runs between CG() and create_ys()
+ * Yondon Fu and Matt McFarland - Delights (CS57 - 16W)
+ */
+
+#ifndef _SSA_H
+#define _SSA_H
+
+#include "quad.h"
+#include "cfg.h" 		// for NO_BLOCK
+
+/*
+ * dest = phi(args[0], args[1], ...) at the top of a block. args[k] is the
+ * value arriving over the edge from the block's k-th predecessor.
+ */
+typedef struct ssa_phi {
+	quad_arg dest; 			// always a version temp
+	quad_arg * args; 		// parallel to the block's preds
+} ssa_phi;
+
+/*
+ * basic block owning its quads. blocks keep the ids build_cfg gave them
+ * (new blocks are added at the end) and go back into quad_list in layout
+ * order, so a block without a closing jump falls through to layout_next.
+ * a block ending in a jump has the jump's target as succs[0].
+ */
+typedef struct ssa_block {
+	int id;
+	int reachable; 			// 0 once dropped -- only its STRING_Qs are kept
+
+	quad * quads;
+	int quad_count;
+	int quad_size;
+
+	ssa_phi * phis;
+	int phi_count;
+	int phi_size;
+
+	int succs[2];
+	int succ_count;
+	int * preds;
+	int pred_count;
+	int pred_size;
+
+	int idom; 				// immediate dominator, NO_BLOCK for the entry and dropped blocks
+	int rpo_index; 			// position in the function's rpo, -1 if dropped
+	int layout_next; 		// block emitted after this one, NO_BLOCK for the last
+} ssa_block;
+
+/*
+ * one function in SSA form. every value a quad or phi writes to a local
+ * scalar is a fresh temp, a "version" of that scalar; origin[] maps the
+ * version's temp id back to the variable (as the quad_arg CG used for it).
+ * reads of a variable that no definition reaches still name the variable
+ * itself -- its value on entry.
+ */
+typedef struct ssa_function {
+	symnode_t * function;
+	symhashtable_t * scope; 	// owns the temp list versions come from
+
+	ssa_block * blocks;
+	int block_count;
+	int exit_block;
+
+	int * rpo; 					// reachable blocks in reverse postorder
+	int rpo_count;
+
+	quad_arg * origin; 			// temp id -> variable it versions, NULL_ARG if none
+	int origin_size;
+} ssa_function;
+
+/*
+ * every function of the quad list, with the quads between them (globals,
+ * strings) left where they were
+ */
+typedef struct ssa_program {
+	ssa_function ** functions;
+	int function_count;
+	int * prologs; 				// quad_list index of each function's PROLOG_Q
+	int * epilogs; 				// ... and EPILOG_Q
+} ssa_program;
+
+/*
+ * puts every function of the global quad_list into SSA form:
+ * drops unreachable blocks, splits increments of scalars into a copy and an
+ * add, places phis where a variable's definitions meet and it is live
+ * (pruned SSA over dominance frontiers) and renames every definition to a
+ * new version. quad_list is left alone until leave_ssa().
+ */
+ssa_program * build_ssa();
+
+/*
+ * translates prog back into the global quad_list and frees it. each phi
+ * becomes a copy into a fresh temp at the end of every predecessor and a
+ * copy out of it at the top of its block. versions then go back to the
+ * variable they came from unless two versions of it are live at once, in
+ * which case the version keeps its temp.
+ */
+void leave_ssa(ssa_program * prog);
+
+/*
+ * prints every block with its phis and quads
+ */
+void print_ssa(ssa_program * prog);
+
+/*
+ * fresh version of the variable var stands for (var may be a version)
+ */
+quad_arg new_version(ssa_function * fn, quad_arg * var);
+
+/*
+ * is arg a version temp made by build_ssa / new_version?
+ */
+int is_version(ssa_function * fn, quad_arg * arg);
+
+/*
+ * inserts a copy of q before position pos / removes the quad at pos
+ */
+void ssa_insert_quad(ssa_block * b, int pos, quad * q);
+void ssa_remove_quad(ssa_block * b, int pos);
+
+/*
+ * position after the block's leading LABEL_Qs (and PROLOG_Q)
+ */
+int ssa_block_start(ssa_block * b);
+
+/*
+ * position at the end of block b where a quad writing or reading value can
+ * go: before a closing jump or return, and before a compare the jump tests
+ * so the two stay fused (unless value is the compare's result)
+ */
+int ssa_block_end(ssa_block * b, quad_arg * value);
+
+/*
+ * adds dest = phi(dest, dest, ...) to b, one argument per pred, for the
+ * caller to rename
+ */
+ssa_phi * ssa_add_phi(ssa_block * b, quad_arg * dest);
+
+/*
+ * removes the edge from -> to along with the phi arguments it carried
+ */
+void ssa_remove_edge(ssa_function * fn, int from, int to);
+
+/*
+ * adds the edge from -> to. phis in to get the argument NULL_ARG, to be
+ * filled in by the caller.
+ */
+void ssa_add_edge(ssa_function * fn, int from, int to);
+
+/*
+ * new empty block, emitted right before block before. returns its id --
+ * fn->blocks moves, so don't hold ssa_block pointers across this.
+ * edges and the rpo / dominators are the caller's to update.
+ */
+int ssa_add_block(ssa_function * fn, int before);
+
+/*
+ * does block a dominate block b?
+ */
+int ssa_dominates(ssa_function * fn, int a, int b);
+
+/*
+ * recomputes the rpo after edges were removed, drops the blocks that are
+ * no longer reachable and recomputes the dominator tree
+ */
+void ssa_update_cfg(ssa_function * fn);
+
+#endif 	// _SSA_H
@@ -0,0 +1,179 @@
+/*
+ * stats.c
+ *
+ * main brackets each phase with stats_begin_phase / stats_end_phase. a
+ * phase is charged the wall time between the two and the growth of
+ * compile_arena's counters, so every AST node, quad arg, temp and interned
+ * string lands in the phase that made it. the symbol table and the scratch
+ * the passes malloc and free themselves aren't counted -- the peak RSS
+ * column catches them when they matter.
+ *
+ * with collect_stats off every entry point returns straight away.
+ *
+ * Yondon Fu and Matt McFarland - Delights (CS57 - 16W)
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <sys/resource.h>
+
+#include "stats.h"
+#include "arena.h"
+
+int collect_stats = 0;
+
+static phase_stats phases[MAX_PHASES];
+static int phase_count = 0;
+static int phase_open = 0;
+
+/* where the open phase started */
+static struct timespec start_time;
+static long start_allocations;
+static size_t start_bytes;
+
+static double now_seconds(struct timespec * t) {
+	return t->tv_sec + t->tv_nsec / 1e9;
+}
+
+static long peak_rss_kb() {
+	struct rusage usage;
+	if (getrusage(RUSAGE_SELF, &usage) != 0)
+		return 0;
+	return usage.ru_maxrss; 	// kilobytes on Linux
+}
+
+void stats_begin_phase(const char * name) {
+	if (!collect_stats)
+		return;
+	if (phase_open)
+		stats_end_phase();
+	if (phase_count == MAX_PHASES)
+		return;
+
+	phase_stats * p = &phases[phase_count];
+	memset(p, 0, sizeof(phase_stats));
+	p->name = name;
+
+	start_allocations = compile_arena ? compile_arena->allocations : 0;
+	start_bytes = compile_arena ? compile_arena->bytes_used : 0;
+	clock_gettime(CLOCK_MONOTONIC, &start_time);
+	phase_open = 1;
+}
+
+void stats_end_phase() {
+	if (!collect_stats || !phase_open)
+		return;
+
+	struct timespec end_time;
+	clock_gettime(CLOCK_MONOTONIC, &end_time);
+
+	phase_stats * p = &phases[phase_count++];
+	p->seconds = now_seconds(&end_time) - now_seconds(&start_time);
+	p->arena_allocations = (compile_arena ? compile_arena->allocations : 0) - start_allocations;
+	p->arena_bytes = (compile_arena ? compile_arena->bytes_used : 0) - start_bytes;
+	p->peak_rss_kb = peak_rss_kb();
+	phase_open = 0;
+}
+
+void stats_count(const char * name, long value) {
+	if (!collect_stats || phase_count == 0)
+		return;
+
+	phase_stats * p = &phases[phase_count - 1];
+	if (p->counter_count == MAX_PHASE_COUNTERS)
+		return;
+
+	p->counters[p->counter_count].name = name;
+	p->counters[p->counter_count].value = value;
+	p->counter_count++;
+}
+
+long count_ys_instructions(const char * path) {
+	FILE * fp = fopen(path, "r");
+	if (!fp)
+		return -1;
+
+	long count = 0;
+	char line[256];
+	int line_start = 1;
+	while (fgets(line, sizeof(line), fp)) {
+		/* labels and directives start in column 0, instructions are indented */
+		if (line_start && line[0] == '\t') {
+			char * p = line;
+			while (*p == '\t' || *p == ' ')
+				p++;
+			if (*p != '#' && *p != '\n' && *p != '\0')
+				count++;
+		}
+		line_start = strchr(line, '\n') != NULL;
+	}
+
+	fclose(fp);
+	return count;
+}
+
+static void print_stats_table(FILE * fp) {
+	double seconds = 0;
+	long allocations = 0;
+	size_t bytes = 0;
+
+	fprintf(fp, "%-10s %10s %12s %12s %10s  %s\n", "phase", "ms", "arena_allocs", "arena_bytes", "rss KB", "objects");
+	for (int i = 0; i < phase_count; i++) {
+		phase_stats * p = &phases[i];
+		fprintf(fp, "%-10s %10.3f %12ld %12lu %10ld ", p->name, p->seconds * 1000,
+			p->arena_allocations, (unsigned long)p->arena_bytes, p->peak_rss_kb);
+		for (int c = 0; c < p->counter_count; c++)
+			fprintf(fp, "%s %s %ld", c ? "," : "", p->counters[c].name, p->counters[c].value);
+		fprintf(fp, "\n");
+
+		seconds += p->seconds;
+		allocations += p->arena_allocations;
+		bytes += p->arena_bytes;
+	}
+
+	fprintf(fp, "%-10s %10.3f %12ld %12lu %10ld ", "total", seconds * 1000,
+		allocations, (unsigned long)bytes, peak_rss_kb());
+	if (compile_arena)
+		fprintf(fp, " arena %lu bytes in %d chunks", (unsigned long)compile_arena->bytes_reserved,
+			compile_arena->chunk_count);
+	fprintf(fp, "\n");
+}
+
+static void print_stats_json(FILE * fp) {
+	double seconds = 0;
+	long allocations = 0;
+	size_t bytes = 0;
+
+	fprintf(fp, "{\"phases\": [");
+	for (int i = 0; i < phase_count; i++) {
+		phase_stats * p = &phases[i];
+		fprintf(fp, "%s\n  {\"name\": \"%s\", \"seconds\": %.9f, \"arena_allocations\": %ld, \"arena_bytes\": %lu, \"peak_rss_kb\": %ld, \"objects\": {",
+			i ? "," : "", p->name, p->seconds, p->arena_allocations, (unsigned long)p->arena_bytes, p->peak_rss_kb);
+		for (int c = 0; c < p->counter_count; c++)
+			fprintf(fp, "%s\"%s\": %ld", c ? ", " : "", p->counters[c].name, p->counters[c].value);
+		fprintf(fp, "}}");
+
+		seconds += p->seconds;
+		allocations += p->arena_allocations;
+		bytes += p->arena_bytes;
+	}
+
+	fprintf(fp, "\n ],\n \"total\": {\"seconds\": %.9f, \"arena_allocations\": %ld, \"arena_bytes\": %lu, \"peak_rss_kb\": %ld",
+		seconds, allocations, (unsigned long)bytes, peak_rss_kb());
+	if (compile_arena)
+		fprintf(fp, ", \"arena_reserved\": %lu, \"arena_chunks\": %d",
+			(unsigned long)compile_arena->bytes_reserved, compile_arena->chunk_count);
+	fprintf(fp, "}}\n");
+}
+
+void print_stats(FILE * fp, int json) {
+	if (!collect_stats)
+		return;
+	stats_end_phase();
+
+	if (json)
+		print_stats_json(fp);
+	else
+		print_stats_table(fp);
+}
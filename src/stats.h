@@ -0,0 +1,60 @@
+/*
+ * stats.h
+ *
+ * per-phase cost of a compilation: wall time, arena allocations and the
+ * objects each phase produced, reported by --stats
+ * Yondon Fu and Matt McFarland - Delights (CS57 - 16W)
+ */
+
+#ifndef _STATS_H
+#define _STATS_H
+
+#include <stdio.h>
+#include <stddef.h>
+
+#define MAX_PHASES 32
+#define MAX_PHASE_COUNTERS 4
+
+/*
+ * 0 (default) for no bookkeeping at all, 1 once main sees --stats
+ */
+extern int collect_stats;
+
+typedef struct stat_counter {
+	const char * name;
+	long value;
+} stat_counter;
+
+typedef struct phase_stats {
+	const char * name;
+	double seconds; 				// wall clock
+	long arena_allocations; 		// compile_arena allocations made during the phase (not malloc)
+	size_t arena_bytes; 			// compile_arena bytes handed out during the phase
+	long peak_rss_kb; 				// process high-water mark when the phase ended
+	int counter_count;
+	stat_counter counters[MAX_PHASE_COUNTERS]; 	// objects the phase left behind
+} phase_stats;
+
+/*
+ * starts timing a phase. phases don't nest -- an open phase is ended first
+ */
+void stats_begin_phase(const char * name);
+
+void stats_end_phase();
+
+/*
+ * records an object count (ast nodes, quads, ...) against the last phase
+ */
+void stats_count(const char * name, long value);
+
+/*
+ * instructions in a written .ys file -- indented lines that aren't comments
+ */
+long count_ys_instructions(const char * path);
+
+/*
+ * table of every phase plus totals, or the same as one JSON object
+ */
+void print_stats(FILE * fp, int json);
+
+#endif 	// _STATS_H
@@ -14,6 +14,7 @@
 #include "ast.h"
 #include "ast_stack.h"
 #include "temp_list.h"
+#include "intern.h"
 #include <assert.h>
 #include <string.h>
 #include <stdio.h>
@@ -21,7 +22,10 @@
 #define INIT_STK_SIZE 10
 #define ACTIVATION_OFFSET 8
 
-static const int HASHSIZE = 211;
+static const int HASHSIZE = 211;         // global scope
+static const int BLOCK_HASHSIZE = 7;     // function and block scopes start small...
+static const int MAX_LOAD = 2;           // ...and grow when they average more than this per slot
+#define MAX_CHAIN_STAT 8                 // chains this long or longer share a bucket in the stats
 
 /*
  * traverses an AST parse tree and completes symbol
@@ -55,6 +59,11 @@ void traverse_ast_tree(ast_node root, symboltable_t * symtab) {
     // can return now because parent call will move onto sibling
     break;
 
+  case ID_N:
+    /* a use (declarations aren't traversed) -- bind it to what's visible here */
+    root->binding = lookup_in_symboltable(symtab, root->value_string);
+    break;
+
   case COMPOUND_STMT_N:
     if (root->left_child != NULL)
       enter_scope(symtab, root, "BLOCK");
@@ -265,8 +274,9 @@ void handle_var_decl_line_node(ast_node vdl, symboltable_t * symtab) {
     // calculate change in stack pointer
     symhashtable_t * symhashtab = vdl->scope_table;
 
-    // Initialize variable
-    var_symbol new_var = init_variable(name, this_type, mod, LOCAL_VAR, byte_size);
+    // Initialize variable -- declarations in the outermost scope are globals
+    variable_specie_t specie = (symhashtab == symtab->root) ? GLOBAL_VAR : LOCAL_VAR;
+    var_symbol new_var = init_variable(name, this_type, mod, specie, byte_size);
 
     // Set variable field in symnode
     set_node_var(var_node, &new_var);
@@ -308,6 +318,7 @@ var_symbol init_variable(char * name, type_specifier_t type, modifier_t mod, var
   new_var.byte_size = byte_size;
   new_var.modifier = mod;
   new_var.specie = specie;
+  new_var.reg = NO_REG;
 
   return new_var;
 }
@@ -347,7 +358,7 @@ symnode_t * create_symnode(symhashtable_t *hashtable, char *name, ast_node origi
   assert(hashtable);
   assert(name);
 
-  symnode_t * node = (symnode_t *)malloc(sizeof(symnode_t));
+  symnode_t * node = (symnode_t *)calloc(1, sizeof(symnode_t));
   assert(node);
   node->name = name;
   node->parent = hashtable;
@@ -380,6 +391,7 @@ void set_node_var(symnode_t *node, var_symbol *var) {
   node->s.v.specie = var->specie;
   node->s.v.byte_size = var->byte_size;
   //node->s.v.offset_of_frame_pointer = var->offset_of_frame_pointer;
+  node->s.v.reg = NO_REG;
 
 }
 
@@ -391,17 +403,14 @@ void set_node_func(symnode_t *node, char * name, type_specifier_t type, int arg_
   node->s.f.return_type = type;
   node->s.f.arg_count = arg_count;
   node->s.f.arg_arr = arg_arr;
+  node->s.f.saved_regs = 0;
 
 }
 
 int name_is_equal(symnode_t *node, char *name) {
 
-  // 1 is true and 0 is false, but is this the convention in C?
-  if (strcmp(node->name, name) == 0) {
-    return 1;
-  } else {
-    return 0;
-  }
+  // names are interned, so equal names are the same pointer
+  return node->name == name;
 }
 
 /*
@@ -432,19 +441,10 @@ symhashtable_t *create_symhashtable(int entries)    // modified function call
   return hashtable;
 }
 
-/* Peter Weinberger's hash function, from Aho, Sethi, & Ullman
-   p. 436. */
-static int hashPJW(char *s, int size) {
-  unsigned h = 0, g;
-  char *p;
-
-  for (p = s; *p != '\0'; p++) {
-      h = (h << 4) + *p;
-      if ((g = (h & 0xf0000000)) != 0)
-  h ^= (g >> 24) ^ g;
-    }
-
-  return h % size;
+/* slot of name in a table of size entries -- the interner already
+   hashed it (Peter Weinberger's hash, see intern.c) */
+static int hash_slot(char *name, int size) {
+  return intern_hash(name) % size;
 }
 
 /* Look up an entry in a symhashtable, returning either a pointer to
@@ -457,7 +457,7 @@ symnode_t *lookup_symhashtable(symhashtable_t *hashtable, char *name,
   assert(hashtable);
 
   if (slot == NOHASHSLOT)
-    slot = hashPJW(name, hashtable->size);
+    slot = hash_slot(name, hashtable->size);
 
   for (node = hashtable->table[slot];
        node != NULL && !name_is_equal(node, name);
@@ -485,14 +485,36 @@ symnode_t * look_up_scopes_to_find_symbol(symhashtable_t * first_scope, char *na
 }
 
 
+/* Rehash every entry into a table of size slots.  Names carry their
+   hash from the interner, so this never looks at the strings. */
+static void resize_symhashtable(symhashtable_t *hashtable, int size) {
+  symnode_t **table = (symnode_t **)calloc(size, sizeof(symnode_t *));
+  assert(table);
+
+  for (int i = 0; i < hashtable->size; i++) {
+    symnode_t *node = hashtable->table[i];
+    while (node != NULL) {
+      symnode_t *next = node->next;
+      int slot = hash_slot(node->name, size);
+      node->next = table[slot];
+      table[slot] = node;
+      node = next;
+    }
+  }
+
+  free(hashtable->table);
+  hashtable->table = table;
+  hashtable->size = size;
+}
+
 /* Insert a new entry into a symhashtable, but only if it is not
    already present. */
 symnode_t *insert_into_symhashtable(symhashtable_t *hashtable, char *name, ast_node origin) {
 
   assert(hashtable);
 
-  int slot = hashPJW(name, hashtable->size);
-  symnode_t *node = lookup_symhashtable(hashtable, name, NOHASHSLOT);
+  int slot = hash_slot(name, hashtable->size);
+  symnode_t *node = lookup_symhashtable(hashtable, name, slot);
 
   /* error check if node already existed! */
 
@@ -500,6 +522,11 @@ symnode_t *insert_into_symhashtable(symhashtable_t *hashtable, char *name, ast_n
     node = create_symnode(hashtable, name, origin);
     node->next = hashtable->table[slot];
     hashtable->table[slot] = node;
+
+    /* keep chains short -- function scopes collect every temp */
+    hashtable->count++;
+    if (hashtable->count > MAX_LOAD * hashtable->size)
+      resize_symhashtable(hashtable, 2 * hashtable->size + 1);
   } 
 
   return node;
@@ -512,7 +539,7 @@ symnode_t *insert_into_symhashtable(symhashtable_t *hashtable, char *name, ast_n
 
 /* Create an empty symbol table. */
 symboltable_t  *create_symboltable() {
-  symboltable_t *symtab = malloc(sizeof(symboltable_t));
+  symboltable_t *symtab = calloc(1, sizeof(symboltable_t));
   assert(symtab);
 
   symhashtable_t *hashtable = create_symhashtable(HASHSIZE);
@@ -525,6 +552,25 @@ symboltable_t  *create_symboltable() {
   return symtab;
 }
 
+/* slot for name's id in symtab->bindings, growing it if the interner
+   handed out new ids since */
+static symnode_t **binding_slot(symboltable_t *symtab, char *name) {
+  int id = intern_id(name);
+
+  if (id >= symtab->binding_size) {
+    int size = symtab->binding_size ? symtab->binding_size : 64;
+    while (size <= id)
+      size *= 2;
+
+    symtab->bindings = realloc(symtab->bindings, size * sizeof(symnode_t *));
+    assert(symtab->bindings);
+    memset(symtab->bindings + symtab->binding_size, 0, (size - symtab->binding_size) * sizeof(symnode_t *));
+    symtab->binding_size = size;
+  }
+
+  return &symtab->bindings[id];
+}
+
 /* Insert an entry into the innermost scope of symbol table.  First
    make sure it's not already in that scope.  Return a pointer to the
    entry. */
@@ -533,37 +579,43 @@ symnode_t *insert_into_symboltable(symboltable_t *symtab, char *name, ast_node o
   assert(symtab);
   assert(symtab->leaf);
   
-  symnode_t *node = lookup_symhashtable(symtab->leaf, name, NOHASHSLOT);
+  symnode_t **binding = binding_slot(symtab, name);
 
-  /* error check!! */
-  
-  if (node == NULL) {
-    node = insert_into_symhashtable(symtab->leaf, name, origin);
-    return node;
-  } else {
+  /* already declared in this scope */
+  if (*binding != NULL && (*binding)->parent == symtab->leaf)
     return NULL;
-  }  
+
+  symnode_t *node = insert_into_symhashtable(symtab->leaf, name, origin);
+
+  /* push onto the name's shadow stack */
+  node->shadowed = *binding;
+  *binding = node;
+  node->scope_next = symtab->leaf->declarations;
+  symtab->leaf->declarations = node;
+
+  return node;
 }
 
 /* Lookup an entry in a symbol table.  If found return a pointer to it.
    Otherwise, return NULL */
 symnode_t *lookup_in_symboltable(symboltable_t  *symtab, char *name) {
-  symnode_t *node;
-  symhashtable_t *hashtable;
-
   assert(symtab);
 
   if (symtab->leaf == NULL) {
     printf("leaf is null!\n");
   }
 
-  for (node = NULL, hashtable = symtab->leaf;
-       (node == NULL) &&  (hashtable != NULL);
-       hashtable = hashtable->parent) {
-    node = lookup_symhashtable(hashtable, name, NOHASHSLOT);
-  }
+  return *binding_slot(symtab, name);
+}
 
-  return node;
+symnode_t *resolve_identifier(ast_node id) {
+  if (!id)
+    return NULL;
+
+  if (id->binding != NULL)
+    return (symnode_t *)id->binding;
+
+  return look_up_scopes_to_find_symbol(id->scope_table, id->value_string);
 }
 
 symnode_t * find_in_top_symboltable(symboltable_t * symtab, char * name) {
@@ -577,6 +629,17 @@ symnode_t * find_in_top_symboltable(symboltable_t * symtab, char * name) {
   return node;
 }
 
+symhashtable_t * find_function_scope(symboltable_t * symtab, symnode_t * func_sym) {
+  if (!symtab || !func_sym)
+    return NULL;
+
+  for (symhashtable_t * scope = symtab->root->child; scope != NULL; scope = scope->rightsib) {
+    if (scope->function_owner == func_sym)
+      return scope;
+  }
+  return NULL;
+}
+
 
 /*
   Functions for entering and leaving scope
@@ -592,7 +655,7 @@ void enter_scope(symboltable_t *symtab, ast_node node, char *name) {
   // Check if current leaf has any children
   if (symtab->leaf->child == NULL) {
     // Child becomes new leaf
-    symtab->leaf->child = create_symhashtable(HASHSIZE);
+    symtab->leaf->child = create_symhashtable(BLOCK_HASHSIZE);
     symtab->leaf->child->level = symtab->leaf->level + 1;
     symtab->leaf->child->sibno = 0;
     symtab->leaf->child->parent = symtab->leaf;
@@ -616,7 +679,7 @@ void enter_scope(symboltable_t *symtab, ast_node node, char *name) {
     for (hashtable = symtab->leaf->child;
       hashtable->rightsib != NULL; hashtable = hashtable->rightsib);
 
-    hashtable->rightsib = create_symhashtable(HASHSIZE);
+    hashtable->rightsib = create_symhashtable(BLOCK_HASHSIZE);
     hashtable->rightsib->level = symtab->leaf->level + 1;
     hashtable->rightsib->sibno = hashtable->sibno + 1;
     hashtable->rightsib->parent = symtab->leaf;
@@ -647,9 +710,21 @@ void leave_scope(symboltable_t *symtab) {
   DestroyASTStack(symtab->leaf->scopeStack);
   symtab->leaf->scopeStack = NULL;
 
+  // pop this scope's declarations off their shadow stacks
+  for (symnode_t *node = symtab->leaf->declarations; node != NULL; node = node->scope_next)
+    symtab->bindings[intern_id(node->name)] = node->shadowed;
+
   symtab->leaf = symtab->leaf->parent;
 }
 
+static void print_var_symbol(var_symbol *v) {
+  printf("VAR_TYPE: %s, ", TYPE_NAME(v->type));
+  printf("MODIFIER: %s, ", MODIFIER_NAME(v->modifier));
+  printf("SIZE: %d, ", v->byte_size);
+  printf("SPECIE: %s ", VAR_SPECIE_NAME(v->specie));
+  printf("[offset %d]", v->offset_of_frame_pointer);
+}
+
 void print_symhash(symhashtable_t *hashtable) {
   // Print spacing
   for (int i = 0; i < hashtable->level; i++) {
@@ -673,11 +748,7 @@ void print_symhash(symhashtable_t *hashtable) {
 
       switch (node->sym_type) {
         case VAR_SYM:
-          printf("VAR_TYPE: %s, ", TYPE_NAME(node->s.v.type));
-          printf("MODIFIER: %s, ", MODIFIER_NAME(node->s.v.modifier));
-          printf("SIZE: %d, ", node->s.v.byte_size);
-          printf("SPECIE: %s ", VAR_SPECIE_NAME(node->s.v.specie));
-          printf("[offset %d]", node->s.v.offset_of_frame_pointer);
+          print_var_symbol(&node->s.v);
           break;
 
         case FUNC_SYM:
@@ -699,6 +770,20 @@ void print_symhash(symhashtable_t *hashtable) {
     }
   }
 
+  // temps aren't in the hash tables -- list the function's temp table here
+  if (hashtable->level == 1 && hashtable->t_list != NULL) {
+    for (int i = 0; i < hashtable->t_list->count; i++) {
+      symnode_t *temp = (symnode_t *)hashtable->t_list->list[i]->temp_symnode;
+
+      for (int j = 0; j < hashtable->level + 1; j++) {
+        printf("  ");
+      }
+      printf("NAME: %d_temp, ", i);
+      print_var_symbol(&temp->s.v);
+      printf("\n");
+    }
+  }
+
   printf("\n");
 
   // Recurse on each child
@@ -716,3 +801,71 @@ void print_symtab(symboltable_t *symtab) {
   print_symhash(symtab->root);
 }
 
+/* adds one scope's chain lengths to chains[] and recurses into its children */
+static void print_symhash_stats(symhashtable_t *hashtable, long *chains, long *totals) {
+  int longest = 0;
+
+  for (int i = 0; i < hashtable->size; i++) {
+    int length = 0;
+    for (symnode_t *node = hashtable->table[i]; node != NULL; node = node->next)
+      length++;
+
+    chains[length < MAX_CHAIN_STAT ? length : MAX_CHAIN_STAT]++;
+    if (length > longest)
+      longest = length;
+  }
+
+  for (int i = 0; i < hashtable->level; i++)
+    printf("  ");
+  printf("SCOPE: %d-%d %s: %d entries in %d slots (load %.2f), longest chain %d\n",
+    hashtable->level, hashtable->sibno, hashtable->name, hashtable->count, hashtable->size,
+    (double)hashtable->count / hashtable->size, longest);
+
+  totals[0]++;
+  totals[1] += hashtable->count;
+  totals[2] += hashtable->size;
+
+  for (symhashtable_t *table = hashtable->child; table != NULL; table = table->rightsib)
+    print_symhash_stats(table, chains, totals);
+}
+
+/*
+ * Print the size and chain lengths of every scope's hash table
+ */
+void print_symtab_stats(symboltable_t *symtab) {
+  long chains[MAX_CHAIN_STAT + 1] = {0};
+  long totals[3] = {0};     // scopes, entries, slots
+
+  print_symhash_stats(symtab->root, chains, totals);
+
+  printf("%ld scopes, %ld entries in %ld slots\n", totals[0], totals[1], totals[2]);
+  printf("chain length:");
+  for (int i = 0; i <= MAX_CHAIN_STAT; i++)
+    printf(" %d%s:%ld", i, i == MAX_CHAIN_STAT ? "+" : "", chains[i]);
+  printf("\n");
+}
+
+
+/* adds one scope, its entries and its temps to totals[] and recurses into its children */
+static void count_symhash(symhashtable_t *hashtable, long *totals) {
+  totals[0]++;
+  totals[1] += hashtable->count;
+  if (hashtable->level == 1 && hashtable->t_list)    // block scopes share their function's list
+    totals[2] += hashtable->t_list->count;
+
+  for (symhashtable_t *table = hashtable->child; table != NULL; table = table->rightsib)
+    count_symhash(table, totals);
+}
+
+/*
+ * Count scopes, symbols and temps in the symbol table (for --stats)
+ */
+void count_symtab(symboltable_t *symtab, long *scopes, long *symbols, long *temps) {
+  long totals[3] = {0};     // scopes, entries, temps
+
+  count_symhash(symtab->root, totals);
+
+  *scopes = totals[0];
+  *symbols = totals[1];
+  *temps = totals[2];
+}
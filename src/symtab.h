@@ -18,6 +18,7 @@
 #include "ast.h"
 
 #define NOHASHSLOT -1
+#define NO_REG -1         // var_symbol.reg value for variables that live in memory
 
 /*
  * declaration_specifier is for symbol.sym_type
@@ -41,6 +42,7 @@ typedef struct var_symbol {
   int byte_size; // byte size of variables, int = 4, array = 4 * length of array
   variable_specie_t specie;       // used to indicate where this thing should live in reference to the FP
   int offset_of_frame_pointer;    // bytes to subtract from frame pointer to get to bottom most byte of variable
+  int reg;                        // register assigned by the register allocator (NO_REG if in memory)
 } var_symbol;
 
 typedef struct func_symbol {
@@ -49,6 +51,8 @@ typedef struct func_symbol {
   var_symbol * arg_arr;     // array to handle dynamically sized argument parameters
 
   int stk_offset;           // where to place esp so it's below all the locals
+  int saved_regs;           // bitmask of registers the function uses and must save in its frame
+  int reg_save_offset;      // offset off of FP of the first register save slot
 } func_symbol;
 
 typedef union symbol {
@@ -61,6 +65,10 @@ typedef struct symnode {
   struct symnode  *next;	       /* next symnode in list */
   struct symhashtable *parent;
 
+  /* shadow stack links (see symboltable_t) */
+  struct symnode *shadowed;       /* binding of the same name this one hides */
+  struct symnode *scope_next;     /* next declaration in the same scope */
+
   ast_node origin;
 
   /* Other attributes go here. */
@@ -72,7 +80,8 @@ typedef struct symnode {
 /* Hash table for a given scope in a symbol table. */
 typedef struct symhashtable {
   char *name;
-  int size;      /* size of hash table */
+  int size;      /* size of hash table, grows with count */
+  int count;     /* symnodes in the table */
   symnode_t **table;    /* hash table */
   int level;      /* level of scope, 0 is outermost */
   int sibno;                    /* 0 is leftmost */
@@ -87,11 +96,22 @@ typedef struct symhashtable {
   //int local_sp;                 // number of bytes from local_base to top from to first unused spot on local stack
   temp_list * t_list;             // tracks count of local temps
 
+  symnode_t * declarations;       // declared in this scope, chained by scope_next
+
 } symhashtable_t;
 
-/* Symbol table for all levels of scope. */
+/* Symbol table for all levels of scope.
+ *
+ * bindings is indexed by the interned id of a name and holds the innermost
+ * declaration of that name in the scopes entered so far (leaf and its
+ * parents), so looking a name up is one load however deep the nesting.
+ * insert_into_symboltable pushes onto a name's shadow stack and
+ * leave_scope pops everything the scope declared. */
 typedef struct {
   symhashtable_t *root, *leaf;
+
+  symnode_t **bindings;
+  int binding_size;
     
 } symboltable_t;
 
@@ -139,7 +159,7 @@ void set_node_var(symnode_t *node, var_symbol *var);
 /* Set fields for func node */
 void set_node_func(symnode_t *node, char * name, type_specifier_t type, int arg_count, var_symbol *arg_arr);
 
-/* Does the identifier in this node equal name? */
+/* Does the identifier in this node equal name? (name must be interned) */
 int name_is_equal(symnode_t *node, char *name);
 
 
@@ -152,10 +172,15 @@ symboltable_t *create_symboltable();
    entry. */
 symnode_t *insert_into_symboltable(symboltable_t *symtab, char *name, ast_node origin);
 
-/* Lookup an entry in a symbol table.  If found return a pointer to it.
-   Otherwise, return NULL */
+/* Lookup an entry in a symbol table (innermost visible declaration).  If
+   found return a pointer to it.  Otherwise, return NULL */
 symnode_t *lookup_in_symboltable(symboltable_t *symtab, char *name);
 
+/* symnode an ID_N node refers to: the binding recorded while the table
+   was built, or a search up from its scope for names declared after the
+   use (calls to functions defined further down) */
+symnode_t *resolve_identifier(ast_node id);
+
 /* Lookup an entry in a symbol hash table. Returns NULL if symnode not found */
 symnode_t *lookup_symhashtable(symhashtable_t *hashtable, char *name, int slot);
 
@@ -171,6 +196,9 @@ symnode_t *insert_into_symhashtable(symhashtable_t *hashtable, char *name, ast_n
 /* search top level scope for symbol */
 symnode_t * find_in_top_symboltable(symboltable_t * symtab, char * name);
 
+/* scope of func_sym's body (holds its parameters, locals and temp_list), or NULL */
+symhashtable_t * find_function_scope(symboltable_t * symtab, symnode_t * func_sym);
+
 /* Enter a new scope. */
 void enter_scope(symboltable_t *symtab, ast_node node, char *name);
 
@@ -182,4 +210,10 @@ void print_symtab(symboltable_t *symtab);
 
 void print_symhash(symhashtable_t *symtab);
 
+/* print entries, slots and chain lengths of every scope's hash table */
+void print_symtab_stats(symboltable_t *symtab);
+
+/* number of scopes, symbols and temps in the table (for --stats) */
+void count_symtab(symboltable_t *symtab, long *scopes, long *symbols, long *temps);
+
 #endif
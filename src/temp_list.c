@@ -9,6 +9,8 @@
 #include "types.h"
 #include "symtab.h"
 #include "ast.h"
+#include "arena.h"
+#include "intern.h"
 #include "stdio.h" 		// for sprintf
 #include <assert.h>
 
@@ -33,19 +35,23 @@ temp_var * new_temp(ast_node root) {
   if (!root)
     return NULL;
 
-  // get root's scope table temp list
-  temp_list * t_list = ((symhashtable_t *)root->scope_table)->t_list;
+  return new_scope_temp(root->scope_table);
+}
+
+// get new temp in the function owning scope (for passes after CG)
+temp_var * new_scope_temp(void * scope) {
+  if (!scope)
+    return NULL;
+
+  // get the scope's temp list (shared by the function's block scopes)
+  temp_list * t_list = ((symhashtable_t *)scope)->t_list;
 
   // get a new temp from the list
-  temp_var * new_var = (temp_var *)calloc(1,sizeof(temp_var));
-  assert(new_var);
+  temp_var * new_var = (temp_var *)arena_calloc(compile_arena, 1, sizeof(temp_var));
 
-  // give unique id
+  // give unique id -- index into the function's temp list
   new_var->id = t_list->count;      
 
-  // make new name -- not yet
-  char * name = make_temp_name(new_var->id);
-
   // put new temp in list
   t_list->list[t_list->count] = new_var;
 
@@ -57,10 +63,10 @@ temp_var * new_temp(ast_node root) {
     assert(t_list->list);
   }
 
-  // add that new temp to local table under the name
-  symnode_t * new_node = insert_into_symhashtable(root->scope_table,name, NULL);
-
-  // attach temp to created symnode
+  // the temp's frame slot and register live in a variable record of its
+  // own -- temps never go into the scope's hash table and have no name
+  symnode_t * new_node = (symnode_t *)arena_calloc(compile_arena, 1, sizeof(symnode_t));
+  new_node->parent = scope;
   new_var->temp_symnode = new_node;
 
   // set node type
@@ -68,13 +74,12 @@ temp_var * new_temp(ast_node root) {
 
   // set node characteristics
   var_symbol node_model;
-  node_model.name = name;
+  node_model.name = NULL;
   node_model.type = INT_TS;
   node_model.modifier = SINGLE_DT;
   node_model.specie = TEMP_VAR;
   node_model.byte_size = TYPE_SIZE(INT_TS);
 
-  // save to symbol table 
   set_node_var(new_node, &node_model);
 
   // return newly created temp
@@ -109,25 +114,21 @@ temp_var * new_temp(ast_node root) {
 //   symnode_t * new_node = insert_into_symhashtable(symhashtab,name, NULL);
 // }
 
+// display name of temp id, for dumps
 char * make_temp_name(int id) {
-	char * str = (char *)calloc(MAX_TEMP_NAME_LENGTH, sizeof(char));
-	assert(str);
-	sprintf(str,"%d_temp",id);
-	return str;
+	char str[MAX_TEMP_NAME_LENGTH];
+	snprintf(str, MAX_TEMP_NAME_LENGTH, "%d_temp",id);
+	return intern(compile_strings, str);
 }
 
-// destroy temp variable
+// destroy temp variable (temps live in the arena -- nothing to do)
 void destroy_temp_var(temp_var * v) {
-  if (v != NULL)
-    free(v);
 }
 
 // destroy whole temp list
 void destroy_temp_list(temp_list * lst){
   if (lst != NULL) {
-    for (int i = 0; i < lst->count; i++ ) {
-      destroy_temp_var(lst->list[i]);
-    }
+    free(lst->list);
     free(lst);
   }
 }
\ No newline at end of file
@@ -17,12 +17,12 @@
  * temporary variable structure
  */
 typedef struct temp_var {
-  int id;
-  void * temp_symnode; 	// because compiler issue
+  int id;               // index in the function's temp_list
+  void * temp_symnode; 	// symnode_t holding the temp's frame offset and register -- not in any symhashtable
 } temp_var;
 
 /*
- * simplest temporary variable structure
+ * dense per-function table of temps, indexed by id
  * each temporary will be given out once (so it's read once only)
  */
 typedef struct temp_list {
@@ -45,13 +45,21 @@ temp_list * init_temp_list();
  */
  temp_var * new_temp(ast_node root);
 
+/*
+ * new_scope_temp()
+ *
+ * new temp of the function scope (symhashtable_t *) scope -- for passes
+ * that make temps after CG, when there's no AST node at hand
+ */
+temp_var * new_scope_temp(void * scope);
+
 /*
  * destroys a temporary variable struct
  */
 void destroy_temp_var(temp_var * v);
 
 /*
- * makes a temp name on heap, must be freed later
+ * display name of a temp ("<id>_temp") -- temps aren't looked up by name
  */
 char * make_temp_name(int id);
 
@@ -9,6 +9,7 @@
 #define _TYPES_H
 
 #include "stdlib.h"
+#include "stdio.h"
 
 /*
  * ----- TYPE ENUMERATIONS -----
@@ -98,4 +99,16 @@ static val_name_pair variable_specie_table[] = {
 #define VAR_SPECIE_INDEX(X)    ( (X) - GLOBAL_VAR)
 #define VAR_SPECIE_NAME(X)     ( variable_specie_table[ VAR_SPECIE_INDEX((X)) ].name)
 
+/*
+ * ----- VERBOSITY -----
+ * set with -v on the command line (y86_code_main.c), silent by default.
+ * traces go to stderr so they never mix with the dumps on stdout.
+ */
+extern int verbosity;
+
+#define VERBOSE_PHASES    1   // phases and one line per quad translated
+#define VERBOSE_OPERANDS  2   // every operand fetched or stored
+
+#define TRACE(LEVEL, ...) do { if (verbosity >= (LEVEL)) fprintf(stderr, __VA_ARGS__); } while (0)
+
 #endif 	// _TYPES_H
\ No newline at end of file
@@ -0,0 +1,509 @@
+/*
+ * y86_asm.c
+ *
+ * two pass assembler for the subset of yas syntax create_ys() produces:
+ * "label:" lines, instructions with register / immediate / "D(%reg)"
+ * operands, '$' before numbers (ignored), decimal and 0x hex numbers,
+ * the .pos / .align / .long / .word / .byte directives and '#', "//" and
+ * "/ *" comments running to the end of the line. The first pass places
+ * labels, the second writes the bytes.
+ *
+ * Yondon Fu and Matt McFarland - Delights (CS57 - 16W)
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <ctype.h>
+#include <assert.h>
+
+#include "y86_asm.h"
+
+#define MAX_LINE_LEN 1024
+#define MAX_TOKEN_LEN 128
+#define MAX_LINE_TOKENS 16
+#define INIT_LABEL_COUNT 64
+
+typedef enum {
+	ARG_NONE,
+	ARG_REG,
+	ARG_MEM, 		// D(%reg), D or (%reg)
+	ARG_IMM, 		// number or label
+	ARG_SHIFT 		// 4 bit shift amount
+} asm_arg_kind;
+
+typedef struct asm_instr {
+	char * name;
+	unsigned char code;
+	int bytes;
+	asm_arg_kind a;
+	asm_arg_kind b;
+} asm_instr;
+
+static asm_instr instr_table[] = {
+	{"nop",    Y86_PACK(Y86_NOP, 0),            1, ARG_NONE,  ARG_NONE},
+	{"halt",   Y86_PACK(Y86_HALT, 0),           1, ARG_NONE,  ARG_NONE},
+	{"rrmovl", Y86_PACK(Y86_RRMOVL, COND_YES),  2, ARG_REG,   ARG_REG},
+	{"cmovle", Y86_PACK(Y86_RRMOVL, COND_LE),   2, ARG_REG,   ARG_REG},
+	{"cmovl",  Y86_PACK(Y86_RRMOVL, COND_L),    2, ARG_REG,   ARG_REG},
+	{"cmove",  Y86_PACK(Y86_RRMOVL, COND_E),    2, ARG_REG,   ARG_REG},
+	{"cmovne", Y86_PACK(Y86_RRMOVL, COND_NE),   2, ARG_REG,   ARG_REG},
+	{"cmovge", Y86_PACK(Y86_RRMOVL, COND_GE),   2, ARG_REG,   ARG_REG},
+	{"cmovg",  Y86_PACK(Y86_RRMOVL, COND_G),    2, ARG_REG,   ARG_REG},
+	{"irmovl", Y86_PACK(Y86_IRMOVL, 0),         6, ARG_IMM,   ARG_REG},
+	{"rmmovl", Y86_PACK(Y86_RMMOVL, 0),         6, ARG_REG,   ARG_MEM},
+	{"mrmovl", Y86_PACK(Y86_MRMOVL, 0),         6, ARG_MEM,   ARG_REG},
+	{"addl",   Y86_PACK(Y86_ALU, ALU_ADD),      2, ARG_REG,   ARG_REG},
+	{"subl",   Y86_PACK(Y86_ALU, ALU_SUB),      2, ARG_REG,   ARG_REG},
+	{"andl",   Y86_PACK(Y86_ALU, ALU_AND),      2, ARG_REG,   ARG_REG},
+	{"xorl",   Y86_PACK(Y86_ALU, ALU_XOR),      2, ARG_REG,   ARG_REG},
+	{"mull",   Y86_PACK(Y86_ALU, ALU_MUL),      2, ARG_REG,   ARG_REG},
+	{"divl",   Y86_PACK(Y86_ALU, ALU_DIV),      2, ARG_REG,   ARG_REG},
+	{"modl",   Y86_PACK(Y86_ALU, ALU_MOD),      2, ARG_REG,   ARG_REG},
+	{"shll",   Y86_PACK(Y86_ALU, ALU_SHL),      2, ARG_SHIFT, ARG_REG},
+	{"shrl",   Y86_PACK(Y86_ALU, ALU_SHR),      2, ARG_SHIFT, ARG_REG},
+	{"jmp",    Y86_PACK(Y86_JMP, COND_YES),     5, ARG_IMM,   ARG_NONE},
+	{"jle",    Y86_PACK(Y86_JMP, COND_LE),      5, ARG_IMM,   ARG_NONE},
+	{"jl",     Y86_PACK(Y86_JMP, COND_L),       5, ARG_IMM,   ARG_NONE},
+	{"je",     Y86_PACK(Y86_JMP, COND_E),       5, ARG_IMM,   ARG_NONE},
+	{"jne",    Y86_PACK(Y86_JMP, COND_NE),      5, ARG_IMM,   ARG_NONE},
+	{"jge",    Y86_PACK(Y86_JMP, COND_GE),      5, ARG_IMM,   ARG_NONE},
+	{"jg",     Y86_PACK(Y86_JMP, COND_G),       5, ARG_IMM,   ARG_NONE},
+	{"call",   Y86_PACK(Y86_CALL, 0),           5, ARG_IMM,   ARG_NONE},
+	{"ret",    Y86_PACK(Y86_RET, 0),            1, ARG_NONE,  ARG_NONE},
+	{"pushl",  Y86_PACK(Y86_PUSHL, 0),          2, ARG_REG,   ARG_NONE},
+	{"popl",   Y86_PACK(Y86_POPL, 0),           2, ARG_REG,   ARG_NONE},
+	{"iaddl",  Y86_PACK(Y86_IADDL, 0),          6, ARG_IMM,   ARG_REG},
+	{"leave",  Y86_PACK(Y86_LEAVE, 0),          1, ARG_NONE,  ARG_NONE},
+	{NULL,     0,                               0, ARG_NONE,  ARG_NONE}
+};
+
+static char * asm_reg_names[] = {"%eax", "%ecx", "%edx", "%ebx", "%esp", "%ebp", "%esi", "%edi"};
+
+typedef enum {
+	TOK_IDENT,
+	TOK_REG,
+	TOK_NUM,
+	TOK_PUNCT
+} asm_token_kind;
+
+typedef struct asm_token {
+	asm_token_kind kind;
+	char text[MAX_TOKEN_LEN];
+	int value; 		// number, register id or punctuation character
+} asm_token;
+
+typedef struct asm_label {
+	char * name;
+	int address;
+} asm_label;
+
+typedef struct asm_state {
+	const char * name;
+	int line_number;
+	int errors;
+	int pass;
+	int pos; 					// current address
+
+	asm_label * labels;
+	int label_count;
+	int label_size;
+
+	unsigned char * mem;
+	int mem_size;
+} asm_state;
+
+/* both passes see the same problems -- report them on the second */
+static void asm_error(asm_state * s, const char * message, const char * detail) {
+	if (s->pass != 2)
+		return;
+
+	fprintf(stderr, "%s:%d: %s%s%s\n", s->name, s->line_number, message, detail ? " " : "", detail ? detail : "");
+	s->errors++;
+}
+
+static asm_instr * find_instr(const char * name) {
+	for (int i = 0; instr_table[i].name; i++) {
+		if (strcmp(instr_table[i].name, name) == 0)
+			return &instr_table[i];
+	}
+	return NULL;
+}
+
+int y86_instr_length(unsigned char code) {
+	for (int i = 0; instr_table[i].name; i++) {
+		if (instr_table[i].code == code)
+			return instr_table[i].bytes;
+	}
+	return 0;
+}
+
+/*
+ * ----- labels -----
+ */
+
+static int compare_label(const void * a, const void * b) {
+	return strcmp(((const asm_label *)a)->name, ((const asm_label *)b)->name);
+}
+
+/* only valid once sort_labels() ran after the first pass */
+static asm_label * find_label(asm_state * s, char * name) {
+	asm_label key;
+	key.name = name;
+	return bsearch(&key, s->labels, s->label_count, sizeof(asm_label), compare_label);
+}
+
+static void define_label(asm_state * s, const char * name) {
+	if (s->pass != 1)
+		return;
+
+	if (s->label_count == s->label_size) {
+		s->label_size *= 2;
+		s->labels = realloc(s->labels, s->label_size * sizeof(asm_label));
+		assert(s->labels);
+	}
+	s->labels[s->label_count].name = strdup(name);
+	s->labels[s->label_count].address = s->pos;
+	s->label_count++;
+}
+
+static void sort_labels(asm_state * s) {
+	qsort(s->labels, s->label_count, sizeof(asm_label), compare_label);
+
+	for (int i = 1; i < s->label_count; i++) {
+		if (strcmp(s->labels[i - 1].name, s->labels[i].name) == 0) {
+			fprintf(stderr, "%s: label %s defined twice\n", s->name, s->labels[i].name);
+			s->errors++;
+		}
+	}
+}
+
+/*
+ * ----- tokens -----
+ */
+
+static int tokenize(asm_state * s, char * line, asm_token * toks) {
+	int count = 0;
+	char * c = line;
+
+	while (*c != '\0') {
+		if (isspace((unsigned char)*c) || *c == '$') {
+			c++;
+			continue;
+		}
+
+		if (*c == '#' || (c[0] == '/' && (c[1] == '/' || c[1] == '*')))
+			break;
+
+		if (count == MAX_LINE_TOKENS) {
+			asm_error(s, "too many tokens on line", NULL);
+			return -1;
+		}
+		asm_token * t = &toks[count++];
+		char * start = c;
+
+		if (*c == '(' || *c == ')' || *c == ',' || *c == ':') {
+			t->kind = TOK_PUNCT;
+			t->value = *c++;
+		} else if (*c == '%') {
+			c++;
+			while (isalpha((unsigned char)*c))
+				c++;
+			t->kind = TOK_REG;
+			t->value = -1;
+			for (int r = 0; r < 8; r++) {
+				if ((int)strlen(asm_reg_names[r]) == c - start && strncmp(asm_reg_names[r], start, c - start) == 0)
+					t->value = r;
+			}
+			if (t->value == -1) {
+				asm_error(s, "invalid register", NULL);
+				return -1;
+			}
+		} else if (isdigit((unsigned char)*c) || (*c == '-' && isdigit((unsigned char)c[1]))) {
+			t->kind = TOK_NUM;
+			if (c[0] == '0' && (c[1] == 'x' || c[1] == 'X'))
+				t->value = (int)strtoul(c, &c, 16);
+			else
+				t->value = (int)strtol(c, &c, 10);
+		} else if (isalpha((unsigned char)*c) || *c == '_' || *c == '.') {
+			c++;
+			while (isalnum((unsigned char)*c) || *c == '_')
+				c++;
+			t->kind = TOK_IDENT;
+		} else {
+			asm_error(s, "invalid character in line", NULL);
+			return -1;
+		}
+
+		int len = c - start;
+		if (len >= MAX_TOKEN_LEN)
+			len = MAX_TOKEN_LEN - 1;
+		memcpy(t->text, start, len);
+		t->text[len] = '\0';
+	}
+
+	return count;
+}
+
+static int is_punct(asm_token * toks, int count, int i, char p) {
+	return i < count && toks[i].kind == TOK_PUNCT && toks[i].value == p;
+}
+
+/*
+ * ----- operands -----
+ */
+
+/* number or label at toks[*i] */
+static int parse_value(asm_state * s, asm_token * toks, int count, int * i, int * value) {
+	if (*i >= count) {
+		asm_error(s, "missing operand", NULL);
+		return 1;
+	}
+
+	asm_token * t = &toks[(*i)++];
+	if (t->kind == TOK_NUM) {
+		*value = t->value;
+		return 0;
+	}
+	if (t->kind == TOK_IDENT) {
+		/* labels aren't all placed until the first pass is over */
+		*value = 0;
+		if (s->pass == 1)
+			return 0;
+
+		asm_label * l = find_label(s, t->text);
+		if (!l) {
+			asm_error(s, "undefined label", t->text);
+			return 1;
+		}
+		*value = l->address;
+		return 0;
+	}
+
+	asm_error(s, "expected number or label, found", t->text);
+	return 1;
+}
+
+static int parse_reg(asm_state * s, asm_token * toks, int count, int * i, int * reg) {
+	if (*i >= count || toks[*i].kind != TOK_REG) {
+		asm_error(s, "expected register", *i < count ? toks[*i].text : NULL);
+		return 1;
+	}
+	*reg = toks[(*i)++].value;
+	return 0;
+}
+
+static int parse_mem(asm_state * s, asm_token * toks, int count, int * i, int * disp, int * base) {
+	*disp = 0;
+	*base = Y86_NO_REG;
+
+	if (*i < count && (toks[*i].kind == TOK_NUM || toks[*i].kind == TOK_IDENT)) {
+		if (parse_value(s, toks, count, i, disp))
+			return 1;
+	}
+
+	if (is_punct(toks, count, *i, '(')) {
+		(*i)++;
+		if (parse_reg(s, toks, count, i, base))
+			return 1;
+		if (!is_punct(toks, count, *i, ')')) {
+			asm_error(s, "expected ')'", NULL);
+			return 1;
+		}
+		(*i)++;
+	}
+	return 0;
+}
+
+/*
+ * ----- lines -----
+ */
+
+static void write_byte(asm_state * s, int address, unsigned char byte) {
+	if (address < 0 || address >= s->mem_size) {
+		asm_error(s, "address out of memory", NULL);
+		return;
+	}
+	s->mem[address] = byte;
+}
+
+static void write_word(asm_state * s, int address, int value, int bytes) {
+	for (int b = 0; b < bytes; b++)
+		write_byte(s, address + b, (value >> (8 * b)) & 0xFF);
+}
+
+static void assemble_directive(asm_state * s, asm_token * toks, int count, int i) {
+	char * name = toks[i++].text;
+	int value = 0;
+	if (parse_value(s, toks, count, &i, &value))
+		return;
+
+	if (strcmp(name, ".pos") == 0) {
+		s->pos = value;
+	} else if (strcmp(name, ".align") == 0) {
+		if (value <= 0) {
+			asm_error(s, "invalid alignment", NULL);
+			return;
+		}
+		s->pos = ((s->pos + value - 1) / value) * value;
+	} else {
+		int bytes = strcmp(name, ".long") == 0 ? 4 : strcmp(name, ".word") == 0 ? 2 : strcmp(name, ".byte") == 0 ? 1 : 0;
+		if (bytes == 0) {
+			asm_error(s, "unknown directive", name);
+			return;
+		}
+		if (s->pass == 2)
+			write_word(s, s->pos, value, bytes);
+		s->pos += bytes;
+	}
+}
+
+static void assemble_instr(asm_state * s, asm_token * toks, int count, int i) {
+	asm_instr * instr = find_instr(toks[i].text);
+	if (!instr) {
+		asm_error(s, "invalid instruction", toks[i].text);
+		return;
+	}
+	i++;
+
+	int address = s->pos;
+	s->pos += instr->bytes;
+	if (s->pass == 1)
+		return;
+
+	int ra = Y86_NO_REG, rb = Y86_NO_REG, value = 0;
+	asm_arg_kind kinds[2] = {instr->a, instr->b};
+
+	for (int n = 0; n < 2 && kinds[n] != ARG_NONE; n++) {
+		if (n == 1) {
+			if (!is_punct(toks, count, i, ',')) {
+				asm_error(s, "expected ','", NULL);
+				return;
+			}
+			i++;
+		}
+
+		int err = 0;
+		switch (kinds[n]) {
+			case ARG_REG:
+				/* rA, except for the second operand of irmovl / iaddl (rB) */
+				err = parse_reg(s, toks, count, &i, (n == 0 || instr->a == ARG_MEM) ? &ra : &rb);
+				break;
+
+			case ARG_MEM:
+				err = parse_mem(s, toks, count, &i, &value, &rb);
+				break;
+
+			case ARG_IMM:
+				err = parse_value(s, toks, count, &i, &value);
+				break;
+
+			case ARG_SHIFT:
+				err = parse_value(s, toks, count, &i, &ra);
+				if (!err && (ra < 0 || ra > 15)) {
+					asm_error(s, "shift amount out of range", NULL);
+					err = 1;
+				}
+				break;
+
+			default:
+				break;
+		}
+		if (err)
+			return;
+	}
+
+	if (i != count) {
+		asm_error(s, "unexpected text after instruction:", toks[i].text);
+		return;
+	}
+
+	write_byte(s, address, instr->code);
+	switch (Y86_HI(instr->code)) {
+		case Y86_HALT:
+		case Y86_NOP:
+		case Y86_RET:
+		case Y86_LEAVE:
+			break;
+
+		case Y86_JMP:
+		case Y86_CALL:
+			write_word(s, address + 1, value, 4);
+			break;
+
+		case Y86_IRMOVL:
+		case Y86_IADDL:
+			write_byte(s, address + 1, Y86_PACK(Y86_NO_REG, rb));
+			write_word(s, address + 2, value, 4);
+			break;
+
+		case Y86_RMMOVL:
+		case Y86_MRMOVL:
+			write_byte(s, address + 1, Y86_PACK(ra, rb));
+			write_word(s, address + 2, value, 4);
+			break;
+
+		default:
+			write_byte(s, address + 1, Y86_PACK(ra, rb));
+			break;
+	}
+}
+
+static void assemble_line(asm_state * s, char * line) {
+	asm_token toks[MAX_LINE_TOKENS];
+	int count = tokenize(s, line, toks);
+	if (count <= 0)
+		return;
+
+	int i = 0;
+	while (i + 1 < count && toks[i].kind == TOK_IDENT && is_punct(toks, count, i + 1, ':')) {
+		define_label(s, toks[i].text);
+		i += 2;
+	}
+	if (i == count)
+		return;
+
+	if (toks[i].kind != TOK_IDENT) {
+		asm_error(s, "expected instruction, found", toks[i].text);
+		return;
+	}
+
+	if (toks[i].text[0] == '.')
+		assemble_directive(s, toks, count, i);
+	else
+		assemble_instr(s, toks, count, i);
+}
+
+int assemble_ys(FILE * fp, const char * name, unsigned char * mem, int mem_size) {
+	if (!fp || !mem)
+		return 1;
+
+	asm_state s;
+	memset(&s, 0, sizeof(asm_state));
+	s.name = name ? name : "<input>";
+	s.mem = mem;
+	s.mem_size = mem_size;
+	s.label_size = INIT_LABEL_COUNT;
+	s.labels = (asm_label *)malloc(s.label_size * sizeof(asm_label));
+	assert(s.labels);
+
+	char line[MAX_LINE_LEN];
+	for (s.pass = 1; s.pass <= 2; s.pass++) {
+		rewind(fp);
+		s.pos = 0;
+		s.line_number = 0;
+		while (fgets(line, MAX_LINE_LEN, fp)) {
+			s.line_number++;
+			assemble_line(&s, line);
+		}
+
+		if (s.pass == 1)
+			sort_labels(&s);
+	}
+
+	for (int i = 0; i < s.label_count; i++)
+		free(s.labels[i].name);
+	free(s.labels);
+
+	return s.errors;
+}
@@ -0,0 +1,83 @@
+/*
+ * y86_asm.h
+ *
+ * Y86 instruction set (with the CS57 mull / divl / modl / shll / shrl
+ * extensions and iaddl, which create_ys() only emits with --iaddl) and an
+ * assembler for the .ys files create_ys() writes
+ * Yondon Fu and Matt McFarland - Delights (CS57 - 16W)
+ */
+
+#ifndef _Y86_ASM_H
+#define _Y86_ASM_H
+
+#include <stdio.h>
+
+#define Y86_MEM_SIZE (1 << 16)
+#define Y86_NO_REG 0xF
+
+/*
+ * instruction codes (high nibble of the first byte), same encoding as yas
+ */
+typedef enum {
+	Y86_HALT,
+	Y86_NOP,
+	Y86_RRMOVL, 	// also the cmovXX
+	Y86_IRMOVL,
+	Y86_RMMOVL,
+	Y86_MRMOVL,
+	Y86_ALU,
+	Y86_JMP, 		// also the jXX
+	Y86_CALL,
+	Y86_RET,
+	Y86_PUSHL,
+	Y86_POPL,
+	Y86_IADDL,
+	Y86_LEAVE
+} y86_icode;
+
+/*
+ * function codes of Y86_ALU
+ */
+typedef enum {
+	ALU_ADD,
+	ALU_SUB,
+	ALU_AND,
+	ALU_XOR,
+	ALU_MUL,
+	ALU_DIV,
+	ALU_MOD,
+	ALU_SHL, 		// shift amount is an immediate in the rA nibble
+	ALU_SHR
+} y86_alu_fn;
+
+/*
+ * function codes of Y86_JMP and Y86_RRMOVL
+ */
+typedef enum {
+	COND_YES,
+	COND_LE,
+	COND_L,
+	COND_E,
+	COND_NE,
+	COND_GE,
+	COND_G
+} y86_cond;
+
+#define Y86_PACK(HI, LO) 	( (((HI) & 0xF) << 4) | ((LO) & 0xF) )
+#define Y86_HI(BYTE) 		( ((BYTE) >> 4) & 0xF )
+#define Y86_LO(BYTE) 		( (BYTE) & 0xF )
+
+/*
+ * assembles the .ys source in fp (name is only used in error messages)
+ * into mem, which must be mem_size bytes and zeroed
+ *
+ * returns number of errors (0 on success)
+ */
+int assemble_ys(FILE * fp, const char * name, unsigned char * mem, int mem_size);
+
+/*
+ * length in bytes of the instruction whose first byte is code, 0 if invalid
+ */
+int y86_instr_length(unsigned char code);
+
+#endif 	// _Y86_ASM_H
@@ -8,6 +8,10 @@
 #include "symtab.h"
 #include "IR_gen.h"
 #include "y86_code_gen.h"
+#include "reg_alloc.h"
+#include "frame_pack.h"
+#include "peephole.h"
+#include "intern.h"
 #include "types.h"
 
 #define MAX_ARG_LEN 	50
@@ -24,6 +28,10 @@ extern quad_arr * quad_list; 		// global quad list
 #define KBDR_reg 0x00FFFE04 		// KEYBAORD DATA REGISTER 
 
 condition_type condition;
+symnode_t * current_function; 		// function whose quads are being translated
+static char * fused_compares = NULL; 	// 1 at quad index of a comparison fused with the branch after it
+int iaddl_enabled = 0;
+int fusion_enabled = 1;
 
 /*
  * creates ys file from global quad_list
@@ -52,7 +60,7 @@ int create_ys(char * file_name) {
 	/* 
 	 * make sure a main is called 
 	 */
-	symnode_t * main = find_in_top_symboltable(symtab, "main");
+	symnode_t * main = find_in_top_symboltable(symtab, intern(compile_strings, "main"));
 	if (!main) {
 		fprintf(stderr,"Error during .ys construction. No \"main\" function is declared -- cannot find entry point.\n");
 		exit(1);
@@ -65,7 +73,14 @@ int create_ys(char * file_name) {
 	 * stack and base pointer initialization 
 	 */
 	int stk_start = set_variable_memory_locations(symtab);
-	printf("stack starks at %x\n",stk_start);
+	TRACE(VERBOSE_PHASES, "stack starts at %x\n",stk_start);
+
+	/* comparisons feeding straight into a branch never materialize their temp */
+	mark_fused_compares();
+
+	/* keep temps and locals in registers where possible */
+	allocate_registers();
+
 	fprintf(ys_fp,".pos 0\n");	
 	print_nop_comment(ys_fp, "initialization", -1);
 	fprintf(ys_fp,"\tirmovl 0x%x, %%esp\n",stk_start);
@@ -78,9 +93,9 @@ int create_ys(char * file_name) {
 	 */
 	fprintf(ys_fp,"GLOBALS_INITIALIZATION:\n");
 	int i;
-	for (i = 0; quad_list->arr[i]->op == ASSIGN_Q; i++) {
-		printf("global initialization quad %d\n",i);
-		print_code(quad_list->arr[i], ys_fp);
+	for (i = 0; quad_list->arr[i].op == ASSIGN_Q; i++) {
+		TRACE(VERBOSE_PHASES, "global initialization quad %d\n",i);
+		print_code(&quad_list->arr[i], ys_fp);
 	}
 
 	/* 
@@ -92,9 +107,27 @@ int create_ys(char * file_name) {
 	/* 
 	 * translate quad list 
 	 */
+	FILE * out_fp = ys_fp; 		// in-memory buffer while inside a function being peephole optimized
+	char * func_code = NULL;
+	size_t func_code_len = 0;
 	for (/* start at end of global initalizations */; i < quad_list->count; i++) {
-		printf("looking at quad %d\n",i);
-		print_code(quad_list->arr[i], ys_fp);
+		TRACE(VERBOSE_PHASES, "looking at quad %d\n",i);
+
+		if (peephole_enabled && quad_list->arr[i].op == PROLOG_Q) {
+			out_fp = open_memstream(&func_code, &func_code_len);
+			if (!out_fp)
+				out_fp = ys_fp;
+		}
+
+		print_code(&quad_list->arr[i], out_fp);
+
+		if (out_fp != ys_fp && quad_list->arr[i].op == EPILOG_Q) {
+			fclose(out_fp);
+			peephole_optimize(func_code, ys_fp);
+			free(func_code);
+			func_code = NULL;
+			out_fp = ys_fp;
+		}
 	}
 
 	/* 
@@ -102,8 +135,8 @@ int create_ys(char * file_name) {
 	 */
 	fprintf(ys_fp,"STRING_SECTION:\n");
 	for(int i = 0; i < quad_list->count; i++) {
-		if (quad_list->arr[i]->op == STRING_Q)
-			translate_string(ys_fp, quad_list->arr[i]);
+		if (quad_list->arr[i].op == STRING_Q)
+			translate_string(ys_fp, &quad_list->arr[i]);
 	}
 
 	/* 
@@ -112,7 +145,10 @@ int create_ys(char * file_name) {
 	fprintf(ys_fp, "\n\n");
 	fclose(ys_fp);
 
-	printf("\n----- PRINTED YS FILE %s ----- \n",file_name);
+	free(fused_compares);
+	fused_compares = NULL;
+
+	TRACE(VERBOSE_PHASES, "\n----- PRINTED YS FILE %s ----- \n",file_name);
 	return 0;
 }
 
@@ -124,112 +160,137 @@ void print_code(quad * to_translate, FILE * ys_file_ptr) {
 		case ADD_Q:
 			print_nop_comment(ys_file_ptr,"add",to_translate->number);
 
-			get_source_value(ys_file_ptr, to_translate->args[1], EAX_R);
-			get_source_value(ys_file_ptr, to_translate->args[2], EBX_R);
+			if (to_translate->args[2].type == INT_LITERAL_Q_ARG) {
+				add_immediate(ys_file_ptr, &to_translate->args[0], &to_translate->args[1], to_translate->args[2].int_literal);
+				break;
+			}
+			if (to_translate->args[1].type == INT_LITERAL_Q_ARG) {
+				add_immediate(ys_file_ptr, &to_translate->args[0], &to_translate->args[2], to_translate->args[1].int_literal);
+				break;
+			}
+
+			get_source_value(ys_file_ptr, &to_translate->args[1], EAX_R);
+			get_source_value(ys_file_ptr, &to_translate->args[2], EBX_R);
 			fprintf(ys_file_ptr, "\taddl %%ebx, %%eax\n");			
-			get_dest_value(ys_file_ptr,EAX_R,to_translate->args[0]);
+			get_dest_value(ys_file_ptr,EAX_R,&to_translate->args[0]);
 			break;
 
 		case SUB_Q:
 			print_nop_comment(ys_file_ptr,"subtract",to_translate->number);
 
-			get_source_value(ys_file_ptr, to_translate->args[1], EAX_R);
-			get_source_value(ys_file_ptr, to_translate->args[2], EBX_R);
+			if (to_translate->args[2].type == INT_LITERAL_Q_ARG) {
+				add_immediate(ys_file_ptr, &to_translate->args[0], &to_translate->args[1],
+					(int)(0u - (unsigned)to_translate->args[2].int_literal));
+				break;
+			}
+
+			get_source_value(ys_file_ptr, &to_translate->args[1], EAX_R);
+			get_source_value(ys_file_ptr, &to_translate->args[2], EBX_R);
 			fprintf(ys_file_ptr, "\tsubl %%ebx, %%eax\n");
-			get_dest_value(ys_file_ptr,EAX_R,to_translate->args[0]);
+			get_dest_value(ys_file_ptr,EAX_R,&to_translate->args[0]);
 			break;
 
 		case MUL_Q:
 			print_nop_comment(ys_file_ptr,"multiply",to_translate->number);
 
-			get_source_value(ys_file_ptr, to_translate->args[1], EAX_R);
-			get_source_value(ys_file_ptr, to_translate->args[2], EBX_R);
+			/* by a power of two: a shift */
+			if (power_of_two(&to_translate->args[2]) >= 0 || power_of_two(&to_translate->args[1]) >= 0) {
+				int shift_arg = (power_of_two(&to_translate->args[2]) >= 0) ? 2 : 1;
+				int shift = power_of_two(&to_translate->args[shift_arg]);
+				get_source_value(ys_file_ptr, &to_translate->args[3 - shift_arg], EAX_R);
+				if (shift > 0)
+					fprintf(ys_file_ptr, "\tshll $%d, %%eax\n", shift);
+				get_dest_value(ys_file_ptr,EAX_R,&to_translate->args[0]);
+				break;
+			}
+
+			get_source_value(ys_file_ptr, &to_translate->args[1], EAX_R);
+			get_source_value(ys_file_ptr, &to_translate->args[2], EBX_R);
 			fprintf(ys_file_ptr, "\tmull %%ebx, %%eax\n");
-			get_dest_value(ys_file_ptr,EAX_R,to_translate->args[0]);		
+			get_dest_value(ys_file_ptr,EAX_R,&to_translate->args[0]);		
 			break;
 
 		case DIV_Q:
 			print_nop_comment(ys_file_ptr,"divide",to_translate->number);
 
-			get_source_value(ys_file_ptr, to_translate->args[1], EAX_R);
-			get_source_value(ys_file_ptr, to_translate->args[2], EBX_R);
+			get_source_value(ys_file_ptr, &to_translate->args[1], EAX_R);
+			get_source_value(ys_file_ptr, &to_translate->args[2], EBX_R);
 			fprintf(ys_file_ptr, "\tdivl %%ebx, %%eax\n");
-			get_dest_value(ys_file_ptr,EAX_R,to_translate->args[0]);
+			get_dest_value(ys_file_ptr,EAX_R,&to_translate->args[0]);
 			break;
 
 		case MOD_Q:
 			print_nop_comment(ys_file_ptr,"mod",to_translate->number);
 
-			get_source_value(ys_file_ptr, to_translate->args[1], EAX_R);
-			get_source_value(ys_file_ptr, to_translate->args[2], EBX_R);
+			get_source_value(ys_file_ptr, &to_translate->args[1], EAX_R);
+			get_source_value(ys_file_ptr, &to_translate->args[2], EBX_R);
 			fprintf(ys_file_ptr, "\tmodl %%ebx, %%eax\n");
-			get_dest_value(ys_file_ptr,EAX_R,to_translate->args[0]);
+			get_dest_value(ys_file_ptr,EAX_R,&to_translate->args[0]);
 			break;
 
 		case PRE_INC_Q:
 			print_nop_comment(ys_file_ptr,"pre-increment",to_translate->number);
 
-			get_source_value(ys_file_ptr, to_translate->args[1], EAX_R);
-			get_source_value(ys_file_ptr, to_translate->args[2], EBX_R);
+			get_source_value(ys_file_ptr, &to_translate->args[1], EAX_R);
+			get_source_value(ys_file_ptr, &to_translate->args[2], EBX_R);
 			fprintf(ys_file_ptr, "\taddl %%ebx, %%eax\n");
 			// Update variable
 			// Return updated return value
 
-			get_dest_value(ys_file_ptr,EAX_R,to_translate->args[1]);
-			get_dest_value(ys_file_ptr,EAX_R,to_translate->args[0]);
+			get_dest_value(ys_file_ptr,EAX_R,&to_translate->args[1]);
+			get_dest_value(ys_file_ptr,EAX_R,&to_translate->args[0]);
 			break;
 
 		case PRE_DEC_Q:
 			print_nop_comment(ys_file_ptr,"pre-decrement",to_translate->number);
 
-			get_source_value(ys_file_ptr, to_translate->args[1], EAX_R);
-			get_source_value(ys_file_ptr, to_translate->args[2], EBX_R);
+			get_source_value(ys_file_ptr, &to_translate->args[1], EAX_R);
+			get_source_value(ys_file_ptr, &to_translate->args[2], EBX_R);
 			fprintf(ys_file_ptr, "\tsubl %%ebx, %%eax\n");
 			// Update variable
 			// Return updated return value
 
-			get_dest_value(ys_file_ptr,EAX_R,to_translate->args[1]);
-			get_dest_value(ys_file_ptr,EAX_R,to_translate->args[0]);			
+			get_dest_value(ys_file_ptr,EAX_R,&to_translate->args[1]);
+			get_dest_value(ys_file_ptr,EAX_R,&to_translate->args[0]);			
 			break;
 
 		case POST_INC_Q:
 			print_nop_comment(ys_file_ptr,"post-increment",to_translate->number);
 
-			get_source_value(ys_file_ptr,to_translate->args[1],EAX_R);
+			get_source_value(ys_file_ptr,&to_translate->args[1],EAX_R);
 			// Return variable's original value
-			get_dest_value(ys_file_ptr,EAX_R,to_translate->args[0]);
+			get_dest_value(ys_file_ptr,EAX_R,&to_translate->args[0]);
 
-			get_source_value(ys_file_ptr,to_translate->args[2],EBX_R);
+			get_source_value(ys_file_ptr,&to_translate->args[2],EBX_R);
 			fprintf(ys_file_ptr, "\taddl %%ebx, %%eax\n");
 			// Update variable
-			get_dest_value(ys_file_ptr, EAX_R,to_translate->args[1]);
+			get_dest_value(ys_file_ptr, EAX_R,&to_translate->args[1]);
 			break;
 
 		case POST_DEC_Q:
 			print_nop_comment(ys_file_ptr,"post-decrement",to_translate->number);
 
-			get_source_value(ys_file_ptr,to_translate->args[1],EAX_R);
+			get_source_value(ys_file_ptr,&to_translate->args[1],EAX_R);
 			// Return variable's original value
-			get_dest_value(ys_file_ptr,EAX_R,to_translate->args[0]);
+			get_dest_value(ys_file_ptr,EAX_R,&to_translate->args[0]);
 
-			get_source_value(ys_file_ptr,to_translate->args[2],EBX_R);
+			get_source_value(ys_file_ptr,&to_translate->args[2],EBX_R);
 			fprintf(ys_file_ptr, "\tsubl %%ebx, %%eax\n");
 			// Update variable
-			get_dest_value(ys_file_ptr, EAX_R,to_translate->args[1]);
+			get_dest_value(ys_file_ptr, EAX_R,&to_translate->args[1]);
 			break;
 
 		case NOT_Q:
 			print_nop_comment(ys_file_ptr,"not",to_translate->number);
 
-			get_source_value(ys_file_ptr,to_translate->args[1],EAX_R);
-			fprintf(ys_file_ptr, "\tirmovl $0, %%ebx\n");
-			fprintf(ys_file_ptr, "\tsubl %%ebx, %%eax\n");
+			get_source_value(ys_file_ptr,&to_translate->args[1],EAX_R);
+			fprintf(ys_file_ptr, "\tandl %%eax, %%eax\n");
 
 			fprintf(ys_file_ptr, "\tirmovl $1, %%ebx\n");
 			fprintf(ys_file_ptr, "\tcmove %%ebx, %%eax\n");
 			fprintf(ys_file_ptr, "\tirmovl $0, %%ebx\n");
 			fprintf(ys_file_ptr, "\tcmovne %%ebx, %%eax\n");
-			get_dest_value(ys_file_ptr,EAX_R,to_translate->args[0]);
+			get_dest_value(ys_file_ptr,EAX_R,&to_translate->args[0]);
 			break;
 
 		case NEG_Q:
@@ -237,17 +298,22 @@ void print_code(quad * to_translate, FILE * ys_file_ptr) {
 
 			// Negative of an integer n = 0 - n
 			// i.e. 0 - 1 = -1, 0 - (-1) = 1
-			fprintf(ys_file_ptr, "\tmrmovl $0, %%eax\n");
-			get_source_value(ys_file_ptr,to_translate->args[0],EBX_R);
+			fprintf(ys_file_ptr, "\tirmovl $0, %%eax\n");
+			get_source_value(ys_file_ptr,&to_translate->args[1],EBX_R);
 			fprintf(ys_file_ptr, "\tsubl %%ebx, %%eax\n");
-			get_dest_value(ys_file_ptr,EAX_R,to_translate->args[0]);
+			get_dest_value(ys_file_ptr,EAX_R,&to_translate->args[0]);
 			break;
 
 		case ASSIGN_Q:
 			print_nop_comment(ys_file_ptr, "assignment", to_translate->number);
 
-			get_source_value(ys_file_ptr,to_translate->args[1],EAX_R);
-			get_dest_value(ys_file_ptr,EAX_R,to_translate->args[0]);
+			if (get_arg_register(&to_translate->args[0]) != NO_REG && to_translate->args[0].type != SYMBOL_ARR_Q_ARG) {
+				/* destination lives in a register, so load straight into it */
+				get_source_value(ys_file_ptr,&to_translate->args[1],get_arg_register(&to_translate->args[0]));
+			} else {
+				get_source_value(ys_file_ptr,&to_translate->args[1],EAX_R);
+				get_dest_value(ys_file_ptr,EAX_R,&to_translate->args[0]);
+			}
 			break;
 
 		case LT_Q:
@@ -256,7 +322,10 @@ void print_code(quad * to_translate, FILE * ys_file_ptr) {
 			{
 				print_nop_comment(ys_file_ptr, "less than comparison", to_translate->number);
 				condition = LT_C;
-				comp_sub(to_translate, ys_file_ptr);
+				if (is_fused_compare(to_translate->number))
+					comp_branch(to_translate, &quad_list->arr[to_translate->number + 1], ys_file_ptr);
+				else
+					comp_sub(to_translate, ys_file_ptr);
 				break;
 			}
 
@@ -266,7 +335,10 @@ void print_code(quad * to_translate, FILE * ys_file_ptr) {
 			{
 				print_nop_comment(ys_file_ptr, "greater than comparison", to_translate->number);
 				condition = GT_C;
-				comp_sub(to_translate, ys_file_ptr);
+				if (is_fused_compare(to_translate->number))
+					comp_branch(to_translate, &quad_list->arr[to_translate->number + 1], ys_file_ptr);
+				else
+					comp_sub(to_translate, ys_file_ptr);
 				break;
 			}
 
@@ -276,7 +348,10 @@ void print_code(quad * to_translate, FILE * ys_file_ptr) {
 			{
 				print_nop_comment(ys_file_ptr, "less than or equal to comparison", to_translate->number);
 				condition = LTE_C;
-				comp_sub(to_translate, ys_file_ptr);
+				if (is_fused_compare(to_translate->number))
+					comp_branch(to_translate, &quad_list->arr[to_translate->number + 1], ys_file_ptr);
+				else
+					comp_sub(to_translate, ys_file_ptr);
 				break;
 			}
 
@@ -286,7 +361,10 @@ void print_code(quad * to_translate, FILE * ys_file_ptr) {
 			{
 				print_nop_comment(ys_file_ptr, "greater than or equal to comparison", to_translate->number);
 				condition = GTE_C;
-				comp_sub(to_translate, ys_file_ptr);
+				if (is_fused_compare(to_translate->number))
+					comp_branch(to_translate, &quad_list->arr[to_translate->number + 1], ys_file_ptr);
+				else
+					comp_sub(to_translate, ys_file_ptr);
 				break;
 			}
 
@@ -296,7 +374,10 @@ void print_code(quad * to_translate, FILE * ys_file_ptr) {
 			{
 				print_nop_comment(ys_file_ptr, "not equal to comparison", to_translate->number);
 				condition = NE_C;
-				comp_sub(to_translate, ys_file_ptr);
+				if (is_fused_compare(to_translate->number))
+					comp_branch(to_translate, &quad_list->arr[to_translate->number + 1], ys_file_ptr);
+				else
+					comp_sub(to_translate, ys_file_ptr);
 				break;
 			}
 
@@ -306,19 +387,24 @@ void print_code(quad * to_translate, FILE * ys_file_ptr) {
 			{
 				print_nop_comment(ys_file_ptr, "equal to comparison", to_translate->number);
 				condition = EQ_C;
-				comp_sub(to_translate, ys_file_ptr);
+				if (is_fused_compare(to_translate->number))
+					comp_branch(to_translate, &quad_list->arr[to_translate->number + 1], ys_file_ptr);
+				else
+					comp_sub(to_translate, ys_file_ptr);
 				break;
 			}
 
 		case IFFALSE_Q:
+			/* already emitted along with the comparison before it */
+			if (is_fused_compare(to_translate->number - 1))
+				break;
+
 			print_nop_comment(ys_file_ptr,"If False",to_translate->number);
 			{
-				char * label = to_translate->args[1]->label;
+				char * label = to_translate->args[1].label;
 
 				// Just check if temp is 0
-				fprintf(ys_file_ptr, "\tirmovl $0, %%eax\n");
-				get_source_value(ys_file_ptr,to_translate->args[0],EBX_R);
-				fprintf(ys_file_ptr, "\tsubl %%ebx, %%eax\n");
+				test_zero(ys_file_ptr, &to_translate->args[0]);
 				fprintf(ys_file_ptr, "\tje %s\n", label);
 
 				condition = NULL_C;
@@ -326,28 +412,47 @@ void print_code(quad * to_translate, FILE * ys_file_ptr) {
 				break;
 			}
 
+		case IFTRUE_Q:
+			/* already emitted along with the comparison before it */
+			if (is_fused_compare(to_translate->number - 1))
+				break;
+
+			print_nop_comment(ys_file_ptr,"If True",to_translate->number);
+			{
+				char * label = to_translate->args[1].label;
+
+				// Just check if temp is not 0
+				test_zero(ys_file_ptr, &to_translate->args[0]);
+				fprintf(ys_file_ptr, "\tjne %s\n", label);
+
+				condition = NULL_C;
+
+				break;
+			}
+
 		case GOTO_Q:
 			print_nop_comment(ys_file_ptr,"goto",to_translate->number);
 
 			//char * jmp_label = (to_translate->args[0]);
-			fprintf(ys_file_ptr,"\tjmp %s\n",to_translate->args[0]->label); 	
+			fprintf(ys_file_ptr,"\tjmp %s\n",to_translate->args[0].label); 	
 			break;
 
 		case PRINT_Q:
 			print_nop_comment(ys_file_ptr, "printing", to_translate->number);		
-			switch(to_translate->args[0]->type){
+			switch(to_translate->args[0].type){
 
 				/* printing a string */
 				case LABEL_Q_ARG: 	
-					fprintf(ys_file_ptr, "\tirmovl %s, %%eax\n",to_translate->args[0]->label);
+					fprintf(ys_file_ptr, "\tirmovl %s, %%eax\n",to_translate->args[0].label);
 					fprintf(ys_file_ptr, "\trmmovl %%eax, 0x%x\n",DSTR_reg);
 					break;
 
 				/* printing a value */
+				case INT_LITERAL_Q_ARG:
 				case SYMBOL_ARR_Q_ARG:
 				case SYMBOL_VAR_Q_ARG:
 				case TEMP_VAR_Q_ARG: 
-					get_source_value(ys_file_ptr,to_translate->args[0], EAX_R);
+					get_source_value(ys_file_ptr,&to_translate->args[0], EAX_R);
 					fprintf(ys_file_ptr,"\trmmovl %%eax, 0x%x\n",DHXR_reg);	
 					break;
 
@@ -366,45 +471,52 @@ void print_code(quad * to_translate, FILE * ys_file_ptr) {
 			print_nop_comment(ys_file_ptr, "reading", to_translate->number);
 			// Right now only reading integers
 			fprintf(ys_file_ptr, "\tmrmovl 0x%x, %%eax\n", KHXR_reg);
-			get_dest_value(ys_file_ptr,EAX_R,to_translate->args[0]);
+			get_dest_value(ys_file_ptr,EAX_R,&to_translate->args[0]);
 			break;
 
 		case SIZEOF_Q:
 			print_nop_comment(ys_file_ptr,"sizeof", to_translate->number);
 
 			// get size based on call
-			if (to_translate->args[1]->type == SYMBOL_ARR_Q_ARG && 			// is an array
-				to_translate->args[1]->int_literal != PASS_ARR_POINTER) {	// and are getting sizeof an element in array
-				fprintf(ys_file_ptr, "\tirmovl $%d, %%eax\n", TYPE_SIZE(to_translate->args[1]->symnode->s.v.type));
+			if (to_translate->args[1].type == SYMBOL_ARR_Q_ARG && 			// is an array
+				to_translate->args[1].int_literal != PASS_ARR_POINTER) {	// and are getting sizeof an element in array
+				fprintf(ys_file_ptr, "\tirmovl $%d, %%eax\n", TYPE_SIZE(to_translate->args[1].symnode->s.v.type));
 
 			} else {														// else accessing singular / array
-				fprintf(ys_file_ptr, "\tirmovl $%d, %%eax\n", to_translate->args[1]->symnode->s.v.byte_size);
+				fprintf(ys_file_ptr, "\tirmovl $%d, %%eax\n", to_translate->args[1].symnode->s.v.byte_size);
 			}
 
 			// put size evaluation in destination temp
-			get_dest_value(ys_file_ptr, EAX_R, to_translate->args[0]);
+			get_dest_value(ys_file_ptr, EAX_R, &to_translate->args[0]);
 			break;
 
 		case PROLOG_Q:
 			{
 				print_nop_comment(ys_file_ptr, "function prolog", to_translate->number);
-				symnode_t * func_sym = find_in_top_symboltable(symtab, to_translate->args[0]->label);
+				symnode_t * func_sym = find_in_top_symboltable(symtab, to_translate->args[0].label);
 
-				fprintf(ys_file_ptr, "%s:\n",to_translate->args[0]->label);
+				current_function = func_sym;
+
+				fprintf(ys_file_ptr, "%s:\n",to_translate->args[0].label);
 				fprintf(ys_file_ptr, "\tpushl %%ebp\n");			
 				fprintf(ys_file_ptr, "\trrmovl %%esp, %%ebp\n"); 								// move esp to ebp
 				/* 
 				 * --- set esp to bottom of local and temp space --- 
 				 * --- esp should be set to symnode->s.f.stk_offset for function's symbol ---
 				 */
-				fprintf(ys_file_ptr, "\tirmovl $%d, %%eax\n",func_sym->s.f.stk_offset + 4); 	// point at lowest local
-				fprintf(ys_file_ptr, "\taddl %%eax, %%esp\n");				
+				fprintf(ys_file_ptr, "\tirmovl $%d, %%eax\n",func_sym->s.f.stk_offset); 		// point at lowest local
+				fprintf(ys_file_ptr, "\taddl %%eax, %%esp\n");
+
+				/* save caller's registers we're about to use and pull in enregistered parameters */
+				save_registers(ys_file_ptr, func_sym);
+				load_register_parameters(ys_file_ptr, func_sym);
 			}
 			break;
 
 		case EPILOG_Q:
 			print_nop_comment(ys_file_ptr, "function epilog", to_translate->number);
 
+			restore_registers(ys_file_ptr, find_in_top_symboltable(symtab, to_translate->args[0].label));
 			fprintf(ys_file_ptr, "\trrmovl %%ebp, %%esp\n");
 			fprintf(ys_file_ptr, "\tpopl %%ebp\n"); 											// return to old frame pointer
 			fprintf(ys_file_ptr, "\tret\n");
@@ -412,21 +524,19 @@ void print_code(quad * to_translate, FILE * ys_file_ptr) {
 
 		case PRECALL_Q:
 			print_nop_comment(ys_file_ptr, "function precall", to_translate->number);
-			fprintf(ys_file_ptr, "\tcall %s\n",to_translate->args[0]->label); 					// pushes ret addr on stack				
+			fprintf(ys_file_ptr, "\tcall %s\n",to_translate->args[0].label); 					// pushes ret addr on stack				
 			break;
 
 		case POSTRET_Q:
 			{
 				print_nop_comment(ys_file_ptr, "post return", to_translate->number);
 
-				/* make a post return label */
-				symnode_t * func_sym = find_in_top_symboltable(symtab, to_translate->args[0]->label);	
-
 				/* 
 				 * --- use control link to get back to caller frame ---
 				 * --- manhandle stack pointer to point back at bottom of temps and locals ---
+				 * --- (of the calling function -- the callee's frame is already gone) ---
 				 */	
-				fprintf(ys_file_ptr, "\tirmovl $%d, %%ebx\n",func_sym->s.f.stk_offset + 4); 	// %ebx b/c return lives in %eax
+				fprintf(ys_file_ptr, "\tirmovl $%d, %%ebx\n",current_function->s.f.stk_offset); 	// %ebx b/c return lives in %eax
 				fprintf(ys_file_ptr, "\taddl %%ebp, %%ebx\n");		
 				fprintf(ys_file_ptr, "\trrmovl %%ebx, %%esp\n");						
 			}
@@ -435,22 +545,22 @@ void print_code(quad * to_translate, FILE * ys_file_ptr) {
 		case PARAM_Q:
 
 			print_nop_comment(ys_file_ptr,"parameter",to_translate->number);	 	
-			if (to_translate->args[0]->type == SYMBOL_ARR_Q_ARG && to_translate->args[0]->int_literal == PASS_ARR_POINTER) {
+			if (to_translate->args[0].type == SYMBOL_ARR_Q_ARG && to_translate->args[0].int_literal == PASS_ARR_POINTER) {
 				/* passing array pointer */
 
 				/* if global? */ 
-				if (to_translate->args[0]->symnode->s.v.specie == GLOBAL_VAR) {
+				if (to_translate->args[0].symnode->s.v.specie == GLOBAL_VAR) {
 					/* return absolute address */
-					fprintf(ys_file_ptr,"\tirmovl 0x%x, %%eax\n",to_translate->args[0]->symnode->s.v.offset_of_frame_pointer);
+					fprintf(ys_file_ptr,"\tirmovl 0x%x, %%eax\n",to_translate->args[0].symnode->s.v.offset_of_frame_pointer);
 				} else {
 					/* calculate absolute address by adding offset (in bytes) of ebp */
-					fprintf(ys_file_ptr,"\tirmovl $%d, %%eax\n", to_translate->args[0]->symnode->s.v.offset_of_frame_pointer);
+					fprintf(ys_file_ptr,"\tirmovl $%d, %%eax\n", to_translate->args[0].symnode->s.v.offset_of_frame_pointer);
 					fprintf(ys_file_ptr,"\taddl %%ebp, %%eax\n");
 				}
 
 			} else {
 				/* passing single parameter */
-				get_source_value(ys_file_ptr,to_translate->args[0],EAX_R);
+				get_source_value(ys_file_ptr,&to_translate->args[0],EAX_R);
 			}
 
 			fprintf(ys_file_ptr, "\tpushl %%eax\n");			
@@ -460,16 +570,16 @@ void print_code(quad * to_translate, FILE * ys_file_ptr) {
 			print_nop_comment(ys_file_ptr, "return statement", to_translate->number);
 
 			// void return
-			if (to_translate->args[0] == NULL) {
+			if (to_translate->args[0].type == NULL_ARG) {
 				fprintf(ys_file_ptr, "\tirmovl $0, %%eax\n"); 	// clear return value for void
 
 			// constant return
-			} else if (to_translate->args[0]->type == INT_LITERAL_Q_ARG) {
-				get_source_value(ys_file_ptr,to_translate->args[0],EAX_R);
+			} else if (to_translate->args[0].type == INT_LITERAL_Q_ARG) {
+				get_source_value(ys_file_ptr,&to_translate->args[0],EAX_R);
 
 			// variable return
 			} else {
-				get_source_value(ys_file_ptr,to_translate->args[0],EAX_R);
+				get_source_value(ys_file_ptr,&to_translate->args[0],EAX_R);
 			}
 			break;
 
@@ -478,7 +588,7 @@ void print_code(quad * to_translate, FILE * ys_file_ptr) {
 			break;
 
 		case LABEL_Q:			
-			fprintf(ys_file_ptr,"%s:\n",to_translate->args[0]->label);
+			fprintf(ys_file_ptr,"%s:\n",to_translate->args[0].label);
 			break;
 
 		default:
@@ -486,26 +596,95 @@ void print_code(quad * to_translate, FILE * ys_file_ptr) {
 	}
 }
 
+int power_of_two(quad_arg * arg) {
+	if (arg->type != INT_LITERAL_Q_ARG || arg->int_literal <= 0 || (arg->int_literal & (arg->int_literal - 1)))
+		return -1;
+
+	int shift = 0;
+	while ((1 << shift) != arg->int_literal)
+		shift++;
+	return shift;
+}
+
+void add_immediate(FILE * fp, quad_arg * dest, quad_arg * value, int c) {
+	int reg = NO_REG;
+	if (dest->type == TEMP_VAR_Q_ARG || dest->type == SYMBOL_VAR_Q_ARG)
+		reg = get_arg_register(dest);
+	if (reg == NO_REG)
+		reg = EAX_R;
+
+	get_source_value(fp, value, reg);
+	if (iaddl_enabled) {
+		fprintf(fp, "\tiaddl $%d, %s\n", c, REGISTER_STR(reg));
+	} else {
+		fprintf(fp, "\tirmovl $%d, %%ebx\n", c);
+		fprintf(fp, "\taddl %%ebx, %s\n", REGISTER_STR(reg));
+	}
+
+	if (reg == EAX_R)
+		get_dest_value(fp, EAX_R, dest);
+}
+
+void element_operand(FILE * fp, quad_arg * arr, char * operand) {
+	/* the temp already holds the element's address */
+	if (arr->int_literal == ELEMENT_POINTER) {
+		if (get_arg_register(arr) != NO_REG) {
+			snprintf(operand, MAX_ARG_LEN, "(%s)", REGISTER_STR(get_arg_register(arr)));
+		} else {
+			fprintf(fp,"\tmrmovl $%d(%%ebp), %%edi\n", ((symnode_t *)arr->temp->temp_symnode)->s.v.offset_of_frame_pointer);
+			snprintf(operand, MAX_ARG_LEN, "(%%edi)");
+		}
+		return;
+	}
+
+	/* index * 4 */
+	if (get_arg_register(arr) != NO_REG)
+		move_register(fp, get_arg_register(arr), EDI_R);
+	else
+		fprintf(fp,"\tmrmovl $%d(%%ebp), %%edi\n", ((symnode_t *)arr->temp->temp_symnode)->s.v.offset_of_frame_pointer);
+	fprintf(fp,"\tshll $2, %%edi\n");
+
+	if (arr->symnode->s.v.specie == GLOBAL_VAR) {						// absolute address of the array
+		snprintf(operand, MAX_ARG_LEN, "0x%x(%%edi)", arr->symnode->s.v.offset_of_frame_pointer);
+
+	} else if (arr->symnode->s.v.offset_of_frame_pointer > 0) {		// parameter holds the array's address
+		fprintf(fp,"\tmrmovl $%d(%%ebp), %%ebx\n", arr->symnode->s.v.offset_of_frame_pointer);
+		fprintf(fp,"\taddl %%ebx, %%edi\n");
+		snprintf(operand, MAX_ARG_LEN, "(%%edi)");
+
+	} else {															// array on the frame
+		fprintf(fp,"\taddl %%ebp, %%edi\n");
+		snprintf(operand, MAX_ARG_LEN, "$%d(%%edi)", arr->symnode->s.v.offset_of_frame_pointer);
+	}
+}
+
 int get_source_value(FILE * fp, quad_arg * src, my_register_t dest) {
 	if (!src || !fp)
 		return 1;
 
-	printf("getting source\n");
+	TRACE(VERBOSE_OPERANDS, "getting source\n");
 	switch(src->type) {
 
 		case INT_LITERAL_Q_ARG:
-			printf("constant %d\n",src->int_literal);		
+			TRACE(VERBOSE_OPERANDS, "constant %d\n",src->int_literal);		
 			fprintf(fp, "\tirmovl 0x%x, %s\n",src->int_literal,REGISTER_STR(dest));
 			break;
 
 		case TEMP_VAR_Q_ARG:
-			printf("temp variable symbol %s\n", ((symnode_t *) src->temp->temp_symnode)->name);
-			fprintf(fp, "\tmrmovl $%d(%%ebp), %s\n", ((symnode_t *) src->temp->temp_symnode)->s.v.offset_of_frame_pointer, REGISTER_STR(dest));
+			TRACE(VERBOSE_OPERANDS, "temp variable %d\n", src->temp->id);
+			if (get_arg_register(src) != NO_REG)
+				move_register(fp, get_arg_register(src), dest);
+			else
+				fprintf(fp, "\tmrmovl $%d(%%ebp), %s\n", ((symnode_t *) src->temp->temp_symnode)->s.v.offset_of_frame_pointer, REGISTER_STR(dest));
 			break;
 
 		case SYMBOL_VAR_Q_ARG:
-			printf("variable symbol %s\n",src->symnode->name);
-			if (src->symnode->s.v.specie == GLOBAL_VAR) {
+			TRACE(VERBOSE_OPERANDS, "variable symbol %s\n",src->symnode->name);
+			if (get_arg_register(src) != NO_REG) {
+				/* lives in a register */
+				move_register(fp, get_arg_register(src), dest);
+
+			} else if (src->symnode->s.v.specie == GLOBAL_VAR) {
 				/* return absolute address */
 				fprintf(fp,"\tmrmovl 0x%x, %s\n",src->symnode->s.v.offset_of_frame_pointer, REGISTER_STR(dest));
 
@@ -516,10 +695,17 @@ int get_source_value(FILE * fp, quad_arg * src, my_register_t dest) {
 			break;			
 
 		case SYMBOL_ARR_Q_ARG: 
-			printf("array symbol %s, offset %d\n",src->symnode->name, src->temp->id);
+			TRACE(VERBOSE_OPERANDS, "array symbol %s, offset %d\n",src->symnode->name, src->temp ? src->temp->id : -1);	// a passed array has no index temp
 			{
+				if (src->int_literal != PASS_ARR_POINTER) {
+					char operand[MAX_ARG_LEN];
+					element_operand(fp, src, operand);
+					fprintf(fp,"\tmrmovl %s, %s\n", operand, REGISTER_STR(dest));
+					break;
+				}
+
 				/*
-				 * get array head
+				 * pass array pointer
 				 */
 				if (src->symnode->s.v.specie == GLOBAL_VAR)	{					// get absolute address of pointer if global
 					fprintf(fp,"\tirmovl 0x%x, %%edi\n",src->symnode->s.v.offset_of_frame_pointer);
@@ -532,30 +718,17 @@ int get_source_value(FILE * fp, quad_arg * src, my_register_t dest) {
 					fprintf(fp,"\tirmovl $%d, %%ebx\n",src->symnode->s.v.offset_of_frame_pointer);
 					fprintf(fp,"\taddl %%ebx, %%edi\n");
 				}
-
-				/*
-				 * calculate offset
-				 */
-				if (src->int_literal != PASS_ARR_POINTER) {
-					/* get temp that holds index */
-					fprintf(fp,"\tmrmovl $%d(%%ebp), %%ebx\n", ((symnode_t *)src->temp->temp_symnode)->s.v.offset_of_frame_pointer);
-					fprintf(fp,"\tshll $2, %%ebx\n");
-					fprintf(fp,"\taddl %%ebx, %%edi\n");
-					fprintf(fp,"\tmrmovl (%%edi), %s\n", REGISTER_STR(dest));					
-				} else {
-					/* pass array pointer */
-					fprintf(fp,"\trrmovl %%edi, %s\n", REGISTER_STR(dest));
-				}					
+				fprintf(fp,"\trrmovl %%edi, %s\n", REGISTER_STR(dest));
 			}
 			break;
 
 		case LABEL_Q_ARG:
-			printf("label %s\n",src->label);
+			TRACE(VERBOSE_OPERANDS, "label %s\n",src->label);
 			fprintf(fp,"%s",src->label);
 			break;
 
 		case RETURN_Q_ARG:
-			printf("return arg\n");
+			TRACE(VERBOSE_OPERANDS, "return arg\n");
 			if (dest != EAX_R) 		// RETURN already lives in %eax
 				fprintf(fp,"\trrmovl %%eax, %s\n",REGISTER_STR(dest));
 			break;
@@ -571,16 +744,23 @@ int get_dest_value(FILE * fp, my_register_t src, quad_arg * dest) {
 	if (!dest || !fp)
 		return 1;
 
-	printf("getting destination value\n");
+	TRACE(VERBOSE_OPERANDS, "getting destination value\n");
 	switch(dest->type){
 		case TEMP_VAR_Q_ARG:
-			printf("temp variable symbol %s\n", ((symnode_t *) dest->temp->temp_symnode)->name);
-			fprintf(fp,"\trmmovl %s, $%d(%%ebp)\n",REGISTER_STR(src), ((symnode_t *)dest->temp->temp_symnode)->s.v.offset_of_frame_pointer);
+			TRACE(VERBOSE_OPERANDS, "temp variable %d\n", dest->temp->id);
+			if (get_arg_register(dest) != NO_REG)
+				move_register(fp, src, get_arg_register(dest));
+			else
+				fprintf(fp,"\trmmovl %s, $%d(%%ebp)\n",REGISTER_STR(src), ((symnode_t *)dest->temp->temp_symnode)->s.v.offset_of_frame_pointer);
 			break;
 
 		case SYMBOL_VAR_Q_ARG:
-			printf("variable symbol\n");
-			if (dest->symnode->s.v.specie == GLOBAL_VAR) {
+			TRACE(VERBOSE_OPERANDS, "variable symbol\n");
+			if (get_arg_register(dest) != NO_REG) {
+				/* lives in a register */
+				move_register(fp, src, get_arg_register(dest));
+
+			} else if (dest->symnode->s.v.specie == GLOBAL_VAR) {
 				/* return absolute address */
 				fprintf(fp,"\trmmovl %s, 0x%x\n",REGISTER_STR(src), dest->symnode->s.v.offset_of_frame_pointer);
 
@@ -592,41 +772,23 @@ int get_dest_value(FILE * fp, my_register_t src, quad_arg * dest) {
 
 		case SYMBOL_ARR_Q_ARG:
 
-			/* 
-			 * get array pointer into %edi 
-			 */
-			if (dest->symnode->s.v.specie == GLOBAL_VAR)	{					// get absolute address of pointer if global
-				fprintf(fp,"\tirmovl 0x%x, %%edi\n", dest->symnode->s.v.offset_of_frame_pointer);
-
-			} else if (dest->symnode->s.v.offset_of_frame_pointer > 0) {		// need get address out of memory for parameter
-				fprintf(fp,"\tmrmovl $%d(%%ebp), %%edi\n", dest->symnode->s.v.offset_of_frame_pointer);
-
-			} else {															// else get relative address based addition to FP 
-				fprintf(fp,"\trrmovl %%ebp, %%edi\n");
-				fprintf(fp,"\tirmovl $%d, %%ebx\n", dest->symnode->s.v.offset_of_frame_pointer);
-				fprintf(fp,"\taddl %%ebx, %%edi\n");
-			}
-
-			/* 
-			 * calculate offset
+			/*
+			 * For how we work with arrays, can never actually change array head
 			 */
-			if (dest->int_literal != PASS_ARR_POINTER && dest->temp != NULL) {
-				/* get temp that holds index */
-				fprintf(fp,"\tmrmovl $%d(%%ebp), %%ebx\n",((symnode_t *) dest->temp->temp_symnode)->s.v.offset_of_frame_pointer);
-				fprintf(fp,"\tshll $2, %%ebx\n");
-				fprintf(fp,"\taddl %%ebx, %%edi\n");
-				fprintf(fp,"\trmmovl %s, (%%edi)\n", REGISTER_STR(src));					
-			} else {
-				/* 
-				 * For how we work with arrays, can never actually change array head
-				 */
+			if (dest->int_literal == PASS_ARR_POINTER || dest->temp == NULL) {
 				fprintf(stderr,"error during code generation: cannot assign new values to array headers\n");
 				exit(1);
 			}
+
+			{
+				char operand[MAX_ARG_LEN];
+				element_operand(fp, dest, operand);
+				fprintf(fp,"\trmmovl %s, %s\n", REGISTER_STR(src), operand);
+			}
 			break;
 
 		case RETURN_Q_ARG:
-			printf("return destination\n");
+			TRACE(VERBOSE_OPERANDS, "return destination\n");
 			fprintf(fp,"\trrmovl %s, %%eax\n",REGISTER_STR(src));
 			break;
 
@@ -639,9 +801,76 @@ int get_dest_value(FILE * fp, my_register_t src, quad_arg * dest) {
 	return 0;
 }
 
+/*
+ * sets condition codes for arg compared with 0 -- andl of a value with
+ * itself instead of loading a 0 and subtracting
+ */
+void test_zero(FILE * fp, quad_arg * arg) {
+	int reg = NO_REG;
+	if (arg->type == TEMP_VAR_Q_ARG || arg->type == SYMBOL_VAR_Q_ARG)
+		reg = get_arg_register(arg);
+
+	if (reg == NO_REG) {
+		get_source_value(fp, arg, EAX_R);
+		reg = EAX_R;
+	}
+	fprintf(fp, "\tandl %s, %s\n", REGISTER_STR(reg), REGISTER_STR(reg));
+}
+
+/*
+ * copies register src into register dest (nothing to do if they're the same)
+ */
+void move_register(FILE * fp, int src, int dest) {
+	if (src != dest)
+		fprintf(fp,"\trrmovl %s, %s\n", REGISTER_STR(src), REGISTER_STR(dest));
+}
+
+/*
+ * stores registers used by func into the save slots below its locals
+ */
+void save_registers(FILE * fp, symnode_t * func_sym) {
+	int offset = func_sym->s.f.reg_save_offset;
+	for (int r = EAX_R; r <= EDI_R; r++) {
+		if (func_sym->s.f.saved_regs & REG_BIT(r)) {
+			fprintf(fp,"\trmmovl %s, $%d(%%ebp)\n", REGISTER_STR(r), offset);
+			offset -= TYPE_SIZE(INT_TS);
+		}
+	}
+}
+
+/*
+ * reloads the caller's registers from the save slots
+ */
+void restore_registers(FILE * fp, symnode_t * func_sym) {
+	int offset = func_sym->s.f.reg_save_offset;
+	for (int r = EAX_R; r <= EDI_R; r++) {
+		if (func_sym->s.f.saved_regs & REG_BIT(r)) {
+			fprintf(fp,"\tmrmovl $%d(%%ebp), %s\n", offset, REGISTER_STR(r));
+			offset -= TYPE_SIZE(INT_TS);
+		}
+	}
+}
+
+/*
+ * moves parameters that were given a register out of the frame
+ */
+void load_register_parameters(FILE * fp, symnode_t * func_sym) {
+	symhashtable_t * func_scope = find_function_scope(symtab, func_sym);
+	if (!func_scope)
+		return;
+
+	symnode_t * sym;
+	for (int i = 0; i < func_scope->size; i++) {
+		for (sym = func_scope->table[i]; sym != NULL; sym = sym->next) {
+			if (sym->sym_type == VAR_SYM && sym->s.v.specie == PARAMETER_VAR && sym->s.v.reg != NO_REG)
+				fprintf(fp,"\tmrmovl $%d(%%ebp), %s\n", sym->s.v.offset_of_frame_pointer, REGISTER_STR(sym->s.v.reg));
+		}
+	}
+}
+
 void comp_sub(quad * to_translate, FILE * ys_file_ptr) {
-	get_source_value(ys_file_ptr,to_translate->args[1],EAX_R);
-	get_source_value(ys_file_ptr,to_translate->args[2],EBX_R);
+	get_source_value(ys_file_ptr,&to_translate->args[1],EAX_R);
+	get_source_value(ys_file_ptr,&to_translate->args[2],EBX_R);
 	fprintf(ys_file_ptr, "\tsubl %%ebx, %%eax\n");
 
 	switch (condition) {
@@ -685,7 +914,117 @@ void comp_sub(quad * to_translate, FILE * ys_file_ptr) {
 			break;
 	}
 
-	get_dest_value(ys_file_ptr, EAX_R, to_translate->args[0]);
+	get_dest_value(ys_file_ptr, EAX_R, &to_translate->args[0]);
+}
+
+/*
+ * comparison whose only use is the IFFALSE_Q / IFTRUE_Q right after it: subtract
+ * and take the (inverted for IFFALSE_Q) conditional jump instead of building a 0/1 temp
+ */
+void comp_branch(quad * to_translate, quad * branch, FILE * ys_file_ptr) {
+	get_source_value(ys_file_ptr,&to_translate->args[1],EAX_R);
+	get_source_value(ys_file_ptr,&to_translate->args[2],EBX_R);
+	fprintf(ys_file_ptr, "\tsubl %%ebx, %%eax\n");
+
+	int on_false = (branch->op == IFFALSE_Q);
+	char * jump;
+	switch (condition) {
+		case LT_C:
+			jump = on_false ? "jge" : "jl";
+			break;
+		case GT_C:
+			jump = on_false ? "jle" : "jg";
+			break;
+		case LTE_C:
+			jump = on_false ? "jg" : "jle";
+			break;
+		case GTE_C:
+			jump = on_false ? "jl" : "jge";
+			break;
+		case NE_C:
+			jump = on_false ? "je" : "jne";
+			break;
+		case EQ_C:
+			jump = on_false ? "jne" : "je";
+			break;
+		default:
+			fprintf(stderr,"cannot fuse comparison in quad %d -- no condition set\n",to_translate->number);
+			exit(1);
+	}
+
+	fprintf(ys_file_ptr, "\t%s %s\n", jump, branch->args[1].label);
+	condition = NULL_C;
+}
+
+static int is_compare_op(quad_op op) {
+	return op == LT_Q || op == GT_Q || op == LTE_Q || op == GTE_Q || op == NE_Q || op == EQ_Q;
+}
+
+static void count_temp_use(int * uses, int use_size, quad_arg * arg) {
+	if (!arg || !arg->temp)
+		return;
+	if (arg->type != TEMP_VAR_Q_ARG && arg->type != SYMBOL_ARR_Q_ARG)
+		return;
+	if (arg->temp->id < use_size)
+		uses[arg->temp->id]++;
+}
+
+void mark_fused_compares() {
+	free(fused_compares);
+	fused_compares = (char *)calloc(quad_list->count + 1, sizeof(char));
+	assert(fused_compares);
+	if (!fusion_enabled)
+		return;
+
+	for (int i = 0; i < quad_list->count; i++) {
+		if (quad_list->arr[i].op != PROLOG_Q)
+			continue;
+
+		int prolog = i;
+		while (i < quad_list->count && quad_list->arr[i].op != EPILOG_Q)
+			i++;
+		int epilog = i < quad_list->count ? i : quad_list->count - 1;
+
+		/* count references to every temp of the function */
+		int use_size = 0;
+		for (int q = prolog; q <= epilog; q++) {
+			for (int a = 0; a < QUAD_ARG_NUM; a++) {
+				quad_arg * arg = &quad_list->arr[q].args[a];
+				if (arg->temp && arg->temp->id >= use_size)
+					use_size = arg->temp->id + 1;
+			}
+		}
+
+		int * uses = (int *)calloc(use_size + 1, sizeof(int));
+		assert(uses);
+		for (int q = prolog; q <= epilog; q++) {
+			for (int a = 0; a < QUAD_ARG_NUM; a++)
+				count_temp_use(uses, use_size, &quad_list->arr[q].args[a]);
+		}
+
+		/* fuse "t = a < b; iffalse/iftrue t goto L" when nothing else reads t */
+		for (int q = prolog; q < epilog; q++) {
+			quad * cmp = &quad_list->arr[q];
+			quad * branch = &quad_list->arr[q + 1];
+
+			if (!is_compare_op(cmp->op) || (branch->op != IFFALSE_Q && branch->op != IFTRUE_Q))
+				continue;
+			if (cmp->args[0].type != TEMP_VAR_Q_ARG || branch->args[0].type != TEMP_VAR_Q_ARG)
+				continue;
+			if (cmp->args[0].temp != branch->args[0].temp || uses[cmp->args[0].temp->id] != 2)
+				continue;
+
+			fused_compares[q] = 1;
+		}
+
+		free(uses);
+	}
+}
+
+int is_fused_compare(int index) {
+	if (!fused_compares || index < 0 || index >= quad_list->count)
+		return 0;
+	return fused_compares[index];
 }
 
 /*
@@ -703,18 +1042,18 @@ void translate_string(FILE * ys_file_ptr, quad * string_to_add) {
 	if (!ys_file_ptr || ! string_to_add)
 		return;
 
-	if (!string_to_add->args[0] || !string_to_add->args[1]) {
+	if (string_to_add->args[0].type == NULL_ARG || string_to_add->args[1].type == NULL_ARG) {
 		fprintf(stderr,"cannot translate string -- lacking arguments\n");
 		exit(1);
 	}
 
 	// generate label
-	fprintf(ys_file_ptr,"%s:\n",string_to_add->args[0]->label);
+	fprintf(ys_file_ptr,"%s:\n",string_to_add->args[0].label);
 
 	// generate ascii bytes
-	int len = strlen(string_to_add->args[1]->label);
+	int len = strlen(string_to_add->args[1].label);
 	for (int i = 0; i < len; i++) {
-		fprintf(ys_file_ptr,"\t.byte 0x%x\n",string_to_add->args[1]->label[i]);
+		fprintf(ys_file_ptr,"\t.byte 0x%x\n",string_to_add->args[1].label[i]);
 	}
 
 	// add null terminator
@@ -723,6 +1062,24 @@ void translate_string(FILE * ys_file_ptr, quad * string_to_add) {
 	return;
 }
 
+/*
+ * without frame packing, every temp of the function gets its own slot
+ * below the locals
+ *
+ * returns lowest offset used
+ */
+static int set_temp_offsets(temp_list * temps, int local_bytes) {
+	if (!temps)
+		return local_bytes;
+
+	for (int i = 0; i < temps->count; i++) {
+		symnode_t * sym = (symnode_t *)temps->list[i]->temp_symnode;
+		local_bytes -= TYPE_SIZE(sym->s.v.type);
+		sym->s.v.offset_of_frame_pointer = local_bytes;
+	}
+	return local_bytes;
+}
+
 /*
  * before generating code, set all your frame pointer offsets for variables and put globals in place
  *
@@ -762,6 +1119,7 @@ int set_variable_memory_locations(symboltable_t * symtab) {
 						bottom_of_globals -= bytes;
 						sym->s.v.offset_of_frame_pointer = bottom_of_globals;
 						sym->s.v.specie = GLOBAL_VAR;
+						bottom_of_globals -= TYPE_SIZE(sym->s.v.type); 	// next free spot is below element 0
 					}
 
 				}
@@ -774,6 +1132,10 @@ int set_variable_memory_locations(symboltable_t * symtab) {
 	int function_stk_offset;
 	for (symhashtable_t * child = symtab->root->child; child != NULL; child = child->rightsib) {
 		function_stk_offset = set_fp_offsets(child, 0, TYPE_SIZE(INT_TS));
+		if (frame_packing)
+			function_stk_offset = pack_temp_slots(child->function_owner, function_stk_offset);
+		else
+			function_stk_offset = set_temp_offsets(child->t_list, function_stk_offset);
 		child->function_owner->s.f.stk_offset = function_stk_offset;
 	}
 
@@ -808,8 +1170,7 @@ int set_fp_offsets(symhashtable_t * symhash, int local_bytes, int param_bytes) {
 							// param_bytes += TYPE_SIZE(sym->s.v.type);
 							break;
 
-						/* treat locals and locals the same */
-						case TEMP_VAR:
+						/* temps aren't in the scopes -- see set_temp_offsets() / pack_temp_slots() */
 						case LOCAL_VAR:
 
 							if (sym->s.v.modifier == SINGLE_DT) {
@@ -51,6 +51,18 @@ static val_name_pair reg_table[] = {
 #define REGISTER_INDEX(X) ( (X) - EAX_R )
 #define REGISTER_STR(X) ( reg_table[ TYPE_INDEX((X)) ].name)
 
+/*
+ * 1 to add literals with iaddl (--iaddl). the course's ssim is built from
+ * seq-std.hcl, which has no IIADDL, so it's off by default
+ */
+extern int iaddl_enabled;
+
+/*
+ * 1 (default) to fuse comparisons with the branch after them (see
+ * mark_fused_compares()), 0 (--no-fuse-compares) to build every 0/1 temp
+ */
+extern int fusion_enabled;
+
 /*
  * creates ys file from global quad_list
  */
@@ -65,6 +77,26 @@ void print_code(quad * to_translate, FILE * ys_file_ptr);
 int get_source_value(FILE * fp, quad_arg * src, my_register_t dest);
 int get_dest_value(FILE * fp, my_register_t src, quad_arg * dest);
 
+/*
+ * loads the scaled index of array element arr into %edi and writes the
+ * memory operand that reaches the element through it to operand. a local's
+ * frame offset or a global's address is the operand's displacement instead
+ * of being added to %edi on every access. an ELEMENT_POINTER's temp is the
+ * address itself.
+ */
+void element_operand(FILE * fp, quad_arg * arr, char * operand);
+
+/*
+ * dest = value + c, in dest's register when it has one. a single iaddl
+ * with iaddl_enabled, otherwise irmovl c into %ebx and addl
+ */
+void add_immediate(FILE * fp, quad_arg * dest, quad_arg * value, int c);
+
+/*
+ * k if arg is the literal 2^k, else -1
+ */
+int power_of_two(quad_arg * arg);
+
 /*
  * 	chooses irmovl, rrmovl, or mrmovl depending on source 
  */
@@ -75,11 +107,47 @@ int get_dest_value(FILE * fp, my_register_t src, quad_arg * dest);
  */
 // char * handle_quad_arg(quad_arg * arg);
 
+/*
+ * sets condition codes for arg compared with 0 (andl, no scratch register
+ * if arg already lives in one)
+ */
+void test_zero(FILE * fp, quad_arg * arg);
+
+/*
+ * copies register src into register dest (emits nothing if they're the same)
+ */
+void move_register(FILE * fp, int src, int dest);
+
+/*
+ * prolog / epilog helpers for registers handed out by the register allocator
+ */
+void save_registers(FILE * fp, symnode_t * func_sym);
+void restore_registers(FILE * fp, symnode_t * func_sym);
+void load_register_parameters(FILE * fp, symnode_t * func_sym);
+
 /*
  * generic subtraction operation for comparisons 
  */
 void comp_sub(quad * to_translate, FILE * ys_file_ptr);
 
+/*
+ * comparison fused with the IFFALSE_Q / IFTRUE_Q branch right after it -- emits
+ * subl and the conditional jump (inverted for IFFALSE_Q: jge for <, jle for >, ...)
+ */
+void comp_branch(quad * to_translate, quad * branch, FILE * ys_file_ptr);
+
+/*
+ * finds comparisons whose temp is only read by the branch that follows them
+ * (none when fusion_enabled is off). must run before allocate_registers() so
+ * fused temps don't take a register.
+ */
+void mark_fused_compares();
+
+/*
+ * 1 if the comparison at quad index is fused with the branch after it
+ */
+int is_fused_compare(int index);
+
 /*
  * Given that a variable can be a temp, local, parameter or global,
  * find the offset of the framepointer
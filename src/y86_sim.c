@@ -0,0 +1,413 @@
+/*
+ * y86_sim.c
+ *
+ * executes assembled Y86 code one instruction at a time with the same
+ * semantics as the course simulator (yis): divl / modl / mull / shifts
+ * set the condition codes like the other ALU operations, reading a display
+ * register gives 0, and KHXR skips input until it finds a hex number.
+ *
+ * Yondon Fu and Matt McFarland - Delights (CS57 - 16W)
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <limits.h>
+#include <assert.h>
+
+#include "y86_sim.h"
+
+#define ESP 4
+#define EBP 5
+
+static char * sim_reg_names[] = {"%eax", "%ecx", "%edx", "%ebx", "%esp", "%ebp", "%esi", "%edi"};
+
+y86_machine * new_y86_machine(int mem_size) {
+	y86_machine * m = (y86_machine *)calloc(1, sizeof(y86_machine));
+	assert(m);
+
+	m->mem = (unsigned char *)calloc(mem_size, 1);
+	assert(m->mem);
+	m->mem_size = mem_size;
+	m->status = SIM_AOK;
+	m->in = stdin;
+	m->out = stdout;
+	m->load_dest = Y86_NO_REG;
+	return m;
+}
+
+void destroy_y86_machine(y86_machine * m) {
+	if (!m)
+		return;
+	free(m->mem);
+	free(m);
+}
+
+const char * sim_status_name(sim_status status) {
+	switch (status) {
+		case SIM_AOK: 	return "AOK";
+		case SIM_HLT: 	return "HLT";
+		case SIM_ADR: 	return "ADR";
+		case SIM_INS: 	return "INS";
+		case SIM_LIMIT: return "LIMIT";
+		default: 		return "???";
+	}
+}
+
+/*
+ * ----- memory -----
+ */
+
+static int fetch_byte(y86_machine * m, unsigned int address, unsigned char * byte) {
+	if (address >= (unsigned int)m->mem_size)
+		return 1;
+	*byte = m->mem[address];
+	return 0;
+}
+
+static int fetch_word(y86_machine * m, unsigned int address, int * word) {
+	if (address > (unsigned int)m->mem_size - 4)
+		return 1;
+
+	unsigned int val = 0;
+	for (int i = 0; i < 4; i++)
+		val |= (unsigned int)m->mem[address + i] << (8 * i);
+	*word = (int)val;
+	return 0;
+}
+
+static int read_word(y86_machine * m, unsigned int address, int * word) {
+	if (address == SIM_KHXR) {
+		m->stats.io_reads++;
+		unsigned int val = 0;
+		int found;
+		while ((found = fscanf(m->in, "%x", &val)) == 0)
+			fscanf(m->in, "%*c"); 		// skip whatever isn't hex
+		*word = (found == 1) ? (int)val : 0;
+		return 0;
+	}
+	if (address == SIM_DSTR || address == SIM_DHXR) {
+		m->stats.io_reads++;
+		*word = 0;
+		return 0;
+	}
+
+	m->stats.mem_reads++;
+	return fetch_word(m, address, word);
+}
+
+static int write_word(y86_machine * m, unsigned int address, int word) {
+	if (address == SIM_DSTR) {
+		m->stats.io_writes++;
+		unsigned int start = (unsigned int)word;
+		if (start >= (unsigned int)m->mem_size)
+			return 1;
+		int len = strnlen((char *)&m->mem[start], m->mem_size - start);
+		fprintf(m->out, "%.*s\n", len, (char *)&m->mem[start]);
+		return 0;
+	}
+	if (address == SIM_DHXR) {
+		m->stats.io_writes++;
+		fprintf(m->out, "0x%08x\n", (unsigned int)word);
+		return 0;
+	}
+
+	m->stats.mem_writes++;
+	if (address > (unsigned int)m->mem_size - 4)
+		return 1;
+	for (int i = 0; i < 4; i++)
+		m->mem[address + i] = ((unsigned int)word >> (8 * i)) & 0xFF;
+	return 0;
+}
+
+/*
+ * ----- ALU and conditions -----
+ */
+
+static int cond_holds(y86_machine * m, int cond) {
+	switch (cond) {
+		case COND_YES: 	return 1;
+		case COND_LE: 	return (m->sf ^ m->of) | m->zf;
+		case COND_L: 	return m->sf ^ m->of;
+		case COND_E: 	return m->zf;
+		case COND_NE: 	return !m->zf;
+		case COND_GE: 	return !(m->sf ^ m->of);
+		case COND_G: 	return !(m->sf ^ m->of) & !m->zf;
+		default: 		return 0;
+	}
+}
+
+/*
+ * b = b OP a (a is the shift amount for shifts), setting condition codes.
+ * returns 1 on division by zero or overflow
+ */
+static int compute_alu(y86_machine * m, int fn, int a, int * b) {
+	unsigned int ua = (unsigned int)a, ub = (unsigned int)*b;
+	int val;
+	long long wide;
+	int of = 0;
+
+	switch (fn) {
+		case ALU_ADD:
+			val = (int)(ua + ub);
+			of = ((a < 0) == (*b < 0)) && ((val < 0) != (a < 0));
+			break;
+		case ALU_SUB:
+			val = (int)(ub - ua);
+			of = ((a > 0) == (*b < 0)) && ((val < 0) != (*b < 0));
+			break;
+		case ALU_AND:
+			val = a & *b;
+			break;
+		case ALU_XOR:
+			val = a ^ *b;
+			break;
+		case ALU_MUL:
+			wide = (long long)a * (long long)*b;
+			val = (int)(ua * ub);
+			of = (wide != val);
+			break;
+		case ALU_DIV:
+		case ALU_MOD:
+			if (a == 0 || (a == -1 && *b == INT_MIN))
+				return 1;
+			val = (fn == ALU_DIV) ? *b / a : *b % a;
+			break;
+		case ALU_SHL:
+			val = (int)(ub << a);
+			of = (((long long)*b << a) != val);
+			break;
+		case ALU_SHR:
+			val = (int)(ub >> a);
+			break;
+		default:
+			return 1;
+	}
+
+	*b = val;
+	m->zf = (val == 0);
+	m->sf = (val < 0);
+	m->of = of;
+	return 0;
+}
+
+/*
+ * ----- execution -----
+ */
+
+static sim_status fault(y86_machine * m, sim_status status, const char * message, unsigned int address) {
+	fprintf(stderr, "PC = 0x%x, %s 0x%x\n", m->pc, message, address);
+	m->status = status;
+	return status;
+}
+
+sim_status step_y86(y86_machine * m) {
+	if (m->status != SIM_AOK)
+		return m->status;
+
+	unsigned char code, regs = Y86_PACK(Y86_NO_REG, Y86_NO_REG);
+	if (fetch_byte(m, m->pc, &code))
+		return fault(m, SIM_ADR, "invalid instruction address", m->pc);
+
+	int length = y86_instr_length(code);
+	if (length == 0)
+		return fault(m, SIM_INS, "invalid instruction", code);
+
+	int icode = Y86_HI(code), fn = Y86_LO(code);
+	int value = 0;
+	unsigned int next_pc = m->pc + length;
+
+	if (length == 2 || length == 6) {
+		if (fetch_byte(m, m->pc + 1, &regs))
+			return fault(m, SIM_ADR, "invalid instruction address", m->pc + 1);
+	}
+	if (length >= 5) {
+		if (fetch_word(m, m->pc + length - 4, &value))
+			return fault(m, SIM_ADR, "invalid instruction address", m->pc + length - 4);
+	}
+
+	int ra = Y86_HI(regs), rb = Y86_LO(regs);
+	int valid_ra = ra < 8, valid_rb = rb < 8;
+
+	/* registers read, for the load/use hazard with the instruction before */
+	int reads = 0;
+	switch (icode) {
+		case Y86_RRMOVL: 	reads = valid_ra ? (1 << ra) : 0; break;
+		case Y86_RMMOVL: 	reads = (valid_ra ? (1 << ra) : 0) | (valid_rb ? (1 << rb) : 0); break;
+		case Y86_MRMOVL: 	reads = valid_rb ? (1 << rb) : 0; break;
+		case Y86_ALU:
+			reads = (valid_rb ? (1 << rb) : 0) | ((fn < ALU_SHL && valid_ra) ? (1 << ra) : 0);
+			break;
+		case Y86_IADDL: 	reads = valid_rb ? (1 << rb) : 0; break;
+		case Y86_PUSHL: 	reads = (valid_ra ? (1 << ra) : 0) | (1 << ESP); break;
+		case Y86_POPL:
+		case Y86_CALL:
+		case Y86_RET: 		reads = 1 << ESP; break;
+		case Y86_LEAVE: 	reads = 1 << EBP; break;
+		default: 			break;
+	}
+	if (m->load_dest != Y86_NO_REG && (reads & (1 << m->load_dest))) {
+		m->stats.load_use_stalls++;
+		m->stats.cycles += LOAD_USE_PENALTY;
+	}
+	m->load_dest = Y86_NO_REG;
+
+	int word;
+	unsigned int address;
+	switch (icode) {
+		case Y86_HALT:
+			m->stats.instructions++;
+			m->stats.cycles++;
+			m->status = SIM_HLT;
+			return m->status;
+
+		case Y86_NOP:
+			break;
+
+		case Y86_RRMOVL:
+			if (!valid_ra || !valid_rb)
+				return fault(m, SIM_INS, "invalid register", regs);
+			if (cond_holds(m, fn))
+				m->regs[rb] = m->regs[ra];
+			break;
+
+		case Y86_IRMOVL:
+			if (!valid_rb)
+				return fault(m, SIM_INS, "invalid register", regs);
+			m->regs[rb] = value;
+			break;
+
+		case Y86_RMMOVL:
+			if (!valid_ra)
+				return fault(m, SIM_INS, "invalid register", regs);
+			address = (unsigned int)value + (valid_rb ? (unsigned int)m->regs[rb] : 0);
+			if (write_word(m, address, m->regs[ra]))
+				return fault(m, SIM_ADR, "invalid data address", address);
+			break;
+
+		case Y86_MRMOVL:
+			if (!valid_ra)
+				return fault(m, SIM_INS, "invalid register", regs);
+			address = (unsigned int)value + (valid_rb ? (unsigned int)m->regs[rb] : 0);
+			if (read_word(m, address, &word))
+				return fault(m, SIM_ADR, "invalid data address", address);
+			m->regs[ra] = word;
+			m->load_dest = ra;
+			break;
+
+		case Y86_ALU:
+			if (!valid_rb || (fn < ALU_SHL && !valid_ra))
+				return fault(m, SIM_INS, "invalid register", regs);
+			if (compute_alu(m, fn, (fn < ALU_SHL) ? m->regs[ra] : ra, &m->regs[rb]))
+				return fault(m, SIM_INS, "arithmetic error (division by zero?) in", code);
+			break;
+
+		case Y86_JMP:
+			if (fn != COND_YES) {
+				m->stats.cond_jumps++;
+				if (!cond_holds(m, fn)) {
+					m->stats.mispredicts++;
+					m->stats.cycles += MISPREDICT_PENALTY;
+					break;
+				}
+			}
+			next_pc = (unsigned int)value;
+			break;
+
+		case Y86_CALL:
+			m->regs[ESP] -= 4;
+			if (write_word(m, m->regs[ESP], next_pc))
+				return fault(m, SIM_ADR, "invalid stack address", m->regs[ESP]);
+			next_pc = (unsigned int)value;
+			break;
+
+		case Y86_RET:
+			if (read_word(m, m->regs[ESP], &word))
+				return fault(m, SIM_ADR, "invalid stack address", m->regs[ESP]);
+			m->regs[ESP] += 4;
+			next_pc = (unsigned int)word;
+			m->stats.returns++;
+			m->stats.cycles += RET_PENALTY;
+			break;
+
+		case Y86_PUSHL:
+			if (!valid_ra)
+				return fault(m, SIM_INS, "invalid register", regs);
+			word = m->regs[ra];
+			m->regs[ESP] -= 4;
+			if (write_word(m, m->regs[ESP], word))
+				return fault(m, SIM_ADR, "invalid stack address", m->regs[ESP]);
+			break;
+
+		case Y86_POPL:
+			if (!valid_ra)
+				return fault(m, SIM_INS, "invalid register", regs);
+			if (read_word(m, m->regs[ESP], &word))
+				return fault(m, SIM_ADR, "invalid stack address", m->regs[ESP]);
+			m->regs[ESP] += 4;
+			m->regs[ra] = word;
+			m->load_dest = ra;
+			break;
+
+		case Y86_IADDL:
+			if (!valid_rb)
+				return fault(m, SIM_INS, "invalid register", regs);
+			compute_alu(m, ALU_ADD, value, &m->regs[rb]);
+			break;
+
+		case Y86_LEAVE:
+			if (read_word(m, m->regs[EBP], &word))
+				return fault(m, SIM_ADR, "invalid stack address", m->regs[EBP]);
+			m->regs[ESP] = m->regs[EBP] + 4;
+			m->regs[EBP] = word;
+			m->load_dest = EBP;
+			break;
+
+		default:
+			return fault(m, SIM_INS, "invalid instruction", code);
+	}
+
+	m->stats.instructions++;
+	m->stats.cycles++;
+	m->pc = next_pc;
+	return m->status;
+}
+
+sim_status run_y86(y86_machine * m, long max_steps) {
+	/* the first instruction retires once the pipeline has filled */
+	if (m->stats.instructions == 0)
+		m->stats.cycles += PIPELINE_FILL;
+
+	while (m->status == SIM_AOK) {
+		if (max_steps > 0 && m->stats.instructions >= max_steps) {
+			m->status = SIM_LIMIT;
+			break;
+		}
+		step_y86(m);
+	}
+	return m->status;
+}
+
+void print_sim_stats(y86_machine * m, FILE * fp) {
+	sim_stats * s = &m->stats;
+
+	fprintf(fp, "Stopped in %ld steps at PC = 0x%x. Status '%s', CC Z=%d S=%d O=%d\n",
+		s->instructions, m->pc, sim_status_name(m->status), m->zf, m->sf, m->of);
+	fprintf(fp, "Registers:");
+	for (int r = 0; r < 8; r++)
+		fprintf(fp, " %s=0x%x", sim_reg_names[r], (unsigned int)m->regs[r]);
+	fprintf(fp, "\n");
+
+	fprintf(fp, "instructions:     %ld\n", s->instructions);
+	fprintf(fp, "memory reads:     %ld\n", s->mem_reads);
+	fprintf(fp, "memory writes:    %ld\n", s->mem_writes);
+	fprintf(fp, "I/O reads:        %ld\n", s->io_reads);
+	fprintf(fp, "I/O writes:       %ld\n", s->io_writes);
+	fprintf(fp, "conditional jumps: %ld (%ld mispredicted)\n", s->cond_jumps, s->mispredicts);
+	fprintf(fp, "load/use stalls:  %ld\n", s->load_use_stalls);
+	fprintf(fp, "returns:          %ld\n", s->returns);
+	fprintf(fp, "estimated cycles: %ld", s->cycles);
+	if (s->instructions > 0)
+		fprintf(fp, " (CPI %.2f)", (double)s->cycles / s->instructions);
+	fprintf(fp, "\n");
+}
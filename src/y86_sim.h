@@ -0,0 +1,95 @@
+/*
+ * y86_sim.h
+ *
+ * instruction level Y86 simulator with the memory mapped I/O registers
+ * PRINT_Q / READ_Q use, counting instructions, memory traffic and an
+ * estimate of pipelined cycles
+ * Yondon Fu and Matt McFarland - Delights (CS57 - 16W)
+ */
+
+#ifndef _Y86_SIM_H
+#define _Y86_SIM_H
+
+#include <stdio.h>
+
+#include "y86_asm.h"
+
+/*
+ * memory mapped I/O (same addresses as y86_code_gen.c)
+ */
+#define SIM_DSTR 0x00FFFE10 		// write: print the string at the address written
+#define SIM_DHXR 0x00FFFE14 		// write: print the word in hex
+#define SIM_KHXR 0x00FFFE1C 		// read: hex number from the input
+
+/*
+ * cycle estimate for the textbook five stage pipeline: one instruction
+ * retires per cycle, plus bubbles for load/use hazards, mispredicted
+ * branches (predicted taken) and returns, plus the cycles to fill the pipe
+ */
+#define LOAD_USE_PENALTY 1
+#define MISPREDICT_PENALTY 2
+#define RET_PENALTY 3
+#define PIPELINE_FILL 4
+
+typedef enum {
+	SIM_AOK, 		// still running
+	SIM_HLT, 		// halt executed
+	SIM_ADR, 		// bad memory address
+	SIM_INS, 		// bad instruction (or division by zero)
+	SIM_LIMIT 		// step limit reached
+} sim_status;
+
+typedef struct sim_stats {
+	long instructions;
+	long mem_reads; 			// data reads, including the stack
+	long mem_writes;
+	long io_reads;
+	long io_writes;
+	long cond_jumps;
+	long mispredicts;
+	long load_use_stalls;
+	long returns;
+	long cycles; 				// estimated, see above
+} sim_stats;
+
+typedef struct y86_machine {
+	unsigned char * mem;
+	int mem_size;
+	int regs[8];
+	int zf, sf, of;
+	unsigned int pc;
+	sim_status status;
+	sim_stats stats;
+
+	FILE * in; 				// KHXR reads from here
+	FILE * out; 			// DSTR / DHXR write here
+
+	int load_dest; 			// register the previous instruction loaded from memory, or Y86_NO_REG
+} y86_machine;
+
+/*
+ * zeroed machine with mem_size bytes of memory, reading from stdin and
+ * printing to stdout
+ */
+y86_machine * new_y86_machine(int mem_size);
+void destroy_y86_machine(y86_machine * m);
+
+/*
+ * executes one instruction, updating m->status and m->stats
+ */
+sim_status step_y86(y86_machine * m);
+
+/*
+ * runs from m->pc until the machine stops or max_steps instructions
+ * ran (max_steps <= 0 for no limit)
+ */
+sim_status run_y86(y86_machine * m, long max_steps);
+
+const char * sim_status_name(sim_status status);
+
+/*
+ * prints the final status and the counters
+ */
+void print_sim_stats(y86_machine * m, FILE * fp);
+
+#endif 	// _Y86_SIM_H
@@ -0,0 +1,69 @@
+/*
+ * branch lowering: && and || in conditions jump straight to their targets,
+ * and a right operand only runs when the left doesn't decide the test
+ */
+
+int calls;
+
+int check(int v) {
+	calls++;
+	return v;
+}
+
+void taken(int branch) {
+	print branch;
+}
+
+int main(void) {
+	int i;
+	int j;
+
+	/* short circuits skip the call */
+	calls = 0;
+	if (check(0) && check(1))
+		taken(1);
+	if (check(1) || check(0))
+		taken(2);
+	print calls;
+
+	/* both operands run when they have to */
+	calls = 0;
+	if (check(1) && check(1))
+		taken(3);
+	if (check(0) || check(1))
+		taken(4);
+	print calls;
+
+	/* negations and nesting */
+	i = 2;
+	j = 5;
+	if (!(i > 3 && j > 3))
+		taken(5);
+	if ((i > 3 || j > 3) && !(i == j))
+		taken(6);
+	if (i > 3 || (j < 3 || i == 2))
+		taken(7);
+	else
+		taken(8);
+
+	/* loop tests, including an empty one */
+	for (i = 0; i < 10 && i * i < 20; i++)
+		;
+	print i;
+	i = 0;
+	while (i < 3 || i == 5)
+		i++;
+	print i;
+	for (i = 0; ; i++) {
+		if (i > 3)
+			break;
+		print i;
+	}
+	i = 0;
+	do {
+		i = i + 2;
+	} while (i < 7 && !(i == 4));
+	print i;
+
+	return 0;
+}
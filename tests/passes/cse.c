@@ -0,0 +1,72 @@
+/*
+ * cse: a value computed again is taken from the first computation, but a
+ * load is only reused while nothing could have changed what it read
+ */
+
+int g;
+int arr[4];
+
+void setg(int v) {
+	g = v;
+}
+
+/* a parameter array may be the same array as a global */
+int through(int a[], int i) {
+	int before;
+	before = arr[i];
+	a[i] = before + 10;
+	return arr[i] - before;
+}
+
+int main(void) {
+	int a;
+	int b;
+	int x;
+	int y;
+	int i;
+
+	read a;
+	read b;
+
+	/* the same expression, operands either way round */
+	x = a * b + 1;
+	y = b * a + 1;
+	print x - y;
+	print (a + b) * (b + a);
+
+	/* a value from a dominating block, not from a sibling */
+	x = a - b;
+	if (a > b)
+		y = a - b;
+	else
+		y = (a - b) * 2;
+	print x + y;
+	if (a > 0)
+		x = a * 5;
+	else
+		x = 0;
+	y = a * 5;
+	print x + y;
+
+	/* global loads after a store and after a call */
+	g = a;
+	x = g + 1;
+	g = b;
+	y = g + 1;
+	print x + y;
+	x = g * 2;
+	setg(100);
+	y = g * 2;
+	print x + y;
+
+	/* element loads after element stores, including through a parameter */
+	for (i = 0; i < 4; i++)
+		arr[i] = i;
+	x = arr[2];
+	arr[2] = 50;
+	y = arr[2];
+	print x + y;
+	print through(arr, 1);
+
+	return 0;
+}
@@ -0,0 +1,66 @@
+/*
+ * dce: unreachable blocks and quads whose results nobody reads go away,
+ * but calls, stores to globals and arrays, reads and prints stay
+ */
+
+int g;
+int calls;
+
+int bump(int v) {
+	calls++;
+	return v + 1;
+	print 999;
+	return 0;
+}
+
+void store(int v) {
+	int unused;
+	unused = v * 2;
+	g = v;
+}
+
+int main(void) {
+	int a;
+	int b;
+	int i;
+	int arr[3];
+
+	/* dead assignments, live calls */
+	a = 4;
+	a = 5;
+	b = a * 100;
+	bump(1);
+	b = bump(2);
+	print calls;
+	print b;
+
+	/* stores to a global and an array are live */
+	store(7);
+	print g;
+	arr[1] = 9;
+	a = arr[1] + 1;
+	print arr[1];
+
+	/* a read whose value is unused still takes its input */
+	read a;
+	read b;
+	print b;
+
+	/* values carried round a loop stay live */
+	a = 0;
+	b = 1;
+	for (i = 0; i < 5; i++) {
+		a = a + b;
+		b = b * 2;
+	}
+	print a;
+
+	/* code after break and return is unreachable */
+	while (1) {
+		break;
+		print 888;
+	}
+	print 3;
+	return 0;
+	print 777;
+}
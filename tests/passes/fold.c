@@ -0,0 +1,79 @@
+/*
+ * fold: literals propagate into later reads and operations on literals
+ * are evaluated at compile time
+ */
+
+int g;
+
+int setg(int v) {
+	g = v;
+	return 0;
+}
+
+int scale(int x) {
+	int k;
+	k = 3;
+	return x * k + k;
+}
+
+int main(void) {
+	int a;
+	int b;
+	int c;
+	int arr[4];
+
+	/* arithmetic on propagated literals */
+	a = 7;
+	b = a * 6 - 2;
+	print b;
+	print b / 3;
+	print b % 3;
+	print -a / 2;
+	print -a % 2;
+	print -(a - 10);
+
+	/* comparisons and ! */
+	print a < b;
+	print a == 7;
+	print !a;
+	print !(a - 7);
+
+	/* sizeof */
+	print sizeof(a);
+	print sizeof(arr);
+
+	/* increments of known values */
+	c = 5;
+	print c++;
+	print c;
+	print ++c;
+	print --c;
+	print c--;
+	print c;
+
+	/* branches on literals */
+	if (a > 3)
+		print 100;
+	else
+		print 200;
+	while (0)
+		print 300;
+
+	/* a value known on one path only */
+	read c;
+	if (c > 0)
+		a = 1;
+	print a;
+
+	/* a global's value doesn't survive a call that sets it */
+	g = 10;
+	setg(5);
+	c = g;
+	print c;
+
+	/* parameters aren't literals */
+	print scale(4);
+	print scale(-1);
+
+	return 0;
+}
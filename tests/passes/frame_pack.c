@@ -0,0 +1,47 @@
+/*
+ * frame packing: temps that are never live at the same time share a frame
+ * slot, so values live at once must keep slots of their own
+ */
+
+int mix(int a, int b, int c) {
+	return (a * 3 + b * 5) * (c - a) + (b - c) * (a + b + c) - (a * b - c * 2) * (c + 1);
+}
+
+/* an expression-heavy body on every level of a deep recursion */
+int deep(int n) {
+	int x;
+	int y;
+	if (n == 0)
+		return 0;
+	x = (n * 2 + 1) * (n - 1) + (n + 3) * (n + 4) - n * n;
+	y = deep(n - 1);
+	return (x + y) % 10007;
+}
+
+int main(void) {
+	int a;
+	int b;
+	int c;
+	int d;
+	int e;
+	int f;
+
+	/* many values live at once, some across calls */
+	a = 1;
+	b = 2;
+	c = 3;
+	d = mix(a, b, c);
+	e = mix(c, a, b) + d;
+	f = mix(d, e, a) - mix(b, c, d);
+	print a + b + c;
+	print d;
+	print e;
+	print f;
+
+	/* temps of nested expressions */
+	print ((a + b) * (c + d) - (e + f) * (a - c)) * ((b + d) - (c + e) * (f - a));
+
+	print deep(400);
+
+	return 0;
+}
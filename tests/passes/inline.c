@@ -0,0 +1,96 @@
+/*
+ * inline: calls of small functions that make no calls are replaced with
+ * a copy of the function's body
+ */
+
+int g;
+int garr[3];
+
+int clamp(int v, int lo, int hi) {
+	if (v < lo)
+		return lo;
+	if (v > hi)
+		return hi;
+	return v;
+}
+
+/* changes its own copy of n only */
+int countdown(int n) {
+	int steps;
+	steps = 0;
+	while (n > 0) {
+		n = n - 2;
+		steps++;
+	}
+	return steps;
+}
+
+void addg(int v) {
+	g = g + v;
+}
+
+/* t is only set on the first trip and read on the later ones */
+void carry(int n) {
+	int i, t, x;
+	for (i = 0; i < n; i++) {
+		x = i * 7;
+		g = g + x;
+		if (i == 0)
+			t = 5;
+		else
+			g = g + t;
+	}
+}
+
+int get(int a[], int i) {
+	return a[i];
+}
+
+/* calls itself, so it stays a call */
+int fact(int n) {
+	if (n <= 1)
+		return 1;
+	return n * fact(n - 1);
+}
+
+int main(void) {
+	int i;
+	int n;
+	int steps;
+	int arr[3];
+
+	/* early returns, the same function inlined several times */
+	print clamp(-5, 0, 10);
+	print clamp(50, 0, 10);
+	print clamp(7, 0, 10);
+
+	/* a parameter the callee changes, and a local named like the callee's */
+	n = 9;
+	steps = 100;
+	print countdown(n);
+	print n;
+	print steps;
+
+	/* calls in a loop, a void callee and a result nobody uses */
+	g = 0;
+	for (i = 0; i < 4; i++)
+		addg(i);
+	clamp(1, 2, 3);
+	print g;
+
+	/* a local carried round the callee's loop */
+	g = 0;
+	carry(4);
+	print g;
+
+	/* array arguments, global and local */
+	for (i = 0; i < 3; i++) {
+		garr[i] = i * 10;
+		arr[i] = i + 100;
+	}
+	print get(garr, 2) + get(arr, 1);
+
+	print fact(5);
+
+	return 0;
+}
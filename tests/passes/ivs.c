@@ -0,0 +1,58 @@
+/*
+ * ivs: elements indexed by a loop's induction variable are reached
+ * through pointers stepped once a trip
+ */
+
+int g[10];
+
+int sum(int a[], int n) {
+	int i;
+	int s;
+	s = 0;
+	for (i = 0; i < n; i++)
+		s = s + a[i];
+	return s;
+}
+
+int main(void) {
+	int a[10];
+	int i;
+	int j;
+	int start;
+
+	/* a[i] and its neighbours, on a local and a global array */
+	for (i = 0; i < 10; i++) {
+		a[i] = i * 3;
+		g[i] = 0;
+	}
+	for (i = 1; i < 9; i++)
+		g[i] = a[i - 1] + a[i + 1];
+	print sum(g, 10);
+
+	/* a step of 2 and a start known only at run time */
+	read start;
+	for (i = start; i < 10; i = i + 2)
+		a[i] = -1;
+	print sum(a, 10);
+
+	/* counting down */
+	for (i = 9; i >= 0; i--)
+		g[i] = i;
+	print g[0];
+	print g[9];
+
+	/* leaving the loop early keeps the index and the pointers in step */
+	for (i = 0; i < 10; i++) {
+		if (a[i] < 0)
+			break;
+	}
+	print i;
+
+	/* nested loops over the same array */
+	for (i = 0; i < 3; i++)
+		for (j = 0; j < 3; j++)
+			a[i * 3 + j] = i + j;
+	print sum(a, 9);
+
+	return 0;
+}
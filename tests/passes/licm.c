@@ -0,0 +1,78 @@
+/*
+ * licm: loop invariant computations move to the loop's preheader, but
+ * nothing that could fault or read a changing value moves
+ */
+
+int g;
+int garr[5];
+
+void setg(int v) {
+	g = v;
+}
+
+int total(int a[], int n, int k) {
+	int i;
+	int s;
+	s = 0;
+	for (i = 0; i < n; i++)
+		s = s + a[i] * (k * 2 + 1);
+	return s;
+}
+
+int main(void) {
+	int a[5];
+	int i;
+	int j;
+	int k;
+	int d;
+	int s;
+
+	/* invariants of a number read at run time, on all three kinds of array */
+	read k;
+	for (i = 0; i < 5; i++) {
+		a[i] = i + k * k;
+		garr[i] = a[i] - (k + 1) * 2;
+	}
+	print total(a, 5, k);
+	print total(garr, 5, 1);
+
+	/* a loop that never runs computes nothing */
+	s = 0;
+	for (i = 0; i < 0; i++)
+		s = k * 100;
+	print s;
+
+	/* a division by a variable stays behind its guard */
+	d = 0;
+	s = 0;
+	for (i = 0; i < 4; i++) {
+		if (d != 0)
+			s = s + 100 / d;
+		s = s + i;
+	}
+	print s;
+
+	/* a global the loop changes, directly or through a call */
+	g = 1;
+	s = 0;
+	for (i = 0; i < 3; i++) {
+		s = s + g * 10;
+		g = g + 1;
+	}
+	print s;
+	s = 0;
+	for (i = 0; i < 3; i++) {
+		s = s + g;
+		setg(i);
+	}
+	print s;
+
+	/* an inner loop's invariant that the outer loop changes */
+	s = 0;
+	for (i = 0; i < 3; i++)
+		for (j = 0; j < 4; j++)
+			s = s + i * 7 + j;
+	print s;
+
+	return 0;
+}
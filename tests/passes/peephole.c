@@ -0,0 +1,38 @@
+/*
+ * peephole: loads of a word a register already holds become moves, but
+ * reads of the input register always read the next input
+ */
+
+int g;
+
+int twice(int x) {
+	int y;
+	y = x + x;
+	g = y;
+	return g + y;
+}
+
+int main(void) {
+	int a;
+	int b;
+	int c;
+
+	/* consecutive reads take consecutive inputs */
+	read a;
+	read b;
+	print a;
+	print b;
+
+	/* a read right after a read of the same variable */
+	read c;
+	read c;
+	print c;
+
+	/* stored words reloaded from registers */
+	g = a;
+	print g;
+	print twice(b);
+	print g;
+
+	return 0;
+}
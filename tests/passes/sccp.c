@@ -0,0 +1,82 @@
+/*
+ * sccp: values constant on every path that can run become literals, and
+ * SSA form's phis come back out as the right copies
+ */
+
+int g;
+
+int pick(int n) {
+	int x;
+	int y;
+
+	/* the same constant on both sides */
+	if (n > 0)
+		x = 4;
+	else
+		x = 4;
+
+	/* a branch on a constant: the other side can't run */
+	y = 1;
+	if (y == 2)
+		x = 9;
+	return x * 10 + y;
+}
+
+int main(void) {
+	int a;
+	int b;
+	int t;
+	int i;
+	int n;
+
+	print pick(1);
+	print pick(-1);
+
+	/* constant through a loop that never changes it */
+	a = 3;
+	for (i = 0; i < 4; i++) {
+		if (a != 3)
+			a = a + 1;
+	}
+	print a;
+
+	/* not constant: changed in the loop */
+	b = 1;
+	for (i = 0; i < 4; i++)
+		b = b * 3;
+	print b;
+
+	/* swapping round a loop (phis that read each other) */
+	a = 1;
+	b = 2;
+	for (i = 0; i < 3; i++) {
+		t = a;
+		a = b;
+		b = t;
+	}
+	print a;
+	print b;
+
+	/* a value used after the loop that redefines it (lost copy) */
+	n = 0;
+	i = 0;
+	while (i < 5) {
+		n = i;
+		i = i + 1;
+	}
+	print n;
+	print i;
+
+	/* input and globals aren't constants */
+	read a;
+	if (a > 5)
+		b = 1;
+	else
+		b = 2;
+	print b;
+	g = 6;
+	pick(0);
+	print g;
+
+	return 0;
+}
@@ -0,0 +1,37 @@
+/*
+ * global scalars and arrays declared side by side must not share memory
+ */
+
+int a;
+int b[2];
+int c;
+int d[3];
+int e;
+int f[1];
+int g;
+
+int main(void) {
+	int i;
+
+	a = 1;
+	c = 2;
+	e = 3;
+	g = 4;
+	for (i = 0; i < 2; i++)
+		b[i] = 10 + i;
+	for (i = 0; i < 3; i++)
+		d[i] = 20 + i;
+	f[0] = 30;
+
+	print a;
+	print c;
+	print e;
+	print g;
+	for (i = 0; i < 2; i++)
+		print b[i];
+	for (i = 0; i < 3; i++)
+		print d[i];
+	print f[0];
+
+	return 0;
+}
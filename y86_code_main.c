@@ -8,14 +8,24 @@
  */
 
 #include <stdio.h>
+#include <string.h>
 #include "src/ast.h"
 #include "src/symtab.h"
 #include "src/check_sym.h"
 #include "src/IR_gen.h"
 #include "src/y86_code_gen.h"
+#include "src/frame_pack.h"
+#include "src/peephole.h"
+#include "src/cfg.h"
+#include "src/pass_manager.h"
+#include "src/arena.h"
+#include "src/intern.h"
+#include "src/stats.h"
 
 extern int yyparse(); 
 extern int yydebug; 
+extern int open_source(char * path);   // scan.l
+extern void close_source();
 
 ast_node root = NULL;
 int parseError = 0; 	      // global flag
@@ -23,62 +33,209 @@ int type_error_count = 0;   // used to count type errors
 int node_count = 0;         // used to give unique node IDs
 quad_arr * quad_list = NULL;    // global quad list
 symboltable_t * symtab;
+arena * compile_arena = NULL;   // AST, quads, temps and names for this compilation
+string_table * compile_strings = NULL;  // interned identifiers, temp names and labels
+int verbosity = 0;          // -v / -v -v, see types.h
+
+/* what to pretty print to stdout (nothing by default) */
+static int dump_ast = 0;
+static int dump_quads = 0;
+static int dump_cfg = 0;
+static int dump_symtab = 0;
+static int dump_symtab_stats = 0;
+static int stats_json = 0;      // --stats=json
+static pass_pipeline pipeline;  // -O level or --passes
+
+static void usage(char * prog) {
+  fprintf(stderr, "usage: %s [-v] [-O0|-O1|-O2] [--passes=PASS,...] [--dump-ast] [--dump-quads] [--dump-ssa] [--dump-cfg] [--dump-symtab] [--dump-symtab-stats] [--stats[=json]] [--iaddl] [--no-frame-pack] [--no-peephole] [--no-fuse-compares] [INPUT_FILE] [OUTPUT_NAME_PREFIX]\n", prog);
+  fprintf(stderr, "       (with one name it's the output prefix and the program is read from stdin)\n");
+  fprintf(stderr, "passes:\n");
+  print_pass_names(stderr);
+}
 
 int main(int argc, char * argv[]) {
   int noRoot = 0;		/* 0 means we will have a root */
+  char * file_name = "myfile";
+  char * input_name = NULL;     // NULL or "-" reads stdin
+  char * names[2];
+  int name_count = 0;
+  int opt_level = 1;
+  char * pass_list = NULL;      // overrides opt_level
+
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "-v") == 0)
+      verbosity++;
+    else if (strncmp(argv[i], "-O", 2) == 0 && argv[i][2] >= '0' && argv[i][2] <= '2' && argv[i][3] == '\0')
+      opt_level = argv[i][2] - '0';
+    else if (strncmp(argv[i], "--passes=", 9) == 0)
+      pass_list = argv[i] + 9;
+    else if (strcmp(argv[i], "--dump-ssa") == 0)
+      pipeline.dump_ssa = 1;
+    else if (strcmp(argv[i], "--dump-ast") == 0)
+      dump_ast = 1;
+    else if (strcmp(argv[i], "--dump-quads") == 0)
+      dump_quads = 1;
+    else if (strcmp(argv[i], "--dump-cfg") == 0)
+      dump_cfg = 1;
+    else if (strcmp(argv[i], "--dump-symtab") == 0)
+      dump_symtab = 1;
+    else if (strcmp(argv[i], "--dump-symtab-stats") == 0)
+      dump_symtab_stats = 1;
+    else if (strcmp(argv[i], "--iaddl") == 0)
+      iaddl_enabled = 1;
+    else if (strcmp(argv[i], "--no-frame-pack") == 0)
+      frame_packing = 0;
+    else if (strcmp(argv[i], "--no-peephole") == 0)
+      peephole_enabled = 0;
+    else if (strcmp(argv[i], "--no-fuse-compares") == 0)
+      fusion_enabled = 0;
+    else if (strcmp(argv[i], "--stats") == 0)
+      collect_stats = 1;
+    else if (strcmp(argv[i], "--stats=json") == 0)
+      collect_stats = stats_json = 1;
+    else if ((argv[i][0] != '-' || strcmp(argv[i], "-") == 0) && name_count < 2)
+      names[name_count++] = argv[i];
+    else {
+      usage(argv[0]);
+      return 1;
+    }
+  }
+
+  if (pass_list ? parse_pass_list(&pipeline, pass_list) : set_opt_level(&pipeline, opt_level)) {
+    usage(argv[0]);
+    return 1;
+  }
+
+  if (name_count == 2) {
+    input_name = names[0];
+    file_name = names[1];
+  } else if (name_count == 1) {
+    file_name = names[0];
+  }
+
+  stats_begin_phase("parse");
+  if (input_name && strcmp(input_name, "-") != 0 && open_source(input_name) != 0) {
+    fprintf(stderr, "could not open %s\n", input_name);
+    return 1;
+  }
+
+  /* everything the compilation creates comes from here */
+  compile_arena = create_arena(ARENA_CHUNK_SIZE);
+  compile_strings = create_string_table(compile_arena);
 
   //yydebug = 1;
   noRoot = yyparse();
+  close_source();
+  stats_end_phase();
+  stats_count("ast_nodes", node_count);
+  stats_count("strings", compile_strings->count);
 
   if (parseError)
     fprintf(stderr, "WARNING: There were parse errors.\nParse tree may be ill-formed.\n");
 
   if (!noRoot && !parseError) {
   	//print_ast(root,0);
+    stats_begin_phase("post");
     post_process_ast(root);
   	
     /* create empty symboltable */
+    stats_begin_phase("symtab");
     symtab = create_symboltable();
     if (!symtab){
       fprintf(stderr, "couldn't create symboltable\n");
+      destroy_string_table(compile_strings);
+      destroy_arena(compile_arena);
       return 1;
     }
 
     /* fill symbol table up */
     traverse_ast_tree(root, symtab);
+    stats_end_phase();
+    if (collect_stats) {
+      long scopes, symbols, temps;
+      count_symtab(symtab, &scopes, &symbols, &temps);
+      stats_count("scopes", scopes);
+      stats_count("symbols", symbols);
+    }
 
     /* check types */
+    stats_begin_phase("types");
     set_type(root);
+    stats_end_phase();
     if (type_error_count != 0) {
       fprintf(stderr,"%d type errors found. Please fix before continuing.\n",type_error_count);
+      print_stats(stderr, stats_json);
+      destroy_string_table(compile_strings);
+      destroy_arena(compile_arena);
       return 1;
     }
 
-    printf("\n\n ----- PRETTY PRINTING AST TREE WITH TYPES -----\n");
-    print_ast(root,0);  
+    if (dump_ast) {
+      printf("\n\n ----- PRETTY PRINTING AST TREE WITH TYPES -----\n");
+      print_ast(root,0);
+    }
 
     /* Start to generate quads */
+    TRACE(VERBOSE_PHASES, "generating quads\n");
+    stats_begin_phase("codegen");
     quad_list = init_quad_list();
     CG(root);
+    stats_end_phase();
+    if (collect_stats) {
+      long scopes, symbols, temps;
+      count_symtab(symtab, &scopes, &symbols, &temps);
+      stats_count("quads", quad_list->count);
+      stats_count("temps", temps);
+      stats_count("strings", compile_strings->count);
+    }
 
-    /* create assembly */
-    char * file_name;
-    if (argc > 1 && argv[1] != NULL)
-      file_name = argv[1];
-    else
-      file_name = "myfile";
+    /* optimize quads */
+    TRACE(VERBOSE_PHASES, "optimizing %d quads\n", quad_list->count);
+    run_passes(&pipeline);
 
+    /* create assembly */
+    TRACE(VERBOSE_PHASES, "translating %d quads\n", quad_list->count);
+    stats_begin_phase("emit");
     create_ys(file_name);
+    stats_end_phase();
+    if (collect_stats) {
+      char ys_name[strlen(file_name) + 4];
+      sprintf(ys_name, "%s.ys", file_name);
+      stats_count("instructions", count_ys_instructions(ys_name));
+    }
+
+    if (dump_quads) {
+      printf("\n\n ----- PRINTING QUAD LIST -----\n");
+      print_quad_list();
+    }
 
-    printf("\n\n ----- PRINTING QUAD LIST -----\n");
-    print_quad_list();
+    if (dump_cfg) {
+      printf("\n\n ----- PRINTING CONTROL FLOW GRAPHS -----\n");
+      cfg_list * graphs = build_cfg_list();
+      print_cfg_list(stdout, graphs);
+      destroy_cfg_list(graphs);
+    }
+
+    if (dump_symtab) {
+      printf("\n\n ----- PRETTY PRINTING SYMBOLTABLE WITH TEMP VARIABLES -----\n");
+      print_symtab(symtab);
+    }
 
-    printf("\n\n ----- PRETTY PRINTING SYMBOLTABLE WITH TEMP VARIABLES -----\n");
-    print_symtab(symtab);
+    if (dump_symtab_stats) {
+      printf("\n\n ----- SYMBOL TABLE HASH STATISTICS -----\n");
+      print_symtab_stats(symtab);
+    }
 
     /* clean up */
     destroy_quad_list();
   }
 
+  print_stats(stderr, stats_json);
+
+  destroy_string_table(compile_strings);
+  compile_strings = NULL;
+  destroy_arena(compile_arena);
+  compile_arena = NULL;
+
   return 0;
 }
@@ -0,0 +1,91 @@
+/*
+ * FILE: y86sim_main.c
+ * DESCRIPTION: assembles and runs a .ys file, then reports instruction,
+ * memory and estimated cycle counts -- a local stand-in for yas + yis
+ *
+ * USAGE: ./y86sim [-q] [-l max_steps] [-i input_file] FILE.ys
+ *   -q  only the program's output, no report
+ *   -l  stop after max_steps instructions (default 10000000, 0 for no limit)
+ *   -i  read KHXR input from input_file instead of stdin
+ *
+ * The program's output goes to stdout, the report to stderr. Exits 0 if
+ * the program halted normally.
+ *
+ * Students: Yondon Fu and Matt McFarland - Delights (CS 57 - 16W)
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "src/y86_asm.h"
+#include "src/y86_sim.h"
+
+#define DEFAULT_MAX_STEPS 10000000
+
+static void usage(char * prog) {
+  fprintf(stderr, "usage: %s [-q] [-l max_steps] [-i input_file] FILE.ys\n", prog);
+}
+
+int main(int argc, char * argv[]) {
+  int quiet = 0;
+  long max_steps = DEFAULT_MAX_STEPS;
+  char * input_name = NULL;
+  char * ys_name = NULL;
+
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "-q") == 0) {
+      quiet = 1;
+    } else if (strcmp(argv[i], "-l") == 0 && i + 1 < argc) {
+      max_steps = atol(argv[++i]);
+    } else if (strcmp(argv[i], "-i") == 0 && i + 1 < argc) {
+      input_name = argv[++i];
+    } else if (argv[i][0] != '-' && !ys_name) {
+      ys_name = argv[i];
+    } else {
+      usage(argv[0]);
+      return 2;
+    }
+  }
+
+  if (!ys_name) {
+    usage(argv[0]);
+    return 2;
+  }
+
+  FILE * ys_fp = fopen(ys_name, "r");
+  if (!ys_fp) {
+    fprintf(stderr, "could not open %s\n", ys_name);
+    return 2;
+  }
+
+  y86_machine * m = new_y86_machine(Y86_MEM_SIZE);
+  int errors = assemble_ys(ys_fp, ys_name, m->mem, m->mem_size);
+  fclose(ys_fp);
+  if (errors) {
+    fprintf(stderr, "%d assembly errors in %s\n", errors, ys_name);
+    destroy_y86_machine(m);
+    return 2;
+  }
+
+  if (input_name) {
+    m->in = fopen(input_name, "r");
+    if (!m->in) {
+      fprintf(stderr, "could not open %s\n", input_name);
+      destroy_y86_machine(m);
+      return 2;
+    }
+  }
+
+  sim_status status = run_y86(m, max_steps);
+  fflush(m->out);
+
+  if (!quiet)
+    print_sim_stats(m, stderr);
+
+  if (input_name)
+    fclose(m->in);
+  destroy_y86_machine(m);
+
+  return (status == SIM_HLT) ? 0 : 1;
+}